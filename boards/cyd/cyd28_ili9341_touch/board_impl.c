@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "board_interface.h"
+#include "board_touch_ring.h"
 
 #include <stdio.h>
 #include <string.h>
@@ -12,6 +13,7 @@
 #include "esp_lcd_panel_io.h"
 #include "esp_lcd_panel_ops.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
@@ -42,8 +44,13 @@
 // XPT2046 control bytes: start=1, channel, 12-bit, differential, PD=00
 // PD=00 = power-down between conversions; re-enables PENIRQ after each read.
 // PD=11 (0xD3/0x93) would disable PENIRQ and our IRQ-based detection breaks.
-#define XPT_CMD_X  0xD0   // channel X+, diff, power-down/PENIRQ enabled
-#define XPT_CMD_Y  0x90   // channel Y+, diff, power-down/PENIRQ enabled
+// Inside a sampling burst PD=01 keeps the ADC biased between conversions;
+// the burst always ends with a PD=00 conversion.
+#define XPT_CMD_X      0xD0   // channel X+
+#define XPT_CMD_Y      0x90   // channel Y+
+#define XPT_CMD_Z1     0xB0   // pressure Z1
+#define XPT_CMD_Z2     0xC0   // pressure Z2
+#define XPT_PD_ADC_ON  0x01   // PD=01: ADC on, PENIRQ disabled
 
 // --- RGB LED: common anode, active LOW ---
 #define PIN_LED_R 17
@@ -52,9 +59,12 @@
 
 static esp_lcd_panel_handle_t s_panel = NULL;
 static spi_device_handle_t    s_touch_spi = NULL;
+static TaskHandle_t           s_touch_task = NULL;
+static esp_timer_handle_t     s_sample_timer = NULL;
 static uint16_t              *s_fb = NULL;
 static SemaphoreHandle_t      s_flush_sem = NULL;
 static const char             *TAG = "BOARD_CYD28";
+static board_touch_ring_t    s_touch_ring;
 
 // ---------------------------------------------------------------------------
 // Colour helpers
@@ -124,25 +134,81 @@ static void init_rgb_led(void)
 // XPT2046 touch
 // ---------------------------------------------------------------------------
 
-// Read one 12-bit ADC sample from the XPT2046 in a single 3-byte SPI frame.
-static uint16_t xpt2046_read_raw(uint8_t cmd)
+// Sampling burst: Z1, Z2, then XPT_SAMPLES interleaved X/Y conversions in
+// one polling transaction. In 16-clocks-per-conversion mode each command
+// byte is clocked out while the previous result is still shifting in, so
+// command i's 12-bit result lands in rx[2i+1] bits[6:0] : rx[2i+2] bits[7:3].
+//   tx: Z1 0 Z2 0 X 0 Y 0 ... X 0 Y 0 0
+#define XPT_SAMPLES      5      // X/Y pairs per burst, median-filtered
+#define XPT_BURST_CMDS   (2 + 2 * XPT_SAMPLES)
+#define XPT_BURST_BYTES  (2 * XPT_BURST_CMDS + 1)
+#define XPT_Z_THRESHOLD  400    // min pressure (z1 + 4095 - z2) for a touch
+#define XPT_MAX_SPREAD   60     // max spread of the middle samples, ADC counts
+
+typedef struct {
+    uint16_t x, y;              // median raw ADC readings
+    uint16_t z;                 // pressure, 0 = not touched
+} xpt_sample_t;
+
+static void xpt2046_read_burst(uint16_t out[XPT_BURST_CMDS])
 {
-    uint8_t tx[3] = {cmd, 0x00, 0x00};
-    uint8_t rx[3] = {0x00, 0x00, 0x00};
+    uint8_t tx[XPT_BURST_BYTES] = {0};
+    uint8_t rx[XPT_BURST_BYTES] = {0};
+    tx[0] = XPT_CMD_Z1 | XPT_PD_ADC_ON;
+    tx[2] = XPT_CMD_Z2 | XPT_PD_ADC_ON;
+    for (int i = 0; i < XPT_SAMPLES; i++) {
+        tx[4 + 4 * i] = XPT_CMD_X | XPT_PD_ADC_ON;
+        tx[6 + 4 * i] = XPT_CMD_Y | XPT_PD_ADC_ON;
+    }
+    tx[2 * (XPT_BURST_CMDS - 1)] = XPT_CMD_Y;  // last conversion re-arms PENIRQ
+
     spi_transaction_t t = {
-        .length = 24,       // bits
+        .length = 8 * XPT_BURST_BYTES,   // bits
         .tx_buffer = tx,
         .rx_buffer = rx,
     };
-    spi_device_transmit(s_touch_spi, &t);
-    // Result: 1 null bit after cmd byte, then 12 data bits.
-    // rx[1] bits[6:0] = D11:D5, rx[2] bits[7:3] = D4:D0.
-    return (((uint16_t)(rx[1] & 0x7F)) << 5) | (rx[2] >> 3);
+    spi_device_polling_transmit(s_touch_spi, &t);
+
+    for (int i = 0; i < XPT_BURST_CMDS; i++) {
+        out[i] = (((uint16_t)(rx[2 * i + 1] & 0x7F)) << 5) | (rx[2 * i + 2] >> 3);
+    }
+}
+
+// Sort v in place; return the median and the spread of the middle three.
+static uint16_t xpt_median(uint16_t v[XPT_SAMPLES], uint16_t *spread)
+{
+    for (int i = 1; i < XPT_SAMPLES; i++) {
+        uint16_t k = v[i];
+        int j = i - 1;
+        while (j >= 0 && v[j] > k) {
+            v[j + 1] = v[j];
+            j--;
+        }
+        v[j + 1] = k;
+    }
+    *spread = v[XPT_SAMPLES / 2 + 1] - v[XPT_SAMPLES / 2 - 1];
+    return v[XPT_SAMPLES / 2];
 }
 
-static bool xpt2046_is_touched(void)
+// Take one filtered sample. Always fills s->z; returns true only if the
+// pressure is above threshold and the X/Y samples agree (rejects readings
+// taken while a finger lands or lifts, and single-sample noise spikes).
+static bool xpt2046_sample(xpt_sample_t *s)
 {
-    return gpio_get_level(PIN_TOUCH_IRQ) == 0;
+    uint16_t r[XPT_BURST_CMDS];
+    uint16_t xs[XPT_SAMPLES], ys[XPT_SAMPLES];
+    uint16_t spread_x, spread_y;
+
+    xpt2046_read_burst(r);
+    s->z = r[0] + 4095 - r[1];
+    for (int i = 0; i < XPT_SAMPLES; i++) {
+        xs[i] = r[2 + 2 * i];
+        ys[i] = r[3 + 2 * i];
+    }
+    s->x = xpt_median(xs, &spread_x);
+    s->y = xpt_median(ys, &spread_y);
+    return s->z >= XPT_Z_THRESHOLD &&
+           spread_x <= XPT_MAX_SPREAD && spread_y <= XPT_MAX_SPREAD;
 }
 
 static void init_touch(void)
@@ -153,7 +219,7 @@ static void init_touch(void)
         .miso_io_num = PIN_TOUCH_MISO,
         .quadwp_io_num = -1,
         .quadhd_io_num = -1,
-        .max_transfer_sz = 6,
+        .max_transfer_sz = 32,   // one XPT_BURST_BYTES sampling burst
     };
     ESP_ERROR_CHECK(spi_bus_initialize(TOUCH_HOST, &bus, SPI_DMA_DISABLED));
 
@@ -171,13 +237,14 @@ static void init_touch(void)
         .mode = GPIO_MODE_INPUT,
         .pull_up_en = GPIO_PULLUP_DISABLE,
         .pull_down_en = GPIO_PULLDOWN_DISABLE,
-        .intr_type = GPIO_INTR_DISABLE,
+        .intr_type = GPIO_INTR_LOW_LEVEL,  // masked in the ISR until release
     };
     gpio_config(&irq_cfg);
 
     // Send one PD=00 conversion to re-enable PENIRQ in case a previous
     // session left the XPT2046 in PD=11 (PENIRQ disabled) state.
-    xpt2046_read_raw(XPT_CMD_X);
+    uint16_t discard[XPT_BURST_CMDS];
+    xpt2046_read_burst(discard);
 }
 
 // ---------------------------------------------------------------------------
@@ -198,6 +265,120 @@ static void touch_to_screen(uint16_t raw_x, uint16_t raw_y, int *sx, int *sy)
     if (*sy < 0) *sy = 0; else if (*sy >= LCD_V_RES) *sy = LCD_V_RES - 1;
 }
 
+// ---------------------------------------------------------------------------
+// Touch task — sleeps until PENIRQ goes low, then samples at TOUCH_SAMPLE_HZ
+// from an esp_timer until the pressure drops, and feeds the event ring
+// behind board_touch_read() / board_touch_get_events(). PENIRQ is masked
+// while the pen is down (it toggles during conversions) and only re-armed
+// once it reads high again: it is a level interrupt, and a light touch can
+// hold it low while the pressure stays under the threshold.
+// ---------------------------------------------------------------------------
+#define TOUCH_SAMPLE_HZ 200
+
+static void pen_isr(void *arg)
+{
+    gpio_intr_disable(PIN_TOUCH_IRQ);
+    BaseType_t woken = pdFALSE;
+    if (s_touch_task) {
+        vTaskNotifyGiveFromISR(s_touch_task, &woken);
+    }
+    portYIELD_FROM_ISR(woken);
+}
+
+static void sample_timer_cb(void *arg)
+{
+    xTaskNotifyGive(s_touch_task);
+}
+
+static void touch_task(void *arg)
+{
+    bool down = false;
+    bool polling = false;
+    bool logged = false;
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        xpt_sample_t s;
+        bool valid = xpt2046_sample(&s);
+        int64_t now = esp_timer_get_time();
+
+        if (s.z < XPT_Z_THRESHOLD) {
+            if (down) {
+                board_touch_ring_report(&s_touch_ring, NULL, 0, now);
+                down = false;
+                logged = false;
+            }
+            if (gpio_get_level(PIN_TOUCH_IRQ)) {
+                if (polling) {
+                    esp_timer_stop(s_sample_timer);
+                    polling = false;
+                }
+                gpio_intr_enable(PIN_TOUCH_IRQ);
+            } else if (!polling) {
+                // Still low: re-arming would fire at once, so keep polling
+                // until the finger is lifted.
+                esp_timer_start_periodic(s_sample_timer, 1000000 / TOUCH_SAMPLE_HZ);
+                polling = true;
+            }
+            continue;
+        }
+        if (!polling) {
+            esp_timer_start_periodic(s_sample_timer, 1000000 / TOUCH_SAMPLE_HZ);
+            polling = true;
+        }
+        down = true;
+        if (!valid) {
+            continue;   // outlier: keep the last reported position
+        }
+
+        int sx, sy;
+        touch_to_screen(s.x, s.y, &sx, &sy);
+        if (!logged) {
+            ESP_LOGI(TAG, "touch raw_x=%u raw_y=%u z=%u  screen x=%d y=%d",
+                     (unsigned)s.x, (unsigned)s.y, (unsigned)s.z, sx, sy);
+            logged = true;
+        }
+        board_touch_point_t pt = { .id = 0, .x = sx, .y = sy };
+        board_touch_ring_report(&s_touch_ring, &pt, 1, now);
+    }
+}
+
+static void start_touch_task(void)
+{
+    const esp_timer_create_args_t timer_args = {
+        .callback = sample_timer_cb,
+        .name = "xpt_sample",
+    };
+    ESP_ERROR_CHECK(esp_timer_create(&timer_args, &s_sample_timer));
+
+    if (xTaskCreate(touch_task, "TouchXPT", 3072, NULL, 5, &s_touch_task) != pdPASS) {
+        ESP_LOGW(TAG, "Failed to start touch task");
+        return;
+    }
+
+    esp_err_t err = gpio_install_isr_service(0);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+        ESP_LOGW(TAG, "GPIO ISR service: %s", esp_err_to_name(err));
+        return;
+    }
+    gpio_isr_handler_add(PIN_TOUCH_IRQ, pen_isr, NULL);
+}
+
+int board_touch_read(board_touch_point_t *points, int max_points)
+{
+    return board_touch_ring_snapshot(&s_touch_ring, points, max_points);
+}
+
+int board_touch_get_events(board_touch_event_t *events, int max_events)
+{
+    int n = board_touch_ring_pop(&s_touch_ring, events, max_events);
+    if (n > 0) {
+        board_latency_mark(BOARD_LATENCY_TOUCH, events[0].timestamp_us);
+        board_latency_mark(BOARD_LATENCY_DEQUEUE, esp_timer_get_time());
+    }
+    return n;
+}
+
 // ---------------------------------------------------------------------------
 // Minimal 5×7 bitmap font (column-major, bit 0 = top row).
 // ---------------------------------------------------------------------------
@@ -312,6 +493,7 @@ void board_init(void)
     assert(s_fb);
 
     init_touch();
+    start_touch_task();
 
     ESP_LOGI(TAG, "%s init done", BOARD_NAME);
 }
@@ -387,29 +569,25 @@ void board_lcd_sanity_test(void)
     draw_arrow_right(240, LCD_V_RES / 2, white); // right half
     board_lcd_flush();
 
-    bool was_touching = false;
-
     while (1) {
-        if (!s_touch_spi) { vTaskDelay(pdMS_TO_TICKS(50)); continue; }
-
-        if (xpt2046_is_touched()) {
-            uint32_t sum_x = 0, sum_y = 0;
-            for (int i = 0; i < 4; i++) {
-                sum_x += xpt2046_read_raw(XPT_CMD_X);
-                sum_y += xpt2046_read_raw(XPT_CMD_Y);
-            }
-            uint16_t raw_x = sum_x / 4;
-            uint16_t raw_y = sum_y / 4;
-
-            int sx, sy;
-            touch_to_screen(raw_x, raw_y, &sx, &sy);
+        board_touch_event_t ev[8];
+        int n = board_touch_get_events(ev, 8);
+        if (n == 0) {
+            vTaskDelay(pdMS_TO_TICKS(10));
+            continue;
+        }
 
-            ESP_LOGI(TAG, "touch raw_x=%u raw_y=%u  screen x=%d y=%d",
-                     raw_x, raw_y, sx, sy);
+        // Only the newest event matters for the display.
+        const board_touch_event_t *last = &ev[n - 1];
+        board_lcd_clear();
+        draw_arrow_up(80,  LCD_V_RES / 2, white);
+        draw_arrow_right(240, LCD_V_RES / 2, white);
 
-            board_lcd_clear();
-            draw_arrow_up(80,  LCD_V_RES / 2, white);
-            draw_arrow_right(240, LCD_V_RES / 2, white);
+        if (last->type == BOARD_TOUCH_RELEASE) {
+            ESP_LOGI(TAG, "touch released");
+        } else {
+            int sx = last->point.x;
+            int sy = last->point.y;
 
             // Crosshair at touch point
             for (int d = -6; d <= 6; d++) {
@@ -423,18 +601,8 @@ void board_lcd_sanity_test(void)
             char buf[24];
             snprintf(buf, sizeof(buf), "X:%d Y:%d", sx, sy);
             draw_string_scaled(8, LCD_V_RES - 29, buf, yellow, 3);
-
-            board_lcd_flush();
-            was_touching = true;
-        } else if (was_touching) {
-            ESP_LOGI(TAG, "touch released");
-            board_lcd_clear();
-            draw_arrow_up(80,  LCD_V_RES / 2, white);
-            draw_arrow_right(240, LCD_V_RES / 2, white);
-            board_lcd_flush();
-            was_touching = false;
         }
-
+        board_lcd_flush();
     }
 }
 
@@ -448,8 +616,10 @@ int board_lcd_height(void) { return LCD_V_RES; }
 void board_lcd_flush(void)
 {
     if (!s_panel || !s_fb) return;
+    board_latency_mark(BOARD_LATENCY_RENDER, esp_timer_get_time());
     esp_lcd_panel_draw_bitmap(s_panel, 0, 0, LCD_H_RES, LCD_V_RES, s_fb);
     xSemaphoreTake(s_flush_sem, portMAX_DELAY);
+    board_latency_mark(BOARD_LATENCY_FLUSH_DONE, esp_timer_get_time());
 }
 
 void board_lcd_fill(uint16_t color)
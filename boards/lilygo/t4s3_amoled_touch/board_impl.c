@@ -12,6 +12,7 @@
 #include "driver/gpio.h"
 #include "product_pins.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include <stdlib.h>
 #include <string.h>
 #include "esp_heap_caps.h"
@@ -144,7 +145,9 @@ void board_lcd_flush(void)
     if (!s_fb) return;
     const int w = amoled_height();
     const int h = amoled_width();
-    display_push_colors(0, 0, w, h, s_fb);
+    board_latency_mark(BOARD_LATENCY_RENDER, esp_timer_get_time());
+    display_push_colors(0, 0, w, h, s_fb);     // polling, done on return
+    board_latency_mark(BOARD_LATENCY_FLUSH_DONE, esp_timer_get_time());
 }
 
 void board_lcd_clear(void)
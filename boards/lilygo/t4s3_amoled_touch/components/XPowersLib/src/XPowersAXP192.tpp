@@ -111,6 +111,63 @@ typedef struct {
     uint8_t mode;
 } xpowers_axp192_gpio_t;
 
+/**
+ * @brief Register fields behind the thin get<F>()/set<F>() wrappers in
+ * XPowersAXP192, see XPowersField.hpp. LDOio's on/off is a GPIO0 mode
+ * selector rather than a bit and keeps its hand-written code.
+ */
+namespace XPowersAXP192Field {
+
+using DC1Voltage   = XPowersField<XPOWERS_AXP192_DC1_VLOTAGE, 0, 7, XPOWERS_AXP192_DC1_VOL_STEPS,
+                                  XPOWERS_AXP192_DC1_VOL_MIN, XPOWERS_AXP192_DC1_VOL_MAX>;
+// DC2 has six bits, so it tops out at 2275 mV rather than DC2_VOL_MAX.
+using DC2Voltage   = XPowersField<XPOWERS_AXP192_DC2OUT_VOL, 0, 6, XPOWERS_AXP192_DC2_VOL_STEPS,
+                                  XPOWERS_AXP192_DC2_VOL_MIN, XPOWERS_AXP192_DC2_VOL_MIN + 63 * XPOWERS_AXP192_DC2_VOL_STEPS>;
+// DC3 owns REG 0x27 (bit 7 is reserved), so setting it needs no read.
+using DC3Voltage   = XPowersField<XPOWERS_AXP192_DC3OUT_VOL, 0, 7, XPOWERS_AXP192_DC3_VOL_STEPS,
+                                  XPOWERS_AXP192_DC3_VOL_MIN, XPOWERS_AXP192_DC3_VOL_MAX, 0x00>;
+using LDO2Voltage  = XPowersField<XPOWERS_AXP192_LDO23OUT_VOL, XPOWERS_AXP192_LDO2_VOL_BIT_MASK, 4, XPOWERS_AXP192_LDO2_VOL_STEPS,
+                                  XPOWERS_AXP192_LDO2_VOL_MIN, XPOWERS_AXP192_LDO2_VOL_MAX>;
+using LDO3Voltage  = XPowersField<XPOWERS_AXP192_LDO23OUT_VOL, 0, 4, XPOWERS_AXP192_LDO3_VOL_STEPS,
+                                  XPOWERS_AXP192_LDO3_VOL_MIN, XPOWERS_AXP192_LDO3_VOL_MAX>;
+using LDOioVoltage = XPowersField<XPOWERS_AXP192_GPIO0_VOL, 4, 4, XPOWERS_AXP192_LDOIO_VOL_STEPS,
+                                  XPOWERS_AXP192_LDOIO_VOL_MIN, XPOWERS_AXP192_LDOIO_VOL_MAX>;
+using SysPowerDownVoltage = XPowersField<XPOWERS_AXP192_VOFF_SET, 0, 3, XPOWERS_AXP192_SYS_VOL_STEPS,
+                                         XPOWERS_AXP192_VOFF_VOL_MIN, XPOWERS_AXP192_VOFF_VOL_MAX>;
+
+using DC1Enable    = XPowersBit<XPOWERS_AXP192_LDO23_DC123_EXT_CTL, 0>;
+using DC3Enable    = XPowersBit<XPOWERS_AXP192_LDO23_DC123_EXT_CTL, 1>;
+using LDO2Enable   = XPowersBit<XPOWERS_AXP192_LDO23_DC123_EXT_CTL, 2>;
+using LDO3Enable   = XPowersBit<XPOWERS_AXP192_LDO23_DC123_EXT_CTL, 3>;
+using DC2Enable    = XPowersBit<XPOWERS_AXP192_LDO23_DC123_EXT_CTL, 4>;
+using ExternalPin  = XPowersBit<XPOWERS_AXP192_LDO23_DC123_EXT_CTL, 6>;
+
+} // namespace XPowersAXP192Field
+
+/**
+ * @brief Status, ADC and IRQ state decoded from one burst read of
+ *        0x00 .. 0x7F, see XPowersAXP192::readSnapshot().
+ *        Fields follow the matching single-value getters.
+ */
+typedef struct {
+    uint8_t  status;                    // raw STATUS
+    uint8_t  mode_chgstatus;            // raw MODE_CHGSTATUS
+    bool     acin_in;                   // isAcinIn()
+    bool     vbus_in;                   // isVbusIn()
+    bool     battery_connected;         // isBatteryConnect()
+    bool     charging;                  // isCharging()
+    uint16_t acin_mv;                   // getAcinVoltage(), 0 without ACIN
+    float    acin_ma;                   // getAcinCurrent()
+    uint16_t vbus_mv;                   // getVbusVoltage(), 0 without VBUS
+    float    vbus_ma;                   // getVbusCurrent()
+    uint16_t batt_mv;                   // getBattVoltage(), 0 without battery
+    float    batt_charge_ma;            // getBatteryChargeCurrent()
+    float    batt_discharge_ma;         // getBattDischargeCurrent()
+    uint16_t sys_mv;                    // getSystemVoltage()
+    float    temperature;               // getTemperature(), degC
+    uint64_t irq_status;                // getIrqStatus()
+} xpowers_axp192_snapshot_t;
+
 
 class XPowersAXP192 :
     public XPowersCommon<XPowersAXP192>, public XPowersLibInterface
@@ -324,31 +381,12 @@ public:
     // below this value will shut down the PMU,Adjustment range 2600mV ~ 3300mV
     bool setSysPowerDownVoltage(uint16_t millivolt)
     {
-        if (millivolt % XPOWERS_AXP192_SYS_VOL_STEPS) {
-            log_e("Mistake ! The steps is must %u mV", XPOWERS_AXP192_SYS_VOL_STEPS);
-            return false;
-        }
-        if (millivolt < XPOWERS_AXP192_VOFF_VOL_MIN) {
-            log_e("Mistake ! SYS minimum output voltage is  %umV", XPOWERS_AXP192_VOFF_VOL_MIN);
-            return false;
-        } else if (millivolt > XPOWERS_AXP192_VOFF_VOL_MAX) {
-            log_e("Mistake ! SYS maximum output voltage is  %umV", XPOWERS_AXP192_VOFF_VOL_MAX);
-            return false;
-        }
-
-        int val = readRegister(XPOWERS_AXP192_VOFF_SET);
-        if (val == -1)return false;
-        val &= 0xF8;
-        val |= (millivolt - XPOWERS_AXP192_VOFF_VOL_MIN) / XPOWERS_AXP192_SYS_VOL_STEPS;
-        return 0 ==  writeRegister(XPOWERS_AXP192_VOFF_SET, val);
+        return set<XPowersAXP192Field::SysPowerDownVoltage>(millivolt);
     }
 
     uint16_t getSysPowerDownVoltage()
     {
-        int val = readRegister(XPOWERS_AXP192_VOFF_SET);
-        if (val == -1)return 0;
-        val &= 0x07;
-        return (val * XPOWERS_AXP192_SYS_VOL_STEPS) + XPOWERS_AXP192_VOFF_VOL_MIN;
+        return get<XPowersAXP192Field::SysPowerDownVoltage>();
     }
 
 
@@ -572,31 +610,12 @@ public:
 
     bool setLDOioVoltage(uint16_t millivolt)
     {
-        if (millivolt % XPOWERS_AXP192_LDOIO_VOL_STEPS) {
-            log_e("Mistake ! The steps is must %u mV", XPOWERS_AXP192_LDOIO_VOL_STEPS);
-            return false;
-        }
-        if (millivolt < XPOWERS_AXP192_LDOIO_VOL_MIN) {
-            log_e("Mistake ! LDOIO minimum output voltage is  %umV", XPOWERS_AXP192_LDOIO_VOL_MIN);
-            return false;
-        } else if (millivolt > XPOWERS_AXP192_LDOIO_VOL_MAX) {
-            log_e("Mistake ! LDOIO maximum output voltage is  %umV", XPOWERS_AXP192_LDOIO_VOL_MAX);
-            return false;
-        }
-        int val = readRegister(XPOWERS_AXP192_GPIO0_VOL);
-        if (val == -1)return false;
-        val |=  (((millivolt - XPOWERS_AXP192_LDOIO_VOL_MIN) / XPOWERS_AXP192_LDOIO_VOL_STEPS) << 4);
-        return 0 == writeRegister(XPOWERS_AXP192_GPIO0_VOL, val);
+        return set<XPowersAXP192Field::LDOioVoltage>(millivolt);
     }
 
     uint16_t getLDOioVoltage(void)
     {
-        int val = readRegister(XPOWERS_AXP192_GPIO0_VOL);
-        if (val == -1)return 0;
-        val >>= 4;
-        val *= XPOWERS_AXP192_LDOIO_VOL_STEPS;
-        val += XPOWERS_AXP192_LDOIO_VOL_MIN;
-        return val;
+        return get<XPowersAXP192Field::LDOioVoltage>();
     }
 
     /*
@@ -604,43 +623,27 @@ public:
     */
     bool isEnableLDO2(void)
     {
-        return getRegisterBit(XPOWERS_AXP192_LDO23_DC123_EXT_CTL, 2);
+        return get<XPowersAXP192Field::LDO2Enable>();
     }
 
     bool enableLDO2(void)
     {
-        return setRegisterBit(XPOWERS_AXP192_LDO23_DC123_EXT_CTL, 2);
+        return set<XPowersAXP192Field::LDO2Enable>(1);
     }
 
     bool disableLDO2(void)
     {
-        return clrRegisterBit(XPOWERS_AXP192_LDO23_DC123_EXT_CTL, 2);
+        return set<XPowersAXP192Field::LDO2Enable>(0);
     }
 
     bool setLDO2Voltage(uint16_t millivolt)
     {
-        if (millivolt % XPOWERS_AXP192_LDO2_VOL_STEPS) {
-            log_e("Mistake ! The steps is must %u mV", XPOWERS_AXP192_LDO2_VOL_STEPS);
-            return false;
-        }
-        if (millivolt < XPOWERS_AXP192_LDO2_VOL_MIN) {
-            log_e("Mistake ! LDO2 minimum output voltage is  %umV", XPOWERS_AXP192_LDO2_VOL_MIN);
-            return false;
-        } else if (millivolt > XPOWERS_AXP192_LDO2_VOL_MAX) {
-            log_e("Mistake ! LDO2 maximum output voltage is  %umV", XPOWERS_AXP192_LDO2_VOL_MAX);
-            return false;
-        }
-
-        int val = readRegister(XPOWERS_AXP192_LDO23OUT_VOL);
-        if (val == -1) return false;
-        val  &= 0x0F;
-        return 0 == writeRegister(XPOWERS_AXP192_LDO23OUT_VOL, val | (((millivolt - XPOWERS_AXP192_LDO2_VOL_MIN) / XPOWERS_AXP192_LDO2_VOL_STEPS) << XPOWERS_AXP192_LDO2_VOL_BIT_MASK));
+        return set<XPowersAXP192Field::LDO2Voltage>(millivolt);
     }
 
     uint16_t getLDO2Voltage(void)
     {
-        int val = readRegister(XPOWERS_AXP192_LDO23OUT_VOL) & 0xF0;
-        return (val >> XPOWERS_AXP192_LDO2_VOL_BIT_MASK) * XPOWERS_AXP192_LDO2_VOL_STEPS + XPOWERS_AXP192_LDO2_VOL_MIN;
+        return get<XPowersAXP192Field::LDO2Voltage>();
     }
 
     /*
@@ -648,44 +651,28 @@ public:
      */
     bool isEnableLDO3(void)
     {
-        return getRegisterBit(XPOWERS_AXP192_LDO23_DC123_EXT_CTL, 3);
+        return get<XPowersAXP192Field::LDO3Enable>();
     }
 
     bool enableLDO3(void)
     {
-        return setRegisterBit(XPOWERS_AXP192_LDO23_DC123_EXT_CTL, 3);
+        return set<XPowersAXP192Field::LDO3Enable>(1);
     }
 
     bool disableLDO3(void)
     {
-        return clrRegisterBit(XPOWERS_AXP192_LDO23_DC123_EXT_CTL, 3);
+        return set<XPowersAXP192Field::LDO3Enable>(0);
     }
 
 
     bool setLDO3Voltage(uint16_t millivolt)
     {
-        if (millivolt % XPOWERS_AXP192_LDO3_VOL_STEPS) {
-            log_e("Mistake ! The steps is must %u mV", XPOWERS_AXP192_LDO3_VOL_STEPS);
-            return false;
-        }
-        if (millivolt < XPOWERS_AXP192_LDO3_VOL_MIN) {
-            log_e("Mistake ! LDO3 minimum output voltage is  %umV", XPOWERS_AXP192_LDO3_VOL_MIN);
-            return false;
-        } else if (millivolt > XPOWERS_AXP192_LDO3_VOL_MAX) {
-            log_e("Mistake ! LDO3 maximum output voltage is  %umV", XPOWERS_AXP192_LDO3_VOL_MAX);
-            return false;
-        }
-
-        int val = readRegister(XPOWERS_AXP192_LDO23OUT_VOL) & 0xF0;
-        return 0 == writeRegister(XPOWERS_AXP192_LDO23OUT_VOL, val | ((millivolt - XPOWERS_AXP192_LDO3_VOL_MIN) / XPOWERS_AXP192_LDO3_VOL_STEPS));
+        return set<XPowersAXP192Field::LDO3Voltage>(millivolt);
     }
 
     uint16_t getLDO3Voltage(void)
     {
-        int val = readRegister(XPOWERS_AXP192_LDO23OUT_VOL);
-        if (val == -1)return 0;
-        val &= 0x0F;
-        return (val * XPOWERS_AXP192_LDO3_VOL_STEPS) + XPOWERS_AXP192_LDO3_VOL_MIN;
+        return get<XPowersAXP192Field::LDO3Voltage>();
     }
 
     /*
@@ -705,44 +692,27 @@ public:
 
     bool isEnableDC1(void)
     {
-        return getRegisterBit(XPOWERS_AXP192_LDO23_DC123_EXT_CTL, 0);
+        return get<XPowersAXP192Field::DC1Enable>();
     }
 
     bool enableDC1(void)
     {
-        return setRegisterBit(XPOWERS_AXP192_LDO23_DC123_EXT_CTL, 0);
+        return set<XPowersAXP192Field::DC1Enable>(1);
     }
 
     bool disableDC1(void)
     {
-        return clrRegisterBit(XPOWERS_AXP192_LDO23_DC123_EXT_CTL, 0);
+        return set<XPowersAXP192Field::DC1Enable>(0);
     }
 
     bool setDC1Voltage(uint16_t millivolt)
     {
-        if (millivolt % XPOWERS_AXP192_DC1_VOL_STEPS) {
-            log_e("Mistake ! The steps is must %u mV", XPOWERS_AXP192_DC1_VOL_STEPS);
-            return false;
-        }
-        if (millivolt < XPOWERS_AXP192_DC1_VOL_STEPS) {
-            log_e("Mistake ! DCDC1 minimum output voltage is  %umV", XPOWERS_AXP192_DC1_VOL_STEPS);
-            return false;
-        } else if (millivolt > XPOWERS_AXP192_DC1_VOL_MAX) {
-            log_e("Mistake ! DCDC1 maximum output voltage is  %umV", XPOWERS_AXP192_DC1_VOL_MAX);
-            return false;
-        }
-
-        int val = readRegister(XPOWERS_AXP192_DC1_VLOTAGE);
-        if (val == -1)return false;
-        val &= 0x80;
-        val |= (millivolt - XPOWERS_AXP192_DC1_VOL_MIN) / XPOWERS_AXP192_DC1_VOL_STEPS;
-        return 0 == writeRegister(XPOWERS_AXP192_DC1_VLOTAGE, val);
+        return set<XPowersAXP192Field::DC1Voltage>(millivolt);
     }
 
     uint16_t getDC1Voltage(void)
     {
-        int val = readRegister(XPOWERS_AXP192_DC1_VLOTAGE) & 0x7F;
-        return val * XPOWERS_AXP192_DC1_VOL_STEPS + XPOWERS_AXP192_DC1_VOL_MIN;
+        return get<XPowersAXP192Field::DC1Voltage>();
     }
 
     /*
@@ -788,44 +758,27 @@ public:
 
     bool isEnableDC2(void)
     {
-        return getRegisterBit(XPOWERS_AXP192_LDO23_DC123_EXT_CTL, 4);
+        return get<XPowersAXP192Field::DC2Enable>();
     }
 
     bool enableDC2(void)
     {
-        return setRegisterBit(XPOWERS_AXP192_LDO23_DC123_EXT_CTL, 4);
+        return set<XPowersAXP192Field::DC2Enable>(1);
     }
 
     bool disableDC2(void)
     {
-        return clrRegisterBit(XPOWERS_AXP192_LDO23_DC123_EXT_CTL, 4);
+        return set<XPowersAXP192Field::DC2Enable>(0);
     }
 
     bool setDC2Voltage(uint16_t millivolt)
     {
-        if (millivolt % XPOWERS_AXP192_DC2_VOL_STEPS) {
-            log_e("Mistake ! The steps is must %u mV", XPOWERS_AXP192_DC2_VOL_STEPS);
-            return false;
-        }
-        if (millivolt < XPOWERS_AXP192_DC2_VOL_MIN) {
-            log_e("Mistake ! DCDC2 minimum output voltage is  %umV", XPOWERS_AXP192_DC2_VOL_MIN);
-            return false;
-        } else if (millivolt > XPOWERS_AXP192_DC2_VOL_MAX) {
-            log_e("Mistake ! DCDC2 maximum output voltage is  %umV", XPOWERS_AXP192_DC2_VOL_MAX);
-            return false;
-        }
-        int val = readRegister(XPOWERS_AXP192_DC2OUT_VOL);
-        if (val == -1)return false;
-        val  &= 0x80;
-        val |= (millivolt - XPOWERS_AXP192_DC2_VOL_MIN) / XPOWERS_AXP192_DC2_VOL_STEPS;
-        return 0 == writeRegister(XPOWERS_AXP192_DC2OUT_VOL, val);
+        return set<XPowersAXP192Field::DC2Voltage>(millivolt);
     }
 
     uint16_t getDC2Voltage(void)
     {
-        int val = readRegister(XPOWERS_AXP192_DC2OUT_VOL);
-        if (val == -1)return 0;
-        return (val * XPOWERS_AXP192_DC2_VOL_STEPS) + XPOWERS_AXP192_DC2_VOL_MIN;
+        return get<XPowersAXP192Field::DC2Voltage>();
     }
 
     /*
@@ -845,40 +798,27 @@ public:
 
     bool isEnableDC3(void)
     {
-        return getRegisterBit(XPOWERS_AXP192_LDO23_DC123_EXT_CTL, 1);
+        return get<XPowersAXP192Field::DC3Enable>();
     }
 
     bool enableDC3(void)
     {
-        return setRegisterBit(XPOWERS_AXP192_LDO23_DC123_EXT_CTL, 1);
+        return set<XPowersAXP192Field::DC3Enable>(1);
     }
 
     bool disableDC3(void)
     {
-        return clrRegisterBit(XPOWERS_AXP192_LDO23_DC123_EXT_CTL, 1);
+        return set<XPowersAXP192Field::DC3Enable>(0);
     }
 
     bool setDC3Voltage(uint16_t millivolt)
     {
-        if (millivolt % XPOWERS_AXP192_DC3_VOL_STEPS) {
-            log_e("Mistake ! The steps is must %u mV", XPOWERS_AXP192_DC3_VOL_STEPS);
-            return false;
-        }
-        if (millivolt < XPOWERS_AXP192_DC3_VOL_MIN) {
-            log_e("Mistake ! DCDC3 minimum output voltage is  %umV", XPOWERS_AXP192_DC3_VOL_MIN);
-            return false;
-        } else if (millivolt > XPOWERS_AXP192_DC3_VOL_MAX) {
-            log_e("Mistake ! DCDC3 maximum output voltage is  %umV", XPOWERS_AXP192_DC3_VOL_MAX);
-            return false;
-        }
-        return 0 == writeRegister(XPOWERS_AXP192_DC3OUT_VOL, (millivolt - XPOWERS_AXP192_DC3_VOL_MIN) / XPOWERS_AXP192_DC3_VOL_STEPS);
+        return set<XPowersAXP192Field::DC3Voltage>(millivolt);
     }
 
     uint16_t getDC3Voltage(void)
     {
-        int val = readRegister(XPOWERS_AXP192_DC3OUT_VOL);
-        if (val == -1)return 0;
-        return (val * XPOWERS_AXP192_DC3_VOL_STEPS) + XPOWERS_AXP192_DC3_VOL_MIN;
+        return get<XPowersAXP192Field::DC3Voltage>();
     }
 
     /*
@@ -886,17 +826,17 @@ public:
      */
     bool enableExternalPin(void)
     {
-        return setRegisterBit(XPOWERS_AXP192_LDO23_DC123_EXT_CTL, 6);
+        return set<XPowersAXP192Field::ExternalPin>(1);
     }
 
     bool disableExternalPin(void)
     {
-        return clrRegisterBit(XPOWERS_AXP192_LDO23_DC123_EXT_CTL, 6);
+        return set<XPowersAXP192Field::ExternalPin>(0);
     }
 
     bool isEnableExternalPin(void)
     {
-        return getRegisterBit(XPOWERS_AXP192_LDO23_DC123_EXT_CTL, 6);
+        return get<XPowersAXP192Field::ExternalPin>();
     }
 
     /*
@@ -1244,6 +1184,60 @@ public:
         return readRegisterH8L4(XPOWERS_AXP192_APS_AVERVOL_H8, XPOWERS_AXP192_APS_AVERVOL_L4) * XPOWERS_AXP192_APS_VOLTAGE_STEP;
     }
 
+    /**
+     * @brief  Read status, all ADC results and IRQ status in one transfer.
+     *         The 128-byte block 0x00 .. 0x7F replaces the ~15 separate
+     *         reads the individual getters would make. The IRQ status is
+     *         latched for the is...Irq() helpers as getIrqStatus() does.
+     * @retval false if the bus read failed (snap is left untouched).
+     */
+    bool readSnapshot(xpowers_axp192_snapshot_t &snap)
+    {
+        uint8_t buf[XPOWERS_AXP192_APS_AVERVOL_L4 + 1];
+        if (readRegister(XPOWERS_AXP192_STATUS, buf, sizeof(buf)) != 0) {
+            return false;
+        }
+#define SNAP_H8L4(h, l) ((uint16_t)((buf[h] << 4) | (buf[l] & 0x0F)))
+#define SNAP_H8L5(h, l) ((uint16_t)((buf[h] << 5) | (buf[l] & 0x1F)))
+        snap.status = buf[XPOWERS_AXP192_STATUS];
+        snap.mode_chgstatus = buf[XPOWERS_AXP192_MODE_CHGSTATUS];
+        snap.acin_in = snap.status & _BV(7);
+        snap.vbus_in = snap.status & _BV(5);
+        snap.battery_connected = snap.mode_chgstatus & _BV(5);
+        snap.charging = snap.mode_chgstatus & _BV(6);
+        snap.acin_mv = snap.acin_in ?
+                       SNAP_H8L4(XPOWERS_AXP192_ACIN_VOL_H8, XPOWERS_AXP192_ACIN_VOL_L4) * XPOWERS_AXP192_ACIN_VOLTAGE_STEP : 0;
+        snap.acin_ma = snap.acin_in ?
+                       SNAP_H8L4(XPOWERS_AXP192_ACIN_CUR_H8, XPOWERS_AXP192_ACIN_CUR_L4) * XPOWERS_AXP192_ACIN_CUR_STEP : 0;
+        snap.vbus_mv = snap.vbus_in ?
+                       SNAP_H8L4(XPOWERS_AXP192_VBUS_VOL_H8, XPOWERS_AXP192_VBUS_VOL_L4) * XPOWERS_AXP192_VBUS_VOLTAGE_STEP : 0;
+        snap.vbus_ma = snap.vbus_in ?
+                       SNAP_H8L4(XPOWERS_AXP192_VBUS_CUR_H8, XPOWERS_AXP192_VBUS_CUR_L4) * XPOWERS_AXP192_VBUS_CUR_STEP : 0;
+        snap.batt_mv = snap.battery_connected ?
+                       SNAP_H8L4(XPOWERS_AXP192_BAT_AVERVOL_H8, XPOWERS_AXP192_BAT_AVERVOL_L4) * XPOWERS_AXP192_BATT_VOLTAGE_STEP : 0;
+        snap.batt_charge_ma = SNAP_H8L5(XPOWERS_AXP192_BAT_AVERCHGCUR_H8, XPOWERS_AXP192_BAT_AVERCHGCUR_L5)
+                              * XPOWERS_AXP192_BATT_CHARGE_CUR_STEP;
+        snap.batt_discharge_ma = snap.battery_connected ?
+                                 SNAP_H8L5(XPOWERS_AXP192_BAT_AVERDISCHGCUR_H8, XPOWERS_AXP192_BAT_AVERDISCHGCUR_L5)
+                                 * XPOWERS_AXP192_BATT_DISCHARGE_CUR_STEP : 0;
+        snap.sys_mv = SNAP_H8L4(XPOWERS_AXP192_APS_AVERVOL_H8, XPOWERS_AXP192_APS_AVERVOL_L4) * XPOWERS_AXP192_APS_VOLTAGE_STEP;
+        snap.temperature = SNAP_H8L4(XPOWERS_AXP192_INTERNAL_TEMP_H8, XPOWERS_AXP192_INTERNAL_TEMP_L4)
+                           * XPOWERS_AXP192_INTERNAL_TEMP_STEP - XPOWERS_AXP192_INERNAL_TEMP_OFFSET;
+#undef SNAP_H8L4
+#undef SNAP_H8L5
+        statusRegister[0] = buf[XPOWERS_AXP192_INTSTS1];
+        statusRegister[1] = buf[XPOWERS_AXP192_INTSTS2];
+        statusRegister[2] = buf[XPOWERS_AXP192_INTSTS3];
+        statusRegister[3] = buf[XPOWERS_AXP192_INTSTS4];
+        statusRegister[4] = buf[XPOWERS_AXP192_INTSTS5];
+        snap.irq_status = ((uint64_t)statusRegister[4]) << 32 |
+                          ((uint64_t)statusRegister[3]) << 24 |
+                          ((uint64_t)statusRegister[2]) << 16 |
+                          ((uint64_t)statusRegister[1]) << 8  |
+                          ((uint64_t)statusRegister[0]);
+        return true;
+    }
+
     /*
     * Timer Control
     */
@@ -110,6 +110,37 @@ typedef enum {
     XPOWERS_AXP202_BACKUP_BAT_CUR_400UA,
 } xpowers_axp202_backup_batt_curr_t;
 
+/**
+ * @brief Register fields behind the thin get<F>()/set<F>() wrappers in
+ * XPowersAXP202, see XPowersField.hpp. LDO4 (a voltage table) and LDOio's
+ * on/off (a GPIO0 mode selector) keep their hand-written code.
+ */
+namespace XPowersAXP202Field {
+
+// DC2 has six bits, so it tops out at 2275 mV rather than DC2_VOL_MAX.
+using DC2Voltage   = XPowersField<XPOWERS_AXP202_DC2OUT_VOL, 0, 6, XPOWERS_AXP202_DC2_VOL_STEPS,
+                                  XPOWERS_AXP202_DC2_VOL_MIN, XPOWERS_AXP202_DC2_VOL_MIN + 63 * XPOWERS_AXP202_DC2_VOL_STEPS>;
+// DC3 owns REG 0x27 (bit 7 is reserved), so setting it needs no read.
+using DC3Voltage   = XPowersField<XPOWERS_AXP202_DC3OUT_VOL, 0, 7, XPOWERS_AXP202_DC3_VOL_STEPS,
+                                  XPOWERS_AXP202_DC3_VOL_MIN, XPOWERS_AXP202_DC3_VOL_MAX, 0x00>;
+using LDO2Voltage  = XPowersField<XPOWERS_AXP202_LDO24OUT_VOL, XPOWERS_AXP202_LDO2_VOL_BIT_MASK, 4, XPOWERS_AXP202_LDO2_VOL_STEPS,
+                                  XPOWERS_AXP202_LDO2_VOL_MIN, XPOWERS_AXP202_LDO2_VOL_MAX>;
+// Bit 7 selects VBUS pass-through, see getLDO3Voltage().
+using LDO3Voltage  = XPowersField<XPOWERS_AXP202_LDO3OUT_VOL, 0, 7, XPOWERS_AXP202_LDO3_VOL_STEPS,
+                                  XPOWERS_AXP202_LDO3_VOL_MIN, XPOWERS_AXP202_LDO3_VOL_MAX>;
+using LDOioVoltage = XPowersField<XPOWERS_AXP202_GPIO0_VOL, 4, 4, XPOWERS_AXP202_LDOIO_VOL_STEPS,
+                                  XPOWERS_AXP202_LDOIO_VOL_MIN, XPOWERS_AXP202_LDOIO_VOL_MAX>;
+using SysPowerDownVoltage = XPowersField<XPOWERS_AXP202_VOFF_SET, 0, 3, XPOWERS_AXP202_SYS_VOL_STEPS,
+                                         XPOWERS_AXP202_VOFF_VOL_MIN, XPOWERS_AXP202_VOFF_VOL_MAX>;
+
+using DC3Enable    = XPowersBit<XPOWERS_AXP202_LDO234_DC23_CTL, 1>;
+using LDO2Enable   = XPowersBit<XPOWERS_AXP202_LDO234_DC23_CTL, 2>;
+using LDO4Enable   = XPowersBit<XPOWERS_AXP202_LDO234_DC23_CTL, 3>;
+using DC2Enable    = XPowersBit<XPOWERS_AXP202_LDO234_DC23_CTL, 4>;
+using LDO3Enable   = XPowersBit<XPOWERS_AXP202_LDO234_DC23_CTL, 6>;
+
+} // namespace XPowersAXP202Field
+
 
 class XPowersAXP202 :
     public XPowersCommon<XPowersAXP202>, public XPowersLibInterface
@@ -306,31 +337,12 @@ public:
     // below this value will shut down the PMU,Adjustment range 2600mV ~ 3300mV
     bool setSysPowerDownVoltage(uint16_t millivolt)
     {
-        if (millivolt % XPOWERS_AXP202_SYS_VOL_STEPS) {
-            log_e("Mistake ! The steps is must %u mV", XPOWERS_AXP202_SYS_VOL_STEPS);
-            return false;
-        }
-        if (millivolt < XPOWERS_AXP202_VOFF_VOL_MIN) {
-            log_e("Mistake ! SYS minimum output voltage is  %umV", XPOWERS_AXP202_VOFF_VOL_MIN);
-            return false;
-        } else if (millivolt > XPOWERS_AXP202_VOFF_VOL_MAX) {
-            log_e("Mistake ! SYS maximum output voltage is  %umV", XPOWERS_AXP202_VOFF_VOL_MAX);
-            return false;
-        }
-
-        int val = readRegister(XPOWERS_AXP202_VOFF_SET);
-        if (val == -1)return false;
-        val &= 0xF8;
-        val |= (millivolt - XPOWERS_AXP202_VOFF_VOL_MIN) / XPOWERS_AXP202_SYS_VOL_STEPS;
-        return 0 ==  writeRegister(XPOWERS_AXP202_VOFF_SET, val);
+        return set<XPowersAXP202Field::SysPowerDownVoltage>(millivolt);
     }
 
     uint16_t getSysPowerDownVoltage()
     {
-        int val = readRegister(XPOWERS_AXP202_VOFF_SET);
-        if (val == -1)return 0;
-        val &= 0x07;
-        return (val * XPOWERS_AXP202_SYS_VOL_STEPS) + XPOWERS_AXP202_VOFF_VOL_MIN;
+        return get<XPowersAXP202Field::SysPowerDownVoltage>();
     }
 
     /**
@@ -549,31 +561,12 @@ public:
 
     bool setLDOioVoltage(uint16_t millivolt)
     {
-        if (millivolt % XPOWERS_AXP202_LDOIO_VOL_STEPS) {
-            log_e("Mistake ! The steps is must %u mV", XPOWERS_AXP202_LDOIO_VOL_STEPS);
-            return false;
-        }
-        if (millivolt < XPOWERS_AXP202_LDOIO_VOL_MIN) {
-            log_e("Mistake ! LDOIO minimum output voltage is  %umV", XPOWERS_AXP202_LDOIO_VOL_MIN);
-            return false;
-        } else if (millivolt > XPOWERS_AXP202_LDOIO_VOL_MAX) {
-            log_e("Mistake ! LDOIO maximum output voltage is  %umV", XPOWERS_AXP202_LDOIO_VOL_MAX);
-            return false;
-        }
-        int val = readRegister(XPOWERS_AXP202_GPIO0_VOL);
-        if (val == -1)return false;
-        val |=  (((millivolt - XPOWERS_AXP202_LDOIO_VOL_MIN) / XPOWERS_AXP202_LDOIO_VOL_STEPS) << 4);
-        return 0 == writeRegister(XPOWERS_AXP202_GPIO0_VOL, val);
+        return set<XPowersAXP202Field::LDOioVoltage>(millivolt);
     }
 
     uint16_t getLDOioVoltage(void)
     {
-        int val = readRegister(XPOWERS_AXP202_GPIO0_VOL);
-        if (val == -1)return 0;
-        val >>= 4;
-        val *= XPOWERS_AXP202_LDOIO_VOL_STEPS;
-        val += XPOWERS_AXP202_LDOIO_VOL_MIN;
-        return val;
+        return get<XPowersAXP202Field::LDOioVoltage>();
     }
 
     /*
@@ -581,43 +574,27 @@ public:
     */
     bool isEnableLDO2(void)
     {
-        return getRegisterBit(XPOWERS_AXP202_LDO234_DC23_CTL, 2);
+        return get<XPowersAXP202Field::LDO2Enable>();
     }
 
     bool enableLDO2(void)
     {
-        return setRegisterBit(XPOWERS_AXP202_LDO234_DC23_CTL, 2);
+        return set<XPowersAXP202Field::LDO2Enable>(1);
     }
 
     bool disableLDO2(void)
     {
-        return clrRegisterBit(XPOWERS_AXP202_LDO234_DC23_CTL, 2);
+        return set<XPowersAXP202Field::LDO2Enable>(0);
     }
 
     bool setLDO2Voltage(uint16_t millivolt)
     {
-        if (millivolt % XPOWERS_AXP202_LDO2_VOL_STEPS) {
-            log_e("Mistake ! The steps is must %u mV", XPOWERS_AXP202_LDO2_VOL_STEPS);
-            return false;
-        }
-        if (millivolt < XPOWERS_AXP202_LDO2_VOL_MIN) {
-            log_e("Mistake ! LDO2 minimum output voltage is  %umV", XPOWERS_AXP202_LDO2_VOL_MIN);
-            return false;
-        } else if (millivolt > XPOWERS_AXP202_LDO2_VOL_MAX) {
-            log_e("Mistake ! LDO2 maximum output voltage is  %umV", XPOWERS_AXP202_LDO2_VOL_MAX);
-            return false;
-        }
-
-        int val = readRegister(XPOWERS_AXP202_LDO24OUT_VOL);
-        if (val == -1) return false;
-        val  &= 0x0F;
-        return 0 == writeRegister(XPOWERS_AXP202_LDO24OUT_VOL, val | (((millivolt - XPOWERS_AXP202_LDO2_VOL_MIN) / XPOWERS_AXP202_LDO2_VOL_STEPS) << XPOWERS_AXP202_LDO2_VOL_BIT_MASK));
+        return set<XPowersAXP202Field::LDO2Voltage>(millivolt);
     }
 
     uint16_t getLDO2Voltage(void)
     {
-        int val = readRegister(XPOWERS_AXP202_LDO24OUT_VOL) & 0xF0;
-        return (val >> XPOWERS_AXP202_LDO2_VOL_BIT_MASK) * XPOWERS_AXP202_LDO2_VOL_STEPS + XPOWERS_AXP202_LDO2_VOL_MIN;
+        return get<XPowersAXP202Field::LDO2Voltage>();
     }
 
     /*
@@ -625,35 +602,23 @@ public:
      */
     bool isEnableLDO3(void)
     {
-        return getRegisterBit(XPOWERS_AXP202_LDO234_DC23_CTL, 6);
+        return get<XPowersAXP202Field::LDO3Enable>();
     }
 
     bool enableLDO3(void)
     {
-        return setRegisterBit(XPOWERS_AXP202_LDO234_DC23_CTL, 6);
+        return set<XPowersAXP202Field::LDO3Enable>(1);
     }
 
     bool disableLDO3(void)
     {
-        return clrRegisterBit(XPOWERS_AXP202_LDO234_DC23_CTL, 6);
+        return set<XPowersAXP202Field::LDO3Enable>(0);
     }
 
 
     bool setLDO3Voltage(uint16_t millivolt)
     {
-        if (millivolt % XPOWERS_AXP202_LDO3_VOL_STEPS) {
-            log_e("Mistake ! The steps is must %u mV", XPOWERS_AXP202_LDO3_VOL_STEPS);
-            return false;
-        }
-        if (millivolt < XPOWERS_AXP202_LDO3_VOL_MIN) {
-            log_e("Mistake ! LDO3 minimum output voltage is  %umV", XPOWERS_AXP202_LDO3_VOL_MIN);
-            return false;
-        } else if (millivolt > XPOWERS_AXP202_LDO3_VOL_MAX) {
-            log_e("Mistake ! LDO3 maximum output voltage is  %umV", XPOWERS_AXP202_LDO3_VOL_MAX);
-            return false;
-        }
-        int val = readRegister(XPOWERS_AXP202_LDO3OUT_VOL) & 0x80;
-        return 0 == writeRegister(XPOWERS_AXP202_LDO3OUT_VOL, val | ((millivolt - XPOWERS_AXP202_LDO3_VOL_MIN) / XPOWERS_AXP202_LDO3_VOL_STEPS));
+        return set<XPowersAXP202Field::LDO3Voltage>(millivolt);
     }
 
     uint16_t getLDO3Voltage(void)
@@ -665,8 +630,7 @@ public:
             log_i("ldo3 pass-through mode");
             return getVbusVoltage();
         }
-        val &= 0x7F;
-        return (val * XPOWERS_AXP202_LDO3_VOL_STEPS) + XPOWERS_AXP202_LDO3_VOL_MIN;
+        return XPowersAXP202Field::LDO3Voltage::decode(val);
     }
 
     /*
@@ -674,17 +638,17 @@ public:
      */
     bool isEnableLDO4(void)
     {
-        return getRegisterBit(XPOWERS_AXP202_LDO234_DC23_CTL, 3);
+        return get<XPowersAXP202Field::LDO4Enable>();
     }
 
     bool enableLDO4(void)
     {
-        return setRegisterBit(XPOWERS_AXP202_LDO234_DC23_CTL, 3);
+        return set<XPowersAXP202Field::LDO4Enable>(1);
     }
 
     bool disableLDO4(void)
     {
-        return clrRegisterBit(XPOWERS_AXP202_LDO234_DC23_CTL, 3);
+        return set<XPowersAXP202Field::LDO4Enable>(0);
     }
 
     // Support setting voltage
@@ -764,44 +728,27 @@ public:
 
     bool isEnableDC2(void)
     {
-        return getRegisterBit(XPOWERS_AXP202_LDO234_DC23_CTL, 4);
+        return get<XPowersAXP202Field::DC2Enable>();
     }
 
     bool enableDC2(void)
     {
-        return setRegisterBit(XPOWERS_AXP202_LDO234_DC23_CTL, 4);
+        return set<XPowersAXP202Field::DC2Enable>(1);
     }
 
     bool disableDC2(void)
     {
-        return clrRegisterBit(XPOWERS_AXP202_LDO234_DC23_CTL, 4);
+        return set<XPowersAXP202Field::DC2Enable>(0);
     }
 
     bool setDC2Voltage(uint16_t millivolt)
     {
-        if (millivolt % XPOWERS_AXP202_DC2_VOL_STEPS) {
-            log_e("Mistake ! The steps is must %u mV", XPOWERS_AXP202_DC2_VOL_STEPS);
-            return false;
-        }
-        if (millivolt < XPOWERS_AXP202_DC2_VOL_MIN) {
-            log_e("Mistake ! DCDC2 minimum output voltage is  %umV", XPOWERS_AXP202_DC2_VOL_MIN);
-            return false;
-        } else if (millivolt > XPOWERS_AXP202_DC2_VOL_MAX) {
-            log_e("Mistake ! DCDC2 maximum output voltage is  %umV", XPOWERS_AXP202_DC2_VOL_MAX);
-            return false;
-        }
-        int val = readRegister(XPOWERS_AXP202_DC2OUT_VOL);
-        if (val == -1)return false;
-        val  &= 0x80;
-        val |= (millivolt - XPOWERS_AXP202_DC2_VOL_MIN) / XPOWERS_AXP202_DC2_VOL_STEPS;
-        return 0 == writeRegister(XPOWERS_AXP202_DC2OUT_VOL, val);
+        return set<XPowersAXP202Field::DC2Voltage>(millivolt);
     }
 
     uint16_t getDC2Voltage(void)
     {
-        int val = readRegister(XPOWERS_AXP202_DC2OUT_VOL);
-        if (val == -1)return 0;
-        return (val * XPOWERS_AXP202_DC2_VOL_STEPS) + XPOWERS_AXP202_DC2_VOL_MIN;
+        return get<XPowersAXP202Field::DC2Voltage>();
     }
 
     /*
@@ -821,40 +768,27 @@ public:
 
     bool isEnableDC3(void)
     {
-        return getRegisterBit(XPOWERS_AXP202_LDO234_DC23_CTL, 1);
+        return get<XPowersAXP202Field::DC3Enable>();
     }
 
     bool enableDC3(void)
     {
-        return setRegisterBit(XPOWERS_AXP202_LDO234_DC23_CTL, 1);
+        return set<XPowersAXP202Field::DC3Enable>(1);
     }
 
     bool disableDC3(void)
     {
-        return clrRegisterBit(XPOWERS_AXP202_LDO234_DC23_CTL, 1);
+        return set<XPowersAXP202Field::DC3Enable>(0);
     }
 
     bool setDC3Voltage(uint16_t millivolt)
     {
-        if (millivolt % XPOWERS_AXP202_DC3_VOL_STEPS) {
-            log_e("Mistake ! The steps is must %u mV", XPOWERS_AXP202_DC3_VOL_STEPS);
-            return false;
-        }
-        if (millivolt < XPOWERS_AXP202_DC3_VOL_MIN) {
-            log_e("Mistake ! DCDC3 minimum output voltage is  %umV", XPOWERS_AXP202_DC3_VOL_MIN);
-            return false;
-        } else if (millivolt > XPOWERS_AXP202_DC3_VOL_MAX) {
-            log_e("Mistake ! DCDC3 maximum output voltage is  %umV", XPOWERS_AXP202_DC3_VOL_MAX);
-            return false;
-        }
-        return 0 == writeRegister(XPOWERS_AXP202_DC3OUT_VOL, (millivolt - XPOWERS_AXP202_DC3_VOL_MIN) / XPOWERS_AXP202_DC3_VOL_STEPS);
+        return set<XPowersAXP202Field::DC3Voltage>(millivolt);
     }
 
     uint16_t getDC3Voltage(void)
     {
-        int val = readRegister(XPOWERS_AXP202_DC3OUT_VOL);
-        if (val == -1)return 0;
-        return (val * XPOWERS_AXP202_DC3_VOL_STEPS) + XPOWERS_AXP202_DC3_VOL_MIN;
+        return get<XPowersAXP202Field::DC3Voltage>();
     }
 
     /*
@@ -196,6 +196,88 @@ typedef enum {
     XPOWER_PWROK_DELAY_64MS,
 } xpower_pwrok_delay_t;
 
+/**
+ * @brief Register fields behind the thin get<F>()/set<F>() wrappers below.
+ * Non-linear fields (DC2..DC5 voltages, which change step size part way
+ * through their range) keep their hand-written code, as do the enum-typed
+ * option setters, which already take the raw register code.
+ */
+namespace XPowersAXP2101Field {
+
+// DC1 owns REG 0x82 (bits 7:5 are reserved), so setting it needs no read.
+using DC1Voltage     = XPowersField<XPOWERS_AXP2101_DC_VOL0_CTRL, 0, 5, XPOWERS_AXP2101_DCDC1_VOL_STEPS,
+                                    XPOWERS_AXP2101_DCDC1_VOL_MIN, XPOWERS_AXP2101_DCDC1_VOL_MAX, 0x00>;
+using ALDO1Voltage   = XPowersField<XPOWERS_AXP2101_LDO_VOL0_CTRL, 0, 5, XPOWERS_AXP2101_ALDO1_VOL_STEPS,
+                                    XPOWERS_AXP2101_ALDO1_VOL_MIN, XPOWERS_AXP2101_ALDO1_VOL_MAX>;
+using ALDO2Voltage   = XPowersField<XPOWERS_AXP2101_LDO_VOL1_CTRL, 0, 5, XPOWERS_AXP2101_ALDO2_VOL_STEPS,
+                                    XPOWERS_AXP2101_ALDO2_VOL_MIN, XPOWERS_AXP2101_ALDO2_VOL_MAX>;
+using ALDO3Voltage   = XPowersField<XPOWERS_AXP2101_LDO_VOL2_CTRL, 0, 5, XPOWERS_AXP2101_ALDO3_VOL_STEPS,
+                                    XPOWERS_AXP2101_ALDO3_VOL_MIN, XPOWERS_AXP2101_ALDO3_VOL_MAX>;
+using ALDO4Voltage   = XPowersField<XPOWERS_AXP2101_LDO_VOL3_CTRL, 0, 5, XPOWERS_AXP2101_ALDO4_VOL_STEPS,
+                                    XPOWERS_AXP2101_ALDO4_VOL_MIN, XPOWERS_AXP2101_ALDO4_VOL_MAX>;
+using BLDO1Voltage   = XPowersField<XPOWERS_AXP2101_LDO_VOL4_CTRL, 0, 5, XPOWERS_AXP2101_BLDO1_VOL_STEPS,
+                                    XPOWERS_AXP2101_BLDO1_VOL_MIN, XPOWERS_AXP2101_BLDO1_VOL_MAX>;
+using BLDO2Voltage   = XPowersField<XPOWERS_AXP2101_LDO_VOL5_CTRL, 0, 5, XPOWERS_AXP2101_BLDO2_VOL_STEPS,
+                                    XPOWERS_AXP2101_BLDO2_VOL_MIN, XPOWERS_AXP2101_BLDO2_VOL_MAX>;
+using CPUSLDOVoltage = XPowersField<XPOWERS_AXP2101_LDO_VOL6_CTRL, 0, 5, XPOWERS_AXP2101_CPUSLDO_VOL_STEPS,
+                                    XPOWERS_AXP2101_CPUSLDO_VOL_MIN, XPOWERS_AXP2101_CPUSLDO_VOL_MAX>;
+using DLDO1Voltage   = XPowersField<XPOWERS_AXP2101_LDO_VOL7_CTRL, 0, 5, XPOWERS_AXP2101_DLDO1_VOL_STEPS,
+                                    XPOWERS_AXP2101_DLDO1_VOL_MIN, XPOWERS_AXP2101_DLDO1_VOL_MAX>;
+using DLDO2Voltage   = XPowersField<XPOWERS_AXP2101_LDO_VOL8_CTRL, 0, 5, XPOWERS_AXP2101_DLDO2_VOL_STEPS,
+                                    XPOWERS_AXP2101_DLDO2_VOL_MIN, XPOWERS_AXP2101_DLDO2_VOL_MAX>;
+
+using DC1Enable      = XPowersBit<XPOWERS_AXP2101_DC_ONOFF_DVM_CTRL, 0>;
+using DC2Enable      = XPowersBit<XPOWERS_AXP2101_DC_ONOFF_DVM_CTRL, 1>;
+using DC3Enable      = XPowersBit<XPOWERS_AXP2101_DC_ONOFF_DVM_CTRL, 2>;
+using DC4Enable      = XPowersBit<XPOWERS_AXP2101_DC_ONOFF_DVM_CTRL, 3>;
+using DC5Enable      = XPowersBit<XPOWERS_AXP2101_DC_ONOFF_DVM_CTRL, 4>;
+using ALDO1Enable    = XPowersBit<XPOWERS_AXP2101_LDO_ONOFF_CTRL0, 0>;
+using ALDO2Enable    = XPowersBit<XPOWERS_AXP2101_LDO_ONOFF_CTRL0, 1>;
+using ALDO3Enable    = XPowersBit<XPOWERS_AXP2101_LDO_ONOFF_CTRL0, 2>;
+using ALDO4Enable    = XPowersBit<XPOWERS_AXP2101_LDO_ONOFF_CTRL0, 3>;
+using BLDO1Enable    = XPowersBit<XPOWERS_AXP2101_LDO_ONOFF_CTRL0, 4>;
+using BLDO2Enable    = XPowersBit<XPOWERS_AXP2101_LDO_ONOFF_CTRL0, 5>;
+using CPUSLDOEnable  = XPowersBit<XPOWERS_AXP2101_LDO_ONOFF_CTRL0, 6>;
+using DLDO1Enable    = XPowersBit<XPOWERS_AXP2101_LDO_ONOFF_CTRL0, 7>;
+using DLDO2Enable    = XPowersBit<XPOWERS_AXP2101_LDO_ONOFF_CTRL1, 0>;
+
+using BattVoltageAdc = XPowersBit<XPOWERS_AXP2101_ADC_CHANNEL_CTRL, 0>;
+using TSPinAdc       = XPowersBit<XPOWERS_AXP2101_ADC_CHANNEL_CTRL, 1>;
+using VbusVoltageAdc = XPowersBit<XPOWERS_AXP2101_ADC_CHANNEL_CTRL, 2>;
+using SysVoltageAdc  = XPowersBit<XPOWERS_AXP2101_ADC_CHANNEL_CTRL, 3>;
+using TemperatureAdc = XPowersBit<XPOWERS_AXP2101_ADC_CHANNEL_CTRL, 4>;
+using GeneralAdc     = XPowersBit<XPOWERS_AXP2101_ADC_CHANNEL_CTRL, 5>;
+using BattDetect     = XPowersBit<XPOWERS_AXP2101_BAT_DET_CTRL, 0>;
+
+using ButtonBatteryVoltage    = XPowersField<XPOWERS_AXP2101_BTN_BAT_CHG_VOL_SET, 0, 3, XPOWERS_AXP2101_BTN_VOL_STEPS,
+                                             XPOWERS_AXP2101_BTN_VOL_MIN, XPOWERS_AXP2101_BTN_VOL_MAX>;
+using SysPowerDownVoltage     = XPowersField<XPOWERS_AXP2101_VOFF_SET, 0, 3, XPOWERS_AXP2101_VSYS_VOL_THRESHOLD_STEPS,
+                                             XPOWERS_AXP2101_VSYS_VOL_THRESHOLD_MIN, XPOWERS_AXP2101_VSYS_VOL_THRESHOLD_MAX>;
+using LowBatWarnThreshold     = XPowersField<XPOWERS_AXP2101_LOW_BAT_WARN_SET, 4, 4, 1, 5, 20>;     // percent
+using LowBatShutdownThreshold = XPowersField<XPOWERS_AXP2101_LOW_BAT_WARN_SET, 0, 4>;               // percent
+
+} // namespace XPowersAXP2101Field
+
+/**
+ * @brief Status, ADC and IRQ state decoded from one burst read of
+ *        STATUS1 .. INTSTS3 (0x00 .. 0x4A), see XPowersAXP2101::readSnapshot().
+ *        Fields follow the matching single-value getters.
+ */
+typedef struct {
+    uint8_t  status1;                   // raw STATUS1
+    uint8_t  status2;                   // raw STATUS2
+    bool     vbus_in;                   // isVbusIn()
+    bool     battery_connected;         // isBatteryConnect()
+    bool     charging;                  // isCharging()
+    xpowers_chg_status_t charger_status; // getChargerStatus()
+    uint16_t batt_mv;                   // getBattVoltage(), 0 without battery
+    uint16_t vbus_mv;                   // getVbusVoltage(), 0 without VBUS
+    uint16_t sys_mv;                    // getSystemVoltage()
+    uint16_t ts_raw;                    // getTsTemperature()
+    float    temperature;               // getTemperature(), degC
+    uint32_t irq_status;                // getIrqStatus()
+} xpowers_axp2101_snapshot_t;
+
 class XPowersAXP2101 :
     public XPowersCommon<XPowersAXP2101>, public XPowersLibInterface
 {
@@ -578,29 +660,12 @@ public:
     //Button battery charge termination voltage setting
     bool setButtonBatteryChargeVoltage(uint16_t millivolt)
     {
-        if (millivolt % XPOWERS_AXP2101_BTN_VOL_STEPS) {
-            log_e("Mistake ! Button battery charging step voltage is %u mV", XPOWERS_AXP2101_BTN_VOL_STEPS);
-            return false;
-        }
-        if (millivolt < XPOWERS_AXP2101_BTN_VOL_MIN) {
-            log_e("Mistake ! The minimum charge termination voltage of the coin cell battery is %u mV", XPOWERS_AXP2101_BTN_VOL_MIN);
-            return false;
-        } else if (millivolt > XPOWERS_AXP2101_BTN_VOL_MAX) {
-            log_e("Mistake ! The minimum charge termination voltage of the coin cell battery is %u mV", XPOWERS_AXP2101_BTN_VOL_MAX);
-            return false;
-        }
-        int val =  readRegister(XPOWERS_AXP2101_BTN_BAT_CHG_VOL_SET);
-        if (val == -1)return 0;
-        val  &= 0xF8;
-        val |= (millivolt - XPOWERS_AXP2101_BTN_VOL_MIN) / XPOWERS_AXP2101_BTN_VOL_STEPS;
-        return 0 == writeRegister(XPOWERS_AXP2101_BTN_BAT_CHG_VOL_SET, val);
+        return set<XPowersAXP2101Field::ButtonBatteryVoltage>(millivolt);
     }
 
     uint16_t getButtonBatteryVoltage(void)
     {
-        int val =  readRegister(XPOWERS_AXP2101_BTN_BAT_CHG_VOL_SET);
-        if (val == -1)return 0;
-        return (val & 0x07) * XPOWERS_AXP2101_BTN_VOL_STEPS + XPOWERS_AXP2101_BTN_VOL_MIN;
+        return get<XPowersAXP2101Field::ButtonBatteryVoltage>();
     }
 
 
@@ -677,20 +742,12 @@ public:
      */
     void setLowBatWarnThreshold(uint8_t percentage)
     {
-        if (percentage < 5 || percentage > 20)return;
-        int val = readRegister(XPOWERS_AXP2101_LOW_BAT_WARN_SET);
-        if (val == -1)return;
-        val &= 0x0F;
-        writeRegister(XPOWERS_AXP2101_LOW_BAT_WARN_SET, val | ((percentage - 5) << 4));
+        set<XPowersAXP2101Field::LowBatWarnThreshold>(percentage);
     }
 
     uint8_t getLowBatWarnThreshold(void)
     {
-        int val = readRegister(XPOWERS_AXP2101_LOW_BAT_WARN_SET);
-        if (val == -1)return 0;
-        val &= 0xF0;
-        val >>= 4;
-        return val;
+        return get<XPowersAXP2101Field::LowBatWarnThreshold>();
     }
 
     /**
@@ -700,18 +757,12 @@ public:
      */
     void setLowBatShutdownThreshold(uint8_t opt)
     {
-        if (opt > 15) {
-            opt = 15;
-        }
-        int val = readRegister(XPOWERS_AXP2101_LOW_BAT_WARN_SET);
-        if (val == -1)return;
-        val &= 0xF0;
-        writeRegister(XPOWERS_AXP2101_LOW_BAT_WARN_SET, val | opt);
+        set<XPowersAXP2101Field::LowBatShutdownThreshold>(opt > 15 ? 15 : opt);
     }
 
     uint8_t getLowBatShutdownThreshold(void)
     {
-        return (readRegister(XPOWERS_AXP2101_LOW_BAT_WARN_SET) & 0x0F);
+        return get<XPowersAXP2101Field::LowBatShutdownThreshold>();
     }
 
     //!  PWRON statu  20
@@ -921,28 +972,12 @@ public:
     // below this value will shut down the PMU,Adjustment range 2600mV~3300mV
     bool setSysPowerDownVoltage(uint16_t millivolt)
     {
-        if (millivolt % XPOWERS_AXP2101_VSYS_VOL_THRESHOLD_STEPS) {
-            log_e("Mistake ! The steps is must %u mV", XPOWERS_AXP2101_VSYS_VOL_THRESHOLD_STEPS);
-            return false;
-        }
-        if (millivolt < XPOWERS_AXP2101_VSYS_VOL_THRESHOLD_MIN) {
-            log_e("Mistake ! The minimum settable voltage of VSYS is %u mV", XPOWERS_AXP2101_VSYS_VOL_THRESHOLD_MIN);
-            return false;
-        } else if (millivolt > XPOWERS_AXP2101_VSYS_VOL_THRESHOLD_MAX) {
-            log_e("Mistake ! The maximum settable voltage of VSYS is %u mV", XPOWERS_AXP2101_VSYS_VOL_THRESHOLD_MAX);
-            return false;
-        }
-        int val = readRegister(XPOWERS_AXP2101_VOFF_SET);
-        if (val == -1)return false;
-        val &= 0xF8;
-        return 0 == writeRegister(XPOWERS_AXP2101_VOFF_SET, val | ((millivolt - XPOWERS_AXP2101_VSYS_VOL_THRESHOLD_MIN) / XPOWERS_AXP2101_VSYS_VOL_THRESHOLD_STEPS));
+        return set<XPowersAXP2101Field::SysPowerDownVoltage>(millivolt);
     }
 
     uint16_t getSysPowerDownVoltage(void)
     {
-        int val = readRegister(XPOWERS_AXP2101_VOFF_SET);
-        if (val == -1)return false;
-        return (val & 0x07) * XPOWERS_AXP2101_VSYS_VOL_THRESHOLD_STEPS + XPOWERS_AXP2101_VSYS_VOL_THRESHOLD_MIN;
+        return get<XPowersAXP2101Field::SysPowerDownVoltage>();
     }
 
     //  PWROK setting and PWROFF sequence control 25.
@@ -1409,38 +1444,27 @@ public:
      */
     bool isEnableDC1(void)
     {
-        return getRegisterBit(XPOWERS_AXP2101_DC_ONOFF_DVM_CTRL, 0);
+        return get<XPowersAXP2101Field::DC1Enable>();
     }
 
     bool enableDC1(void)
     {
-        return setRegisterBit(XPOWERS_AXP2101_DC_ONOFF_DVM_CTRL, 0);
+        return set<XPowersAXP2101Field::DC1Enable>(1);
     }
 
     bool disableDC1(void)
     {
-        return clrRegisterBit(XPOWERS_AXP2101_DC_ONOFF_DVM_CTRL, 0);
+        return set<XPowersAXP2101Field::DC1Enable>(0);
     }
 
     bool setDC1Voltage(uint16_t millivolt)
     {
-        if (millivolt % XPOWERS_AXP2101_DCDC1_VOL_STEPS) {
-            log_e("Mistake ! The steps is must %u mV", XPOWERS_AXP2101_DCDC1_VOL_STEPS);
-            return false;
-        }
-        if (millivolt < XPOWERS_AXP2101_DCDC1_VOL_MIN) {
-            log_e("Mistake ! DC1 minimum voltage is %u mV", XPOWERS_AXP2101_DCDC1_VOL_MIN);
-            return false;
-        } else if (millivolt > XPOWERS_AXP2101_DCDC1_VOL_MAX) {
-            log_e("Mistake ! DC1 maximum voltage is %u mV", XPOWERS_AXP2101_DCDC1_VOL_MAX);
-            return false;
-        }
-        return 0 == writeRegister(XPOWERS_AXP2101_DC_VOL0_CTRL, (millivolt - XPOWERS_AXP2101_DCDC1_VOL_MIN) / XPOWERS_AXP2101_DCDC1_VOL_STEPS);
+        return set<XPowersAXP2101Field::DC1Voltage>(millivolt);
     }
 
     uint16_t getDC1Voltage(void)
     {
-        return (readRegister(XPOWERS_AXP2101_DC_VOL0_CTRL) & 0x1F) * XPOWERS_AXP2101_DCDC1_VOL_STEPS + XPOWERS_AXP2101_DCDC1_VOL_MIN;
+        return get<XPowersAXP2101Field::DC1Voltage>();
     }
 
 
@@ -1461,17 +1485,17 @@ public:
      */
     bool isEnableDC2(void)
     {
-        return getRegisterBit(XPOWERS_AXP2101_DC_ONOFF_DVM_CTRL, 1);
+        return get<XPowersAXP2101Field::DC2Enable>();
     }
 
     bool enableDC2(void)
     {
-        return setRegisterBit(XPOWERS_AXP2101_DC_ONOFF_DVM_CTRL, 1);
+        return set<XPowersAXP2101Field::DC2Enable>(1);
     }
 
     bool disableDC2(void)
     {
-        return clrRegisterBit(XPOWERS_AXP2101_DC_ONOFF_DVM_CTRL, 1);
+        return set<XPowersAXP2101Field::DC2Enable>(0);
     }
 
     bool setDC2Voltage(uint16_t millivolt)
@@ -1530,17 +1554,17 @@ public:
 
     bool isEnableDC3(void)
     {
-        return getRegisterBit(XPOWERS_AXP2101_DC_ONOFF_DVM_CTRL, 2);
+        return get<XPowersAXP2101Field::DC3Enable>();
     }
 
     bool enableDC3(void)
     {
-        return setRegisterBit(XPOWERS_AXP2101_DC_ONOFF_DVM_CTRL, 2);
+        return set<XPowersAXP2101Field::DC3Enable>(1);
     }
 
     bool disableDC3(void)
     {
-        return clrRegisterBit(XPOWERS_AXP2101_DC_ONOFF_DVM_CTRL, 2);
+        return set<XPowersAXP2101Field::DC3Enable>(0);
     }
 
     /**
@@ -1619,17 +1643,17 @@ public:
      */
     bool isEnableDC4(void)
     {
-        return getRegisterBit(XPOWERS_AXP2101_DC_ONOFF_DVM_CTRL, 3);
+        return get<XPowersAXP2101Field::DC4Enable>();
     }
 
     bool enableDC4(void)
     {
-        return setRegisterBit(XPOWERS_AXP2101_DC_ONOFF_DVM_CTRL, 3);
+        return set<XPowersAXP2101Field::DC4Enable>(1);
     }
 
     bool disableDC4(void)
     {
-        return clrRegisterBit(XPOWERS_AXP2101_DC_ONOFF_DVM_CTRL, 3);
+        return set<XPowersAXP2101Field::DC4Enable>(0);
     }
 
     bool setDC4Voltage(uint16_t millivolt)
@@ -1685,17 +1709,17 @@ public:
     */
     bool isEnableDC5(void)
     {
-        return getRegisterBit(XPOWERS_AXP2101_DC_ONOFF_DVM_CTRL, 4);
+        return get<XPowersAXP2101Field::DC5Enable>();
     }
 
     bool enableDC5(void)
     {
-        return setRegisterBit(XPOWERS_AXP2101_DC_ONOFF_DVM_CTRL, 4);
+        return set<XPowersAXP2101Field::DC5Enable>(1);
     }
 
     bool disableDC5(void)
     {
-        return clrRegisterBit(XPOWERS_AXP2101_DC_ONOFF_DVM_CTRL, 4);
+        return set<XPowersAXP2101Field::DC5Enable>(0);
     }
 
     bool setDC5Voltage(uint16_t millivolt)
@@ -1762,41 +1786,27 @@ public:
     */
     bool isEnableALDO1(void)
     {
-        return getRegisterBit(XPOWERS_AXP2101_LDO_ONOFF_CTRL0, 0);
+        return get<XPowersAXP2101Field::ALDO1Enable>();
     }
 
     bool enableALDO1(void)
     {
-        return setRegisterBit(XPOWERS_AXP2101_LDO_ONOFF_CTRL0, 0);
+        return set<XPowersAXP2101Field::ALDO1Enable>(1);
     }
 
     bool disableALDO1(void)
     {
-        return clrRegisterBit(XPOWERS_AXP2101_LDO_ONOFF_CTRL0, 0);
+        return set<XPowersAXP2101Field::ALDO1Enable>(0);
     }
 
     bool setALDO1Voltage(uint16_t millivolt)
     {
-        if (millivolt % XPOWERS_AXP2101_ALDO1_VOL_STEPS) {
-            log_e("Mistake ! The steps is must %u mV", XPOWERS_AXP2101_ALDO1_VOL_STEPS);
-            return false;
-        }
-        if (millivolt < XPOWERS_AXP2101_ALDO1_VOL_MIN) {
-            log_e("Mistake ! ALDO1 minimum output voltage is  %umV", XPOWERS_AXP2101_ALDO1_VOL_MIN);
-            return false;
-        } else if (millivolt > XPOWERS_AXP2101_ALDO1_VOL_MAX) {
-            log_e("Mistake ! ALDO1 maximum output voltage is  %umV", XPOWERS_AXP2101_ALDO1_VOL_MAX);
-            return false;
-        }
-        uint16_t val =  readRegister(XPOWERS_AXP2101_LDO_VOL0_CTRL) & 0xE0;
-        val |= (millivolt - XPOWERS_AXP2101_ALDO1_VOL_MIN) / XPOWERS_AXP2101_ALDO1_VOL_STEPS;
-        return 0 == writeRegister(XPOWERS_AXP2101_LDO_VOL0_CTRL, val);
+        return set<XPowersAXP2101Field::ALDO1Voltage>(millivolt);
     }
 
     uint16_t getALDO1Voltage(void)
     {
-        uint16_t val =  readRegister(XPOWERS_AXP2101_LDO_VOL0_CTRL) & 0x1F;
-        return val * XPOWERS_AXP2101_ALDO1_VOL_STEPS + XPOWERS_AXP2101_ALDO1_VOL_MIN;
+        return get<XPowersAXP2101Field::ALDO1Voltage>();
     }
 
     /*
@@ -1804,41 +1814,27 @@ public:
     */
     bool isEnableALDO2(void)
     {
-        return getRegisterBit(XPOWERS_AXP2101_LDO_ONOFF_CTRL0, 1);
+        return get<XPowersAXP2101Field::ALDO2Enable>();
     }
 
     bool enableALDO2(void)
     {
-        return setRegisterBit(XPOWERS_AXP2101_LDO_ONOFF_CTRL0, 1);
+        return set<XPowersAXP2101Field::ALDO2Enable>(1);
     }
 
     bool disableALDO2(void)
     {
-        return clrRegisterBit(XPOWERS_AXP2101_LDO_ONOFF_CTRL0, 1);
+        return set<XPowersAXP2101Field::ALDO2Enable>(0);
     }
 
     bool setALDO2Voltage(uint16_t millivolt)
     {
-        if (millivolt % XPOWERS_AXP2101_ALDO2_VOL_STEPS) {
-            log_e("Mistake ! The steps is must %u mV", XPOWERS_AXP2101_ALDO2_VOL_STEPS);
-            return false;
-        }
-        if (millivolt < XPOWERS_AXP2101_ALDO2_VOL_MIN) {
-            log_e("Mistake ! ALDO2 minimum output voltage is  %umV", XPOWERS_AXP2101_ALDO2_VOL_MIN);
-            return false;
-        } else if (millivolt > XPOWERS_AXP2101_ALDO2_VOL_MAX) {
-            log_e("Mistake ! ALDO2 maximum output voltage is  %umV", XPOWERS_AXP2101_ALDO2_VOL_MAX);
-            return false;
-        }
-        uint16_t val =  readRegister(XPOWERS_AXP2101_LDO_VOL1_CTRL) & 0xE0;
-        val |= (millivolt - XPOWERS_AXP2101_ALDO2_VOL_MIN) / XPOWERS_AXP2101_ALDO2_VOL_STEPS;
-        return 0 == writeRegister(XPOWERS_AXP2101_LDO_VOL1_CTRL, val);
+        return set<XPowersAXP2101Field::ALDO2Voltage>(millivolt);
     }
 
     uint16_t getALDO2Voltage(void)
     {
-        uint16_t val =  readRegister(XPOWERS_AXP2101_LDO_VOL1_CTRL) & 0x1F;
-        return val * XPOWERS_AXP2101_ALDO2_VOL_STEPS + XPOWERS_AXP2101_ALDO2_VOL_MIN;
+        return get<XPowersAXP2101Field::ALDO2Voltage>();
     }
 
     /*
@@ -1846,41 +1842,27 @@ public:
      */
     bool isEnableALDO3(void)
     {
-        return getRegisterBit(XPOWERS_AXP2101_LDO_ONOFF_CTRL0, 2);
+        return get<XPowersAXP2101Field::ALDO3Enable>();
     }
 
     bool enableALDO3(void)
     {
-        return setRegisterBit(XPOWERS_AXP2101_LDO_ONOFF_CTRL0, 2);
+        return set<XPowersAXP2101Field::ALDO3Enable>(1);
     }
 
     bool disableALDO3(void)
     {
-        return clrRegisterBit(XPOWERS_AXP2101_LDO_ONOFF_CTRL0, 2);
+        return set<XPowersAXP2101Field::ALDO3Enable>(0);
     }
 
     bool setALDO3Voltage(uint16_t millivolt)
     {
-        if (millivolt % XPOWERS_AXP2101_ALDO3_VOL_STEPS) {
-            log_e("Mistake ! The steps is must %u mV", XPOWERS_AXP2101_ALDO3_VOL_STEPS);
-            return false;
-        }
-        if (millivolt < XPOWERS_AXP2101_ALDO3_VOL_MIN) {
-            log_e("Mistake ! ALDO3 minimum output voltage is  %umV", XPOWERS_AXP2101_ALDO3_VOL_MIN);
-            return false;
-        } else if (millivolt > XPOWERS_AXP2101_ALDO3_VOL_MAX) {
-            log_e("Mistake ! ALDO3 maximum output voltage is  %umV", XPOWERS_AXP2101_ALDO3_VOL_MAX);
-            return false;
-        }
-        uint16_t val =  readRegister(XPOWERS_AXP2101_LDO_VOL2_CTRL) & 0xE0;
-        val |= (millivolt - XPOWERS_AXP2101_ALDO3_VOL_MIN) / XPOWERS_AXP2101_ALDO3_VOL_STEPS;
-        return 0 == writeRegister(XPOWERS_AXP2101_LDO_VOL2_CTRL, val);
+        return set<XPowersAXP2101Field::ALDO3Voltage>(millivolt);
     }
 
     uint16_t getALDO3Voltage(void)
     {
-        uint16_t val =  readRegister(XPOWERS_AXP2101_LDO_VOL2_CTRL) & 0x1F;
-        return val * XPOWERS_AXP2101_ALDO3_VOL_STEPS + XPOWERS_AXP2101_ALDO3_VOL_MIN;
+        return get<XPowersAXP2101Field::ALDO3Voltage>();
     }
 
     /*
@@ -1888,41 +1870,27 @@ public:
      */
     bool isEnableALDO4(void)
     {
-        return getRegisterBit(XPOWERS_AXP2101_LDO_ONOFF_CTRL0, 3);
+        return get<XPowersAXP2101Field::ALDO4Enable>();
     }
 
     bool enableALDO4(void)
     {
-        return setRegisterBit(XPOWERS_AXP2101_LDO_ONOFF_CTRL0, 3);
+        return set<XPowersAXP2101Field::ALDO4Enable>(1);
     }
 
     bool disableALDO4(void)
     {
-        return clrRegisterBit(XPOWERS_AXP2101_LDO_ONOFF_CTRL0, 3);
+        return set<XPowersAXP2101Field::ALDO4Enable>(0);
     }
 
     bool setALDO4Voltage(uint16_t millivolt)
     {
-        if (millivolt % XPOWERS_AXP2101_ALDO4_VOL_STEPS) {
-            log_e("Mistake ! The steps is must %u mV", XPOWERS_AXP2101_ALDO4_VOL_STEPS);
-            return false;
-        }
-        if (millivolt < XPOWERS_AXP2101_ALDO4_VOL_MIN) {
-            log_e("Mistake ! ALDO4 minimum output voltage is  %umV", XPOWERS_AXP2101_ALDO4_VOL_MIN);
-            return false;
-        } else if (millivolt > XPOWERS_AXP2101_ALDO4_VOL_MAX) {
-            log_e("Mistake ! ALDO4 maximum output voltage is  %umV", XPOWERS_AXP2101_ALDO4_VOL_MAX);
-            return false;
-        }
-        uint16_t val =  readRegister(XPOWERS_AXP2101_LDO_VOL3_CTRL) & 0xE0;
-        val |= (millivolt - XPOWERS_AXP2101_ALDO4_VOL_MIN) / XPOWERS_AXP2101_ALDO4_VOL_STEPS;
-        return 0 == writeRegister(XPOWERS_AXP2101_LDO_VOL3_CTRL, val);
+        return set<XPowersAXP2101Field::ALDO4Voltage>(millivolt);
     }
 
     uint16_t getALDO4Voltage(void)
     {
-        uint16_t val =  readRegister(XPOWERS_AXP2101_LDO_VOL3_CTRL) & 0x1F;
-        return val * XPOWERS_AXP2101_ALDO4_VOL_STEPS + XPOWERS_AXP2101_ALDO4_VOL_MIN;
+        return get<XPowersAXP2101Field::ALDO4Voltage>();
     }
 
     /*
@@ -1930,45 +1898,27 @@ public:
     */
     bool isEnableBLDO1(void)
     {
-        return getRegisterBit(XPOWERS_AXP2101_LDO_ONOFF_CTRL0, 4);
+        return get<XPowersAXP2101Field::BLDO1Enable>();
     }
 
     bool enableBLDO1(void)
     {
-        return setRegisterBit(XPOWERS_AXP2101_LDO_ONOFF_CTRL0, 4);
+        return set<XPowersAXP2101Field::BLDO1Enable>(1);
     }
 
     bool disableBLDO1(void)
     {
-        return clrRegisterBit(XPOWERS_AXP2101_LDO_ONOFF_CTRL0, 4);
+        return set<XPowersAXP2101Field::BLDO1Enable>(0);
     }
 
     bool setBLDO1Voltage(uint16_t millivolt)
     {
-        if (millivolt % XPOWERS_AXP2101_BLDO1_VOL_STEPS) {
-            log_e("Mistake ! The steps is must %u mV", XPOWERS_AXP2101_BLDO1_VOL_STEPS);
-            return false;
-        }
-        if (millivolt < XPOWERS_AXP2101_BLDO1_VOL_MIN) {
-            log_e("Mistake ! BLDO1 minimum output voltage is  %umV", XPOWERS_AXP2101_BLDO1_VOL_MIN);
-            return false;
-        } else if (millivolt > XPOWERS_AXP2101_BLDO1_VOL_MAX) {
-            log_e("Mistake ! BLDO1 maximum output voltage is  %umV", XPOWERS_AXP2101_BLDO1_VOL_MAX);
-            return false;
-        }
-        int val =  readRegister(XPOWERS_AXP2101_LDO_VOL4_CTRL);
-        if (val == -1)return  false;
-        val &= 0xE0;
-        val |= (millivolt - XPOWERS_AXP2101_BLDO1_VOL_MIN) / XPOWERS_AXP2101_BLDO1_VOL_STEPS;
-        return 0 == writeRegister(XPOWERS_AXP2101_LDO_VOL4_CTRL, val);
+        return set<XPowersAXP2101Field::BLDO1Voltage>(millivolt);
     }
 
     uint16_t getBLDO1Voltage(void)
     {
-        int val =  readRegister(XPOWERS_AXP2101_LDO_VOL4_CTRL);
-        if (val == -1)return 0;
-        val &= 0x1F;
-        return val * XPOWERS_AXP2101_BLDO1_VOL_STEPS + XPOWERS_AXP2101_BLDO1_VOL_MIN;
+        return get<XPowersAXP2101Field::BLDO1Voltage>();
     }
 
     /*
@@ -1976,43 +1926,27 @@ public:
     */
     bool isEnableBLDO2(void)
     {
-        return getRegisterBit(XPOWERS_AXP2101_LDO_ONOFF_CTRL0, 5);
+        return get<XPowersAXP2101Field::BLDO2Enable>();
     }
 
     bool enableBLDO2(void)
     {
-        return setRegisterBit(XPOWERS_AXP2101_LDO_ONOFF_CTRL0, 5);
+        return set<XPowersAXP2101Field::BLDO2Enable>(1);
     }
 
     bool disableBLDO2(void)
     {
-        return clrRegisterBit(XPOWERS_AXP2101_LDO_ONOFF_CTRL0, 5);
+        return set<XPowersAXP2101Field::BLDO2Enable>(0);
     }
 
     bool setBLDO2Voltage(uint16_t millivolt)
     {
-        if (millivolt % XPOWERS_AXP2101_BLDO2_VOL_STEPS) {
-            log_e("Mistake ! The steps is must %u mV", XPOWERS_AXP2101_BLDO2_VOL_STEPS);
-            return false;
-        }
-        if (millivolt < XPOWERS_AXP2101_BLDO2_VOL_MIN) {
-            log_e("Mistake ! BLDO2 minimum output voltage is  %umV", XPOWERS_AXP2101_BLDO2_VOL_MIN);
-            return false;
-        } else if (millivolt > XPOWERS_AXP2101_BLDO2_VOL_MAX) {
-            log_e("Mistake ! BLDO2 maximum output voltage is  %umV", XPOWERS_AXP2101_BLDO2_VOL_MAX);
-            return false;
-        }
-        uint16_t val =  readRegister(XPOWERS_AXP2101_LDO_VOL5_CTRL) & 0xE0;
-        val |= (millivolt - XPOWERS_AXP2101_BLDO2_VOL_MIN) / XPOWERS_AXP2101_BLDO2_VOL_STEPS;
-        return 0 == writeRegister(XPOWERS_AXP2101_LDO_VOL5_CTRL, val);
+        return set<XPowersAXP2101Field::BLDO2Voltage>(millivolt);
     }
 
     uint16_t getBLDO2Voltage(void)
     {
-        int val =  readRegister(XPOWERS_AXP2101_LDO_VOL5_CTRL);
-        if (val == -1)return 0;
-        val &= 0x1F;
-        return val * XPOWERS_AXP2101_BLDO2_VOL_STEPS + XPOWERS_AXP2101_BLDO2_VOL_MIN;
+        return get<XPowersAXP2101Field::BLDO2Voltage>();
     }
 
     /*
@@ -2020,43 +1954,27 @@ public:
     */
     bool isEnableCPUSLDO(void)
     {
-        return getRegisterBit(XPOWERS_AXP2101_LDO_ONOFF_CTRL0, 6);
+        return get<XPowersAXP2101Field::CPUSLDOEnable>();
     }
 
     bool enableCPUSLDO(void)
     {
-        return setRegisterBit(XPOWERS_AXP2101_LDO_ONOFF_CTRL0, 6);
+        return set<XPowersAXP2101Field::CPUSLDOEnable>(1);
     }
 
     bool disableCPUSLDO(void)
     {
-        return clrRegisterBit(XPOWERS_AXP2101_LDO_ONOFF_CTRL0, 6);
+        return set<XPowersAXP2101Field::CPUSLDOEnable>(0);
     }
 
     bool setCPUSLDOVoltage(uint16_t millivolt)
     {
-        if (millivolt % XPOWERS_AXP2101_CPUSLDO_VOL_STEPS) {
-            log_e("Mistake ! The steps is must %u mV", XPOWERS_AXP2101_CPUSLDO_VOL_STEPS);
-            return false;
-        }
-        if (millivolt < XPOWERS_AXP2101_CPUSLDO_VOL_MIN) {
-            log_e("Mistake ! CPULDO minimum output voltage is  %umV", XPOWERS_AXP2101_CPUSLDO_VOL_MIN);
-            return false;
-        } else if (millivolt > XPOWERS_AXP2101_CPUSLDO_VOL_MAX) {
-            log_e("Mistake ! CPULDO maximum output voltage is  %umV", XPOWERS_AXP2101_CPUSLDO_VOL_MAX);
-            return false;
-        }
-        uint16_t val =  readRegister(XPOWERS_AXP2101_LDO_VOL6_CTRL) & 0xE0;
-        val |= (millivolt - XPOWERS_AXP2101_CPUSLDO_VOL_MIN) / XPOWERS_AXP2101_CPUSLDO_VOL_STEPS;
-        return 0 == writeRegister(XPOWERS_AXP2101_LDO_VOL6_CTRL, val);
+        return set<XPowersAXP2101Field::CPUSLDOVoltage>(millivolt);
     }
 
     uint16_t getCPUSLDOVoltage(void)
     {
-        int val =  readRegister(XPOWERS_AXP2101_LDO_VOL6_CTRL);
-        if (val == -1)return 0;
-        val &= 0x1F;
-        return val * XPOWERS_AXP2101_CPUSLDO_VOL_STEPS + XPOWERS_AXP2101_CPUSLDO_VOL_MIN;
+        return get<XPowersAXP2101Field::CPUSLDOVoltage>();
     }
 
 
@@ -2065,43 +1983,27 @@ public:
     */
     bool isEnableDLDO1(void)
     {
-        return getRegisterBit(XPOWERS_AXP2101_LDO_ONOFF_CTRL0, 7);
+        return get<XPowersAXP2101Field::DLDO1Enable>();
     }
 
     bool enableDLDO1(void)
     {
-        return setRegisterBit(XPOWERS_AXP2101_LDO_ONOFF_CTRL0, 7);
+        return set<XPowersAXP2101Field::DLDO1Enable>(1);
     }
 
     bool disableDLDO1(void)
     {
-        return clrRegisterBit(XPOWERS_AXP2101_LDO_ONOFF_CTRL0, 7);
+        return set<XPowersAXP2101Field::DLDO1Enable>(0);
     }
 
     bool setDLDO1Voltage(uint16_t millivolt)
     {
-        if (millivolt % XPOWERS_AXP2101_DLDO1_VOL_STEPS) {
-            log_e("Mistake ! The steps is must %u mV", XPOWERS_AXP2101_DLDO1_VOL_STEPS);
-            return false;
-        }
-        if (millivolt < XPOWERS_AXP2101_DLDO1_VOL_MIN) {
-            log_e("Mistake ! DLDO1 minimum output voltage is  %umV", XPOWERS_AXP2101_DLDO1_VOL_MIN);
-            return false;
-        } else if (millivolt > XPOWERS_AXP2101_DLDO1_VOL_MAX) {
-            log_e("Mistake ! DLDO1 maximum output voltage is  %umV", XPOWERS_AXP2101_DLDO1_VOL_MAX);
-            return false;
-        }
-        uint16_t val =  readRegister(XPOWERS_AXP2101_LDO_VOL7_CTRL) & 0xE0;
-        val |= (millivolt - XPOWERS_AXP2101_DLDO1_VOL_MIN) / XPOWERS_AXP2101_DLDO1_VOL_STEPS;
-        return 0 == writeRegister(XPOWERS_AXP2101_LDO_VOL7_CTRL, val);
+        return set<XPowersAXP2101Field::DLDO1Voltage>(millivolt);
     }
 
     uint16_t getDLDO1Voltage(void)
     {
-        int val =  readRegister(XPOWERS_AXP2101_LDO_VOL7_CTRL);
-        if (val == -1)return 0;
-        val &= 0x1F;
-        return val * XPOWERS_AXP2101_DLDO1_VOL_STEPS + XPOWERS_AXP2101_DLDO1_VOL_MIN;
+        return get<XPowersAXP2101Field::DLDO1Voltage>();
     }
 
     /*
@@ -2109,43 +2011,27 @@ public:
     */
     bool isEnableDLDO2(void)
     {
-        return getRegisterBit(XPOWERS_AXP2101_LDO_ONOFF_CTRL1, 0);
+        return get<XPowersAXP2101Field::DLDO2Enable>();
     }
 
     bool enableDLDO2(void)
     {
-        return setRegisterBit(XPOWERS_AXP2101_LDO_ONOFF_CTRL1, 0);
+        return set<XPowersAXP2101Field::DLDO2Enable>(1);
     }
 
     bool disableDLDO2(void)
     {
-        return clrRegisterBit(XPOWERS_AXP2101_LDO_ONOFF_CTRL1, 0);
+        return set<XPowersAXP2101Field::DLDO2Enable>(0);
     }
 
     bool setDLDO2Voltage(uint16_t millivolt)
     {
-        if (millivolt % XPOWERS_AXP2101_DLDO2_VOL_STEPS) {
-            log_e("Mistake ! The steps is must %u mV", XPOWERS_AXP2101_DLDO2_VOL_STEPS);
-            return false;
-        }
-        if (millivolt < XPOWERS_AXP2101_DLDO2_VOL_MIN) {
-            log_e("Mistake ! DLDO2 minimum output voltage is  %umV", XPOWERS_AXP2101_DLDO2_VOL_MIN);
-            return false;
-        } else if (millivolt > XPOWERS_AXP2101_DLDO2_VOL_MAX) {
-            log_e("Mistake ! DLDO2 maximum output voltage is  %umV", XPOWERS_AXP2101_DLDO2_VOL_MAX);
-            return false;
-        }
-        uint16_t val =  readRegister(XPOWERS_AXP2101_LDO_VOL8_CTRL) & 0xE0;
-        val |= (millivolt - XPOWERS_AXP2101_DLDO2_VOL_MIN) / XPOWERS_AXP2101_DLDO2_VOL_STEPS;
-        return 0 == writeRegister(XPOWERS_AXP2101_LDO_VOL8_CTRL, val);
+        return set<XPowersAXP2101Field::DLDO2Voltage>(millivolt);
     }
 
     uint16_t getDLDO2Voltage(void)
     {
-        int val =  readRegister(XPOWERS_AXP2101_LDO_VOL8_CTRL);
-        if (val == -1)return 0;
-        val &= 0x1F;
-        return val * XPOWERS_AXP2101_DLDO2_VOL_STEPS + XPOWERS_AXP2101_DLDO2_VOL_MIN;
+        return get<XPowersAXP2101Field::DLDO2Voltage>();
     }
 
 
@@ -2217,22 +2103,22 @@ public:
      */
     bool enableGeneralAdcChannel(void)
     {
-        return setRegisterBit(XPOWERS_AXP2101_ADC_CHANNEL_CTRL, 5);
+        return set<XPowersAXP2101Field::GeneralAdc>(1);
     }
 
     bool disableGeneralAdcChannel(void)
     {
-        return clrRegisterBit(XPOWERS_AXP2101_ADC_CHANNEL_CTRL, 5);
+        return set<XPowersAXP2101Field::GeneralAdc>(0);
     }
 
     bool enableTemperatureMeasure(void)
     {
-        return setRegisterBit(XPOWERS_AXP2101_ADC_CHANNEL_CTRL, 4);
+        return set<XPowersAXP2101Field::TemperatureAdc>(1);
     }
 
     bool disableTemperatureMeasure(void)
     {
-        return clrRegisterBit(XPOWERS_AXP2101_ADC_CHANNEL_CTRL, 4);
+        return set<XPowersAXP2101Field::TemperatureAdc>(0);
     }
 
     float getTemperature(void)
@@ -2243,12 +2129,12 @@ public:
 
     bool enableSystemVoltageMeasure(void)
     {
-        return setRegisterBit(XPOWERS_AXP2101_ADC_CHANNEL_CTRL, 3);
+        return set<XPowersAXP2101Field::SysVoltageAdc>(1);
     }
 
     bool disableSystemVoltageMeasure(void)
     {
-        return clrRegisterBit(XPOWERS_AXP2101_ADC_CHANNEL_CTRL, 3);
+        return set<XPowersAXP2101Field::SysVoltageAdc>(0);
     }
 
     uint16_t getSystemVoltage(void)
@@ -2258,12 +2144,12 @@ public:
 
     bool enableVbusVoltageMeasure(void)
     {
-        return setRegisterBit(XPOWERS_AXP2101_ADC_CHANNEL_CTRL, 2);
+        return set<XPowersAXP2101Field::VbusVoltageAdc>(1);
     }
 
     bool disableVbusVoltageMeasure(void)
     {
-        return clrRegisterBit(XPOWERS_AXP2101_ADC_CHANNEL_CTRL, 2);
+        return set<XPowersAXP2101Field::VbusVoltageAdc>(0);
     }
 
     uint16_t getVbusVoltage(void)
@@ -2276,12 +2162,12 @@ public:
 
     bool enableTSPinMeasure(void)
     {
-        return setRegisterBit(XPOWERS_AXP2101_ADC_CHANNEL_CTRL, 1);
+        return set<XPowersAXP2101Field::TSPinAdc>(1);
     }
 
     bool disableTSPinMeasure(void)
     {
-        return clrRegisterBit(XPOWERS_AXP2101_ADC_CHANNEL_CTRL, 1);
+        return set<XPowersAXP2101Field::TSPinAdc>(0);
     }
 
     bool enableTSPinLowFreqSample(void)
@@ -2301,22 +2187,22 @@ public:
 
     bool enableBattVoltageMeasure(void)
     {
-        return setRegisterBit(XPOWERS_AXP2101_ADC_CHANNEL_CTRL, 0);
+        return set<XPowersAXP2101Field::BattVoltageAdc>(1);
     }
 
     bool disableBattVoltageMeasure(void)
     {
-        return clrRegisterBit(XPOWERS_AXP2101_ADC_CHANNEL_CTRL, 0);
+        return set<XPowersAXP2101Field::BattVoltageAdc>(0);
     }
 
     bool enableBattDetection(void)
     {
-        return setRegisterBit(XPOWERS_AXP2101_BAT_DET_CTRL, 0);
+        return set<XPowersAXP2101Field::BattDetect>(1);
     }
 
     bool disableBattDetection(void)
     {
-        return clrRegisterBit(XPOWERS_AXP2101_BAT_DET_CTRL, 0);
+        return set<XPowersAXP2101Field::BattDetect>(0);
     }
 
     uint16_t getBattVoltage(void)
@@ -2335,6 +2221,47 @@ public:
         return readRegister(XPOWERS_AXP2101_BAT_PERCENT_DATA);
     }
 
+    /**
+     * @brief  Read status, all ADC results and IRQ status in one transfer.
+     *         The 75-byte block 0x00 .. 0x4A replaces the ~10 separate
+     *         reads the individual getters would make. The IRQ status is
+     *         latched for the is...Irq() helpers as getIrqStatus() does.
+     *         Battery percentage (0xA4) is outside the block; use
+     *         getBatteryPercent() for it.
+     * @retval false if the bus read failed (snap is left untouched).
+     */
+    bool readSnapshot(xpowers_axp2101_snapshot_t &snap)
+    {
+        uint8_t buf[XPOWERS_AXP2101_INTSTS3 - XPOWERS_AXP2101_STATUS1 + 1];
+        if (readRegister(XPOWERS_AXP2101_STATUS1, buf, sizeof(buf)) != 0) {
+            return false;
+        }
+#define SNAP_H5L8(h, l) ((uint16_t)(((buf[h] & 0x1F) << 8) | buf[l]))
+#define SNAP_H6L8(h, l) ((uint16_t)(((buf[h] & 0x3F) << 8) | buf[l]))
+        snap.status1 = buf[XPOWERS_AXP2101_STATUS1];
+        snap.status2 = buf[XPOWERS_AXP2101_STATUS2];
+        snap.battery_connected = snap.status1 & _BV(3);
+        snap.vbus_in = !(snap.status2 & _BV(3)) && (snap.status1 & _BV(5));
+        snap.charging = (snap.status2 >> 5) == 0x01;
+        snap.charger_status = (xpowers_chg_status_t)(snap.status2 & 0x07);
+        snap.batt_mv = snap.battery_connected ?
+                       SNAP_H5L8(XPOWERS_AXP2101_ADC_DATA_RELUST0, XPOWERS_AXP2101_ADC_DATA_RELUST1) : 0;
+        snap.ts_raw = SNAP_H6L8(XPOWERS_AXP2101_ADC_DATA_RELUST2, XPOWERS_AXP2101_ADC_DATA_RELUST3);
+        snap.vbus_mv = snap.vbus_in ?
+                       SNAP_H6L8(XPOWERS_AXP2101_ADC_DATA_RELUST4, XPOWERS_AXP2101_ADC_DATA_RELUST5) : 0;
+        snap.sys_mv = SNAP_H6L8(XPOWERS_AXP2101_ADC_DATA_RELUST6, XPOWERS_AXP2101_ADC_DATA_RELUST7);
+        snap.temperature = XPOWERS_AXP2101_CONVERSION(
+                               SNAP_H6L8(XPOWERS_AXP2101_ADC_DATA_RELUST8, XPOWERS_AXP2101_ADC_DATA_RELUST9));
+#undef SNAP_H5L8
+#undef SNAP_H6L8
+        for (int i = 0; i < XPOWERS_AXP2101_INTSTS_CNT; i++) {
+            statusRegister[i] = buf[XPOWERS_AXP2101_INTSTS1 + i];
+        }
+        snap.irq_status = (uint32_t)(statusRegister[0] << 16) | (uint32_t)(statusRegister[1] << 8) |
+                          (uint32_t)(statusRegister[2]);
+        return true;
+    }
+
     /*
     * CHG LED setting and control
     */
@@ -3075,6 +3002,33 @@ protected:
         return "AXP2101";
     }
 
+    /*
+     * Shadow-cacheable registers: configuration that only this driver
+     * writes. Left out are status, ADC, IRQ status, fuel-gauge data and
+     * the registers with self-clearing bits (COMMON_CONFIG soft
+     * off/restart, RESET_FUEL_GAUGE, WDT_CTRL clear, SLEEP_WAKEUP_CTRL).
+     */
+    bool isCacheableRegisterImpl(uint8_t reg) const
+    {
+        switch (reg) {
+        case XPOWERS_AXP2101_BATFET_CTRL ... XPOWERS_AXP2101_INPUT_CUR_LIMIT_CTRL:
+        case XPOWERS_AXP2101_CHARGE_GAUGE_WDT_CTRL:
+        case XPOWERS_AXP2101_LOW_BAT_WARN_SET:
+        case XPOWERS_AXP2101_PWROFF_EN ... XPOWERS_AXP2101_PWROK_SEQU_CTRL:
+        case XPOWERS_AXP2101_IRQ_OFF_ON_LEVEL_CTRL ... XPOWERS_AXP2101_FAST_PWRON_CTRL:
+        case XPOWERS_AXP2101_ADC_CHANNEL_CTRL:
+        case XPOWERS_AXP2101_INTEN1 ... XPOWERS_AXP2101_INTEN3:
+        case XPOWERS_AXP2101_TS_PIN_CTRL ... XPOWERS_AXP2101_JIETA_SET2:
+        case XPOWERS_AXP2101_IPRECHG_SET ... XPOWERS_AXP2101_BTN_BAT_CHG_VOL_SET:
+        case XPOWERS_AXP2101_DC_ONOFF_DVM_CTRL ... XPOWERS_AXP2101_DC_VOL4_CTRL:
+        case XPOWERS_AXP2101_LDO_ONOFF_CTRL0 ... XPOWERS_AXP2101_LDO_VOL8_CTRL:
+        case XPOWERS_AXP2101_FUEL_GAUGE_CTRL:
+            return true;
+        default:
+            return false;
+        }
+    }
+
 private:
     uint8_t statusRegister[XPOWERS_AXP2101_INTSTS_CNT];
     uint8_t intRegister[XPOWERS_AXP2101_INTSTS_CNT];
@@ -32,6 +32,8 @@
 #pragma once
 
 #include <stdint.h>
+#include <string.h>
+#include "XPowersField.hpp"
 
 #if defined(ARDUINO)
 #include <Wire.h>
@@ -274,16 +276,53 @@ public:
 
     int readRegister(uint8_t reg)
     {
+        if (isRegisterCached(reg)) {
+            return __shadow[reg];
+        }
         uint8_t val = 0;
-        return readRegister(reg, &val, 1) == -1 ? -1 : val;
+        if (readRegister(reg, &val, 1) == -1) {
+            return -1;
+        }
+        if (isRegisterCacheable(reg)) {
+            shadowStore(reg, val);
+        }
+        return val;
     }
 
     int writeRegister(uint8_t reg, uint8_t val)
     {
+        if (isRegisterCacheable(reg)) {
+            if (isRegisterCached(reg) && __shadow[reg] == val) {
+                return 0;
+            }
+            if (__batch_depth) {
+                shadowStore(reg, val);
+                markRegisterDirty(reg);
+                return 0;
+            }
+        }
         return writeRegister(reg, &val, 1);
     }
 
     int readRegister(uint8_t reg, uint8_t *buf, uint8_t length)
+    {
+        int ret = readRegisterBus(reg, buf, length);
+        if (ret == 0 && __cache_enabled) {
+            // A burst (e.g. a status snapshot) also refreshes any cacheable
+            // registers it covers, unless a batched write is still pending.
+            for (uint8_t i = 0; i < length && reg + i < 256; i++) {
+                uint8_t r = reg + i;
+                if (isRegisterCacheable(r) && !isRegisterDirty(r)) {
+                    shadowStore(r, buf[i]);
+                }
+            }
+        }
+        return ret;
+    }
+
+private:
+
+    int readRegisterBus(uint8_t reg, uint8_t *buf, uint8_t length)
     {
         if (thisReadRegCallback) {
             return thisReadRegCallback(__addr, reg, buf, length);
@@ -325,7 +364,164 @@ public:
         return -1;
     }
 
+public:
+
     int writeRegister(uint8_t reg, uint8_t *buf, uint8_t length)
+    {
+        int ret = writeRegisterBus(reg, buf, length);
+        if (__cache_enabled) {
+            for (uint8_t i = 0; i < length && reg + i < 256; i++) {
+                uint8_t r = reg + i;
+                __dirty[r >> 5] &= ~(1UL << (r & 31));
+                if (ret == 0 && isRegisterCacheable(r)) {
+                    shadowStore(r, buf[i]);
+                } else {
+                    __valid[r >> 5] &= ~(1UL << (r & 31));
+                }
+            }
+        }
+        return ret;
+    }
+
+    /*
+     * Register shadow cache
+     *
+     * Off by default. Once enabled, the last value read from or written to
+     * each cacheable register is remembered: readRegister(reg) and the
+     * read half of setRegisterBit()/clrRegisterBit() are answered from the
+     * shadow, and single-register writes that would not change the value
+     * are dropped. A chip opts registers in by defining
+     * isCacheableRegisterImpl(reg); status, ADC, IRQ-status and
+     * self-clearing registers must stay out. Chips that define nothing
+     * cache nothing.
+     *
+     * Between beginRegisterBatch() and endRegisterBatch(), writes to
+     * cacheable registers only update the shadow and endRegisterBatch()
+     * writes each changed register once, however many bits changed.
+     * Registers go out in the order of their last write, so a rail voltage
+     * set before its enable bit still reaches the chip first. With
+     * burst_ranges, runs of consecutive registers that were also written
+     * one after another go out as one multi-byte write; only enable it for
+     * chips that auto-increment the register address on write
+     * (AXP192/AXP202 multi-byte writes are address/data pairs instead).
+     *
+     * The cache assumes this driver is the only writer of those
+     * registers. Call invalidateRegisterCache() after anything else may
+     * have changed them (PMU reset, another bus master).
+     */
+    void enableRegisterCache(bool burst_ranges = false)
+    {
+        __cache_enabled = true;
+        __cache_burst = burst_ranges;
+    }
+
+    bool disableRegisterCache()
+    {
+        bool ok = flushRegisterCache();
+        __cache_enabled = false;
+        __batch_depth = 0;
+        invalidateRegisterCache();
+        return ok;
+    }
+
+    void invalidateRegisterCache()
+    {
+        memset(__valid, 0, sizeof(__valid));
+        memset(__dirty, 0, sizeof(__dirty));
+        __dirty_count = 0;
+    }
+
+    // Batches nest; only the outermost endRegisterBatch() writes.
+    void beginRegisterBatch()
+    {
+        if (__cache_enabled) {
+            __batch_depth++;
+        }
+    }
+
+    bool endRegisterBatch()
+    {
+        if (__batch_depth == 0 || --__batch_depth) {
+            return true;
+        }
+        return flushRegisterCache();
+    }
+
+    // Write every pending register now, in the order of each register's
+    // last write. Returns false if any write failed; those registers are
+    // dropped from the cache.
+    bool flushRegisterCache()
+    {
+        bool ok = true;
+        uint16_t count = __dirty_count;
+        __dirty_count = 0;
+        uint16_t i = 0;
+        while (i < count) {
+            uint8_t reg = __dirty_order[i];
+            if (!isRegisterDirty(reg)) {
+                i++;            // written directly since it was batched
+                continue;
+            }
+            int len = 1;
+            while (__cache_burst && i + len < count && __dirty_order[i + len] == reg + len &&
+                    isRegisterDirty(reg + len)) {
+                len++;
+            }
+            if (writeRegister(reg, &__shadow[reg], len) != 0) {
+                ok = false;
+            }
+            i += len;
+        }
+        return ok;
+    }
+
+protected:
+
+    // Chips override this to opt registers into the shadow cache.
+    bool isCacheableRegisterImpl(uint8_t reg) const
+    {
+        (void)reg;
+        return false;
+    }
+
+private:
+
+    bool isRegisterCacheable(uint8_t reg) const
+    {
+        return __cache_enabled && thisChip().isCacheableRegisterImpl(reg);
+    }
+
+    bool isRegisterCached(uint8_t reg) const
+    {
+        return isRegisterCacheable(reg) && (__valid[reg >> 5] & (1UL << (reg & 31)));
+    }
+
+    bool isRegisterDirty(int reg) const
+    {
+        return __dirty[reg >> 5] & (1UL << (reg & 31));
+    }
+
+    // Mark reg pending and move it to the end of the flush order.
+    void markRegisterDirty(uint8_t reg)
+    {
+        for (uint16_t i = 0; i < __dirty_count; i++) {
+            if (__dirty_order[i] == reg) {
+                memmove(&__dirty_order[i], &__dirty_order[i + 1], __dirty_count - i - 1);
+                __dirty_count--;
+                break;
+            }
+        }
+        __dirty_order[__dirty_count++] = reg;
+        __dirty[reg >> 5] |= 1UL << (reg & 31);
+    }
+
+    void shadowStore(uint8_t reg, uint8_t val)
+    {
+        __shadow[reg] = val;
+        __valid[reg >> 5] |= 1UL << (reg & 31);
+    }
+
+    int writeRegisterBus(uint8_t reg, uint8_t *buf, uint8_t length)
     {
         if (thisWriteRegCallback) {
             return thisWriteRegCallback(__addr, reg, buf, length);
@@ -368,9 +564,13 @@ public:
 #endif //ESP_IDF_VERSION
         free(write_buffer);
         return 0;
+#else
+        return -1;
 #endif //ESP_PLATFORM
     }
 
+public:
+
 
     bool inline clrRegisterBit(uint8_t registers, uint8_t bit)
     {
@@ -399,6 +599,68 @@ public:
         return val & _BV(bit);
     }
 
+    /*
+     * Field access (see XPowersField.hpp)
+     *
+     * get<F>() returns the scaled field value, 0 on a bus error.
+     * set<F>(value) rejects values outside F's range or off its step
+     * without touching the bus. Otherwise it is a read-modify-write, or a
+     * plain write when F owns the whole register. The write goes through
+     * writeRegister(), so the shadow cache drops it if nothing changes and
+     * a register batch coalesces it.
+     *
+     * The templates only pass &F::desc to readField()/writeField(), which
+     * are shared by every field of the chip, so each wrapper is one call
+     * rather than its own copy of the read-modify-write. Single bits go
+     * straight to setRegisterBit()/clrRegisterBit()/getRegisterBit().
+     */
+    template <class F>
+    inline __attribute__((always_inline)) uint16_t get()
+    {
+        if constexpr (F::is_bit) {
+            return getRegisterBit(F::reg, F::shift);
+        }
+        return readField(F::desc);
+    }
+
+    template <class F>
+    inline __attribute__((always_inline)) bool set(uint16_t value)
+    {
+        if constexpr (F::is_bit) {
+            if (value > 1) {
+                return false;
+            }
+            return value ? setRegisterBit(F::reg, F::shift) : clrRegisterBit(F::reg, F::shift);
+        }
+        return writeField(F::desc, value);
+    }
+
+    uint16_t readField(const XPowersFieldDesc &f)
+    {
+        int val = readRegister(f.reg);
+        if (val == -1) {
+            return 0;
+        }
+        return ((val & f.mask) >> f.shift) * f.step + f.min;
+    }
+
+    bool writeField(const XPowersFieldDesc &f, uint16_t value)
+    {
+        if (value < f.min || value > f.max || (value - f.min) % f.step) {
+            log_e("Mistake ! reg 0x%02X accepts %u..%u in steps of %u", f.reg, f.min, f.max, f.step);
+            return false;
+        }
+        uint8_t val = (((value - f.min) / f.step) << f.shift) & f.mask;
+        if (f.keep) {
+            int old = readRegister(f.reg);
+            if (old == -1) {
+                return false;
+            }
+            val |= old & f.keep;
+        }
+        return writeRegister(f.reg, val) == 0;
+    }
+
     uint16_t inline readRegisterH8L4(uint8_t highReg, uint8_t lowReg)
     {
         int h8 = readRegister(highReg);
@@ -506,4 +768,15 @@ protected:
     uint8_t     __addr                  = 0xFF;
     iic_fptr_t  thisReadRegCallback     = NULL;
     iic_fptr_t  thisWriteRegCallback    = NULL;
+
+    // Register shadow cache: one bit per register in __valid/__dirty;
+    // __dirty_order lists the dirty registers by last write.
+    bool        __cache_enabled         = false;
+    bool        __cache_burst           = false;
+    uint8_t     __batch_depth           = 0;
+    uint32_t    __valid[8]              = {0};
+    uint32_t    __dirty[8]              = {0};
+    uint8_t     __shadow[256]           = {0};
+    uint8_t     __dirty_order[256]      = {0};
+    uint16_t    __dirty_count           = 0;
 };
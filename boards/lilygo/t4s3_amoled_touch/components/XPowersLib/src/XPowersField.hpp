@@ -0,0 +1,77 @@
+/**
+ *
+ * @license MIT License (same terms as the rest of XPowersLib)
+ *
+ * @file      XPowersField.hpp
+ *
+ * Compile-time register field descriptors for XPowersCommon::get<F>() /
+ * set<F>().
+ *
+ * A field is a run of Width bits at Shift in one 8-bit register, with a
+ * linear scale: value = raw * Step + Min, accepted for Min..Max in whole
+ * steps. Keep is the mask of the register's other bits that a write must
+ * preserve. It defaults to everything outside the field; with Keep = 0 the
+ * field owns the register, and set<F>() writes it without reading it first.
+ *
+ * Everything here is constexpr. A getter or setter written as
+ * get<F>() / set<F>() reduces to the same one or two register accesses as
+ * the hand-written version, and it goes through the shadow cache and write
+ * batching like any other register access.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+// Runtime form of a field, shared by every field of a chip so that each
+// get<F>()/set<F>() call site is just a call with a pointer to F::desc.
+struct XPowersFieldDesc {
+    uint8_t  reg;
+    uint8_t  shift;
+    uint8_t  mask;
+    uint8_t  keep;
+    uint16_t step;
+    uint16_t min;
+    uint16_t max;
+};
+
+template <uint8_t Reg, uint8_t Shift, uint8_t Width,
+          uint16_t Step = 1, uint16_t Min = 0,
+          uint16_t Max = Min + ((1u << Width) - 1) * Step,
+          uint8_t Keep = (uint8_t)~(((1u << Width) - 1) << Shift)>
+struct XPowersField {
+    static_assert(Width >= 1 && Shift + Width <= 8, "field must fit in one register");
+    static_assert(Step >= 1, "step must be non-zero");
+    static_assert(Max >= Min && (Max - Min) / Step <= (1u << Width) - 1,
+                  "range does not fit in the field");
+
+    static constexpr uint8_t  reg   = Reg;
+    static constexpr uint8_t  shift = Shift;
+    static constexpr uint8_t  mask  = ((1u << Width) - 1) << Shift;
+    static constexpr uint8_t  keep  = Keep & ~mask;
+    static constexpr uint16_t step  = Step;
+    static constexpr uint16_t min   = Min;
+    static constexpr uint16_t max   = Max;
+    static constexpr bool     is_bit = Width == 1 && Step == 1 && Min == 0 && Keep == (uint8_t)~mask;
+
+    static constexpr XPowersFieldDesc desc = { reg, shift, mask, keep, step, min, max };
+
+    static constexpr bool valid(uint16_t value)
+    {
+        return value >= Min && value <= Max && (value - Min) % Step == 0;
+    }
+
+    static constexpr uint8_t encode(uint16_t value)
+    {
+        return (uint8_t)((((value - Min) / Step) << Shift) & mask);
+    }
+
+    static constexpr uint16_t decode(uint8_t regval)
+    {
+        return ((regval & mask) >> Shift) * Step + Min;
+    }
+};
+
+// One control bit; get<F>() returns 0/1.
+template <uint8_t Reg, uint8_t Bit>
+using XPowersBit = XPowersField<Reg, Bit, 1>;
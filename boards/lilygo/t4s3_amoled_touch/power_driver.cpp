@@ -15,9 +15,20 @@
 #include "i2c_driver.h"
 #include "product_pins.h"
 #include "driver/gpio.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 
 static const char *TAG = "POWER";
 
+#define PMU_EVENT_MAX_SUBSCRIBERS   4
+#define PMU_EVENT_POLL_MS           1000    // status poll when there is no IRQ line
+#define PMU_EVENT_STUCK_MS          100     // IRQ retry backoff when the line stays low
+#define PMU_EVENT_BATT_LOW_MV       3400    // SY6970 low-battery threshold
+#define PMU_EVENT_BATT_HYST_MV      100
+
+static bool s_pmu_ok = false;
+
 #if CONFIG_PMU_AXP202
 
 #include "XPowersAXP202.tpp"
@@ -56,6 +67,13 @@ bool power_driver_init(void)
 
     PMU.clearIrqStatus();
 
+    // Rail setup below is mostly single-bit changes to a handful of control
+    // registers. With the shadow cache each register is read at most once
+    // and written once when the batch ends, in the order of its last write
+    // (each voltage below is set before its rail is enabled); the status
+    // log that follows is then answered from the cache too.
+    PMU.enableRegisterCache();
+    PMU.beginRegisterBatch();
 
 #if defined(CONFIG_LILYGO_T_WATCH_S3)
     // ! ESP32S3 VDD, Don't change
@@ -126,6 +144,10 @@ bool power_driver_init(void)
     PMU.enableBattVoltageMeasure();
 #endif
 
+    if (!PMU.endRegisterBatch()) {
+        ESP_LOGW(TAG, "PMU register write failed");
+    }
+
     ESP_LOGI(TAG, "DCDC========================");
     ESP_LOGI(TAG, "DC1  : %s   Voltage:%u mV ",  PMU.isEnableDC1()  ? "+" : "-", PMU.getDC1Voltage());
     ESP_LOGI(TAG, "DC2  : %s   Voltage:%u mV ",  PMU.isEnableDC2()  ? "+" : "-", PMU.getDC2Voltage());
@@ -147,10 +169,78 @@ bool power_driver_init(void)
     ESP_LOGI(TAG, "DLDO2: %s   Voltage:%u mV",  PMU.isEnableDLDO2()  ? "+" : "-", PMU.getDLDO2Voltage());
     ESP_LOGI(TAG, "============================");
 
-
+    s_pmu_ok = true;
     return true;
 }
 
+#define PMU_EVENTS_SUPPORTED    1
+#ifdef BOARD_PMU_IRQ
+#define PMU_EVENT_IRQ_GPIO      BOARD_PMU_IRQ
+#endif
+
+static const struct {
+    uint32_t irq;
+    uint32_t event;
+} s_irq_map[] = {
+    { XPOWERS_AXP2101_VBUS_INSERT_IRQ,      PMU_EVENT_VBUS_INSERT },
+    { XPOWERS_AXP2101_VBUS_REMOVE_IRQ,      PMU_EVENT_VBUS_REMOVE },
+    { XPOWERS_AXP2101_BAT_INSERT_IRQ,       PMU_EVENT_BATT_INSERT },
+    { XPOWERS_AXP2101_BAT_REMOVE_IRQ,       PMU_EVENT_BATT_REMOVE },
+    { XPOWERS_AXP2101_BAT_CHG_START_IRQ,    PMU_EVENT_CHARGE_START },
+    { XPOWERS_AXP2101_BAT_CHG_DONE_IRQ,     PMU_EVENT_CHARGE_DONE },
+    { XPOWERS_AXP2101_WARNING_LEVEL1_IRQ,   PMU_EVENT_BATT_LOW },
+    { XPOWERS_AXP2101_WARNING_LEVEL2_IRQ,   PMU_EVENT_BATT_CRITICAL },
+    { XPOWERS_AXP2101_PKEY_SHORT_IRQ,       PMU_EVENT_PKEY_SHORT },
+    { XPOWERS_AXP2101_PKEY_LONG_IRQ,        PMU_EVENT_PKEY_LONG },
+    { XPOWERS_AXP2101_BAT_OVER_VOL_IRQ | XPOWERS_AXP2101_CHAGER_TIMER_IRQ |
+      XPOWERS_AXP2101_DIE_OVER_TEMP_IRQ | XPOWERS_AXP2101_BATFET_OVER_CURR_IRQ |
+      XPOWERS_AXP2101_LDO_OVER_CURR_IRQ,    PMU_EVENT_FAULT },
+};
+
+// Enable only the IRQ sources that map to an event.
+static bool pmu_events_arm(void)
+{
+    uint32_t irqs = 0;
+    for (size_t i = 0; i < sizeof(s_irq_map) / sizeof(s_irq_map[0]); i++) {
+        irqs |= s_irq_map[i].irq;
+    }
+    PMU.disableIRQ(XPOWERS_AXP2101_ALL_IRQ);
+    PMU.clearIrqStatus();
+    return PMU.enableIRQ(irqs);
+}
+
+// Read INTSTS1..3 in one burst and write back exactly the bits seen.
+// Unlike clearIrqStatus() (which writes 0xFF), a source that latches
+// between the read and the clear stays pending and keeps IRQ asserted.
+// *pending gets the raw status (0 if the read failed).
+static uint32_t pmu_events_collect(uint32_t *pending)
+{
+    uint8_t st[XPOWERS_AXP2101_INTSTS_CNT];
+    if (pending) {
+        *pending = 0;
+    }
+    if (PMU.readRegister(XPOWERS_AXP2101_INTSTS1, st, sizeof(st)) != 0) {
+        return 0;
+    }
+    uint32_t raw = 0;
+    for (int i = 0; i < XPOWERS_AXP2101_INTSTS_CNT; i++) {
+        if (st[i]) {
+            PMU.writeRegister(XPOWERS_AXP2101_INTSTS1 + i, st[i]);
+            raw |= (uint32_t)st[i] << (8 * i);
+        }
+    }
+    if (pending) {
+        *pending = raw;
+    }
+    uint32_t events = 0;
+    for (size_t i = 0; i < sizeof(s_irq_map) / sizeof(s_irq_map[0]); i++) {
+        if (raw & s_irq_map[i].irq) {
+            events |= s_irq_map[i].event;
+        }
+    }
+    return events;
+}
+
 #elif CONFIG_PMU_SY6970
 
 #include "PowersSY6970.tpp"
@@ -168,8 +258,84 @@ bool power_driver_init(void)
     PMU.enableADCMeasure();
     PMU.disableOTG();
 
+    s_pmu_ok = true;
+    return true;
+}
+
+// The SY6970 INT pin is not routed to a GPIO, so the event task polls the
+// status block (REG0B..REG12) in one burst and reports edges.
+#define PMU_EVENTS_SUPPORTED    1
+
+#define SY6970_STATUS_FIRST     POWERS_SY6970_REG_0BH
+#define SY6970_STATUS_LEN       (POWERS_SY6970_REG_12H - POWERS_SY6970_REG_0BH + 1)
+#define SY6970_CHG_DONE         3
+
+typedef struct {
+    bool vbus;
+    bool charging;
+    uint8_t chg_stat;
+    uint8_t fault;
+    bool batt_low;
+} sy6970_state_t;
+
+static sy6970_state_t s_sy_state;
+
+static bool sy6970_read_state(void)
+{
+    uint8_t r[SY6970_STATUS_LEN];
+    if (PMU.readRegister(SY6970_STATUS_FIRST, r, sizeof(r)) != 0) {
+        return false;
+    }
+    const uint8_t stat = r[POWERS_SY6970_REG_0BH - SY6970_STATUS_FIRST];
+    const uint8_t vbat = POWERS_SY6970_VBAT_MASK_VAL(r[POWERS_SY6970_REG_0EH - SY6970_STATUS_FIRST]);
+    const uint8_t ichg = r[POWERS_SY6970_REG_12H - SY6970_STATUS_FIRST] & 0x7F;
+    const uint16_t batt_mv = vbat ? vbat * POWERS_SY6970_VBAT_VOL_STEP + POWERS_SY6970_VBAT_BASE_VAL : 0;
+
+    s_sy_state.vbus = ((stat >> 5) & 0x07) != 0;
+    s_sy_state.chg_stat = (stat >> 3) & 0x03;
+    // CHRG_STAT alone is unreliable (see PowersSY6970::chargeStatus());
+    // only count pre/fast charge while current is actually flowing.
+    s_sy_state.charging = s_sy_state.chg_stat != 0 && s_sy_state.chg_stat != SY6970_CHG_DONE && ichg != 0;
+    // REG0C latches faults until read, so each one is seen once.
+    s_sy_state.fault = r[POWERS_SY6970_REG_0CH - SY6970_STATUS_FIRST];
+    if (batt_mv && batt_mv < PMU_EVENT_BATT_LOW_MV) {
+        s_sy_state.batt_low = true;
+    } else if (!batt_mv || batt_mv > PMU_EVENT_BATT_LOW_MV + PMU_EVENT_BATT_HYST_MV) {
+        s_sy_state.batt_low = false;
+    }
     return true;
 }
+
+static bool pmu_events_arm(void)
+{
+    return sy6970_read_state();
+}
+
+static uint32_t pmu_events_collect(uint32_t *pending)
+{
+    (void)pending;      // polled, so there is no IRQ status to report
+    const sy6970_state_t prev = s_sy_state;
+    if (!sy6970_read_state()) {
+        return 0;
+    }
+    uint32_t events = 0;
+    if (s_sy_state.vbus != prev.vbus) {
+        events |= s_sy_state.vbus ? PMU_EVENT_VBUS_INSERT : PMU_EVENT_VBUS_REMOVE;
+    }
+    if (s_sy_state.charging && !prev.charging) {
+        events |= PMU_EVENT_CHARGE_START;
+    }
+    if (s_sy_state.chg_stat == SY6970_CHG_DONE && prev.chg_stat != SY6970_CHG_DONE) {
+        events |= PMU_EVENT_CHARGE_DONE;
+    }
+    if (s_sy_state.batt_low && !prev.batt_low) {
+        events |= PMU_EVENT_BATT_LOW;
+    }
+    if (s_sy_state.fault && !prev.fault) {
+        events |= PMU_EVENT_FAULT;
+    }
+    return events;
+}
 #else
 
 bool power_driver_init(void)
@@ -195,3 +361,195 @@ bool power_driver_init(void)
     return true;
 }
 #endif
+
+/*
+ * PMU event service (chip-independent part). Each PMU branch above that
+ * supports events defines PMU_EVENTS_SUPPORTED, pmu_events_arm() and
+ * pmu_events_collect(), plus PMU_EVENT_IRQ_GPIO if an IRQ line is wired
+ * (collect then reports the raw IRQ status through its pending argument).
+ */
+
+typedef struct {
+    uint32_t mask;
+    pmu_event_cb_t cb;
+    void *ctx;
+} pmu_subscriber_t;
+
+static pmu_subscriber_t s_subs[PMU_EVENT_MAX_SUBSCRIBERS];
+static portMUX_TYPE s_subs_lock = portMUX_INITIALIZER_UNLOCKED;
+
+esp_err_t pmu_events_subscribe(uint32_t mask, pmu_event_cb_t cb, void *ctx)
+{
+    if (!cb || !(mask & PMU_EVENT_ALL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_err_t err = ESP_ERR_NO_MEM;
+    portENTER_CRITICAL(&s_subs_lock);
+    for (int i = 0; i < PMU_EVENT_MAX_SUBSCRIBERS; i++) {
+        if (!s_subs[i].cb) {
+            s_subs[i] = pmu_subscriber_t { mask, cb, ctx };
+            err = ESP_OK;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&s_subs_lock);
+    return err;
+}
+
+esp_err_t pmu_events_unsubscribe(pmu_event_cb_t cb, void *ctx)
+{
+    esp_err_t err = ESP_ERR_NOT_FOUND;
+    portENTER_CRITICAL(&s_subs_lock);
+    for (int i = 0; i < PMU_EVENT_MAX_SUBSCRIBERS; i++) {
+        if (s_subs[i].cb == cb && s_subs[i].ctx == ctx) {
+            s_subs[i] = pmu_subscriber_t {};
+            err = ESP_OK;
+        }
+    }
+    portEXIT_CRITICAL(&s_subs_lock);
+    return err;
+}
+
+#ifdef PMU_EVENTS_SUPPORTED
+
+static TaskHandle_t s_event_task = NULL;
+
+static void pmu_events_dispatch(uint32_t events, int64_t timestamp_us)
+{
+    pmu_subscriber_t subs[PMU_EVENT_MAX_SUBSCRIBERS];
+    portENTER_CRITICAL(&s_subs_lock);
+    memcpy(subs, s_subs, sizeof(subs));
+    portEXIT_CRITICAL(&s_subs_lock);
+
+    for (uint32_t bit = 1; bit & PMU_EVENT_ALL; bit <<= 1) {
+        if (!(events & bit)) {
+            continue;
+        }
+        pmu_event_t ev = { (pmu_event_type_t)bit, timestamp_us };
+        for (int i = 0; i < PMU_EVENT_MAX_SUBSCRIBERS; i++) {
+            if (subs[i].cb && (subs[i].mask & bit)) {
+                subs[i].cb(&ev, subs[i].ctx);
+            }
+        }
+    }
+}
+
+#ifdef PMU_EVENT_IRQ_GPIO
+
+static volatile int64_t s_irq_us;
+
+static void IRAM_ATTR pmu_irq_isr(void *arg)
+{
+    BaseType_t woken = pdFALSE;
+    s_irq_us = esp_timer_get_time();
+    vTaskNotifyGiveFromISR(s_event_task, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+// Sleeps until the IRQ line falls. The line is level-low while any enabled
+// status bit is set, so if it is still low after a pass (a new source
+// latched meanwhile, with no new edge) the task goes round again. A failed
+// read, or the same bits still set after clearing them, means the line is
+// stuck rather than re-asserted; the task then backs off instead of
+// spinning at its priority, and keeps retrying since no new edge will come.
+static void pmu_event_task(void *arg)
+{
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        uint32_t prev = 0;
+        while (1) {
+            int64_t t = s_irq_us;
+            uint32_t pending;
+            uint32_t events = pmu_events_collect(&pending);
+            if (events) {
+                pmu_events_dispatch(events, t);
+            }
+            if (gpio_get_level((gpio_num_t)PMU_EVENT_IRQ_GPIO) != 0) {
+                break;
+            }
+            if (pending == 0 || pending == prev) {
+                vTaskDelay(pdMS_TO_TICKS(PMU_EVENT_STUCK_MS));
+            }
+            prev = pending;
+        }
+    }
+}
+
+static esp_err_t pmu_events_start_irq(void)
+{
+    gpio_config_t irq_cfg = {};
+    irq_cfg.pin_bit_mask = 1ULL << PMU_EVENT_IRQ_GPIO;
+    irq_cfg.mode = GPIO_MODE_INPUT;
+    irq_cfg.pull_up_en = GPIO_PULLUP_ENABLE;
+    irq_cfg.intr_type = GPIO_INTR_NEGEDGE;
+    ESP_ERROR_CHECK(gpio_config(&irq_cfg));
+
+    esp_err_t err = gpio_install_isr_service(0);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+        return err;
+    }
+    err = gpio_isr_handler_add((gpio_num_t)PMU_EVENT_IRQ_GPIO, pmu_irq_isr, NULL);
+    if (err != ESP_OK) {
+        return err;
+    }
+    // Catch an IRQ that was already asserted before the edge handler existed.
+    if (gpio_get_level((gpio_num_t)PMU_EVENT_IRQ_GPIO) == 0) {
+        s_irq_us = esp_timer_get_time();
+        xTaskNotifyGive(s_event_task);
+    }
+    ESP_LOGI(TAG, "PMU events on IRQ GPIO%d", PMU_EVENT_IRQ_GPIO);
+    return ESP_OK;
+}
+
+#else
+
+static void pmu_event_task(void *arg)
+{
+    while (1) {
+        vTaskDelay(pdMS_TO_TICKS(PMU_EVENT_POLL_MS));
+        uint32_t events = pmu_events_collect(NULL);
+        if (events) {
+            pmu_events_dispatch(events, esp_timer_get_time());
+        }
+    }
+}
+
+#endif  // PMU_EVENT_IRQ_GPIO
+
+esp_err_t pmu_events_start(void)
+{
+    if (s_event_task) {
+        return ESP_OK;
+    }
+    if (!s_pmu_ok) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (!pmu_events_arm()) {
+        ESP_LOGW(TAG, "PMU event setup failed");
+        return ESP_FAIL;
+    }
+    if (xTaskCreate(pmu_event_task, "pmu_events", 3072, NULL, 4, &s_event_task) != pdPASS) {
+        return ESP_ERR_NO_MEM;
+    }
+#ifdef PMU_EVENT_IRQ_GPIO
+    esp_err_t err = pmu_events_start_irq();
+    if (err != ESP_OK) {
+        // No ISR to wake it: drop the task so a retry starts from scratch.
+        vTaskDelete(s_event_task);
+        s_event_task = NULL;
+    }
+    return err;
+#else
+    ESP_LOGI(TAG, "PMU events polled every %d ms (no IRQ line)", PMU_EVENT_POLL_MS);
+    return ESP_OK;
+#endif
+}
+
+#else
+
+esp_err_t pmu_events_start(void)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+#endif  // PMU_EVENTS_SUPPORTED
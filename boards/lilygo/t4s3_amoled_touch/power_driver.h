@@ -8,6 +8,8 @@
  */
 #pragma once
 #include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -15,6 +17,55 @@ extern "C" {
 
 bool power_driver_init(void);
 
+/*
+ * PMU event service.
+ *
+ * With an AXP2101 and BOARD_PMU_IRQ wired, the PMU's IRQ line wakes a task
+ * that reads all IRQ status registers in one burst, clears exactly the bits
+ * it saw and dispatches them, so there is no bus traffic while idle.
+ * Without an IRQ line (the T4-S3's SY6970 is not wired to a GPIO) the task
+ * polls the charger status block every PMU_EVENT_POLL_MS instead and
+ * reports changes.
+ *
+ * Usage:
+ *   static void on_pmu(const pmu_event_t *ev, void *ctx) { ... }
+ *   pmu_events_subscribe(PMU_EVENT_VBUS_INSERT | PMU_EVENT_VBUS_REMOVE, on_pmu, NULL);
+ *   pmu_events_start();
+ */
+
+typedef enum {
+    PMU_EVENT_VBUS_INSERT   = 1 << 0,
+    PMU_EVENT_VBUS_REMOVE   = 1 << 1,
+    PMU_EVENT_BATT_INSERT   = 1 << 2,   // AXP2101 only
+    PMU_EVENT_BATT_REMOVE   = 1 << 3,   // AXP2101 only
+    PMU_EVENT_CHARGE_START  = 1 << 4,
+    PMU_EVENT_CHARGE_DONE   = 1 << 5,
+    PMU_EVENT_BATT_LOW      = 1 << 6,   // AXP2101 warning level 1; SY6970 below PMU_EVENT_BATT_LOW_MV
+    PMU_EVENT_BATT_CRITICAL = 1 << 7,   // AXP2101 warning level 2
+    PMU_EVENT_PKEY_SHORT    = 1 << 8,   // AXP2101 only
+    PMU_EVENT_PKEY_LONG     = 1 << 9,   // AXP2101 only
+    PMU_EVENT_FAULT         = 1 << 10,  // charger, thermal or over-current fault
+    PMU_EVENT_ALL           = (1 << 11) - 1,
+} pmu_event_type_t;
+
+typedef struct {
+    pmu_event_type_t type;
+    int64_t timestamp_us;       // IRQ edge, or the poll that saw the change
+} pmu_event_t;
+
+// Runs on the PMU event task, one call per event; keep it short.
+typedef void (*pmu_event_cb_t)(const pmu_event_t *event, void *ctx);
+
+// Start the service (after power_driver_init()). Safe to call twice.
+// ESP_ERR_NOT_SUPPORTED on PMUs without an event source (AXP202, none).
+esp_err_t pmu_events_start(void);
+
+// Call cb for every event in mask. Up to PMU_EVENT_MAX_SUBSCRIBERS
+// callbacks; ESP_ERR_NO_MEM when full. May be called before or after
+// pmu_events_start().
+esp_err_t pmu_events_subscribe(uint32_t mask, pmu_event_cb_t cb, void *ctx);
+esp_err_t pmu_events_unsubscribe(pmu_event_cb_t cb, void *ctx);
+
 #ifdef __cplusplus
 }
 #endif
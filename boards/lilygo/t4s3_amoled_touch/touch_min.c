@@ -1,8 +1,12 @@
-// Minimal CST226 touch bring-up (no gesture handling)
+// Minimal CST226 touch driver (no gesture handling): bring-up plus
+// IRQ-driven multi-point readout feeding the board touch event ring.
 #include "touch_min.h"
 #include "product_pins.h"
 #include "i2c_driver.h"
+#include "board_interface.h"
+#include "board_touch_ring.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include "driver/gpio.h"
 #include "driver/i2c_master.h"
 #include <string.h>
@@ -11,8 +15,30 @@
 
 #define CST226_ADDR 0x5A
 
+// Report frame, read in one burst from register 0x00:
+//   [0..4]  point 0: id<<4 | state, x[11:4], y[11:4], x[3:0]<<4 | y[3:0], pressure
+//   [5]     point count (bits 6:0)
+//   [6]     0xAB when the frame is valid
+//   [7..]   points 1..4, 5 bytes each, same layout as point 0
+#define CST226_MAX_POINTS   5
+#define CST226_FRAME_LEN    (7 + 5 * (CST226_MAX_POINTS - 1))   // 27
+#define CST226_FRAME_VALID  0xAB
+
+// The CST226 reports in the panel's native portrait frame, which is the
+// 450x600 orientation board_lcd_width()/board_lcd_height() expose. Flip
+// these if a panel revision is mounted differently.
+#define TOUCH_SWAP_XY   0
+#define TOUCH_MIRROR_X  0
+#define TOUCH_MIRROR_Y  0
+
+// While a finger is down the CST226 pulses IRQ on every report. If the
+// pulses stop without an empty report, re-read once after this long.
+#define TOUCH_RELEASE_TIMEOUT_MS 100
+
 static const char *TAG = "TOUCH_MIN";
 static i2c_master_dev_handle_t s_touch_dev = NULL;
+static TaskHandle_t s_touch_task = NULL;
+static board_touch_ring_t s_touch_ring;
 
 static esp_err_t cst226_write(uint8_t reg, const uint8_t *data, size_t len)
 {
@@ -23,6 +49,117 @@ static esp_err_t cst226_write(uint8_t reg, const uint8_t *data, size_t len)
     return i2c_master_transmit(s_touch_dev, buf, len + 1, 1000);
 }
 
+// Read one report frame. Returns the number of points written to pts
+// (0 = no touch), or -1 if the frame could not be read or was invalid.
+static int cst226_read_points(board_touch_point_t *pts)
+{
+    uint8_t reg = 0x00;
+    uint8_t buf[CST226_FRAME_LEN];
+    if (i2c_master_transmit_receive(s_touch_dev, &reg, 1, buf, sizeof(buf), 50) != ESP_OK) {
+        return -1;
+    }
+    if (buf[6] != CST226_FRAME_VALID) {
+        return -1;
+    }
+
+    int count = buf[5] & 0x7F;
+    if (count == 0 || count > CST226_MAX_POINTS) {
+        // Acknowledge so the controller re-arms its report.
+        uint8_t ack = CST226_FRAME_VALID;
+        cst226_write(0x00, &ack, 1);
+        return 0;
+    }
+
+    const int lw = board_lcd_width();
+    const int lh = board_lcd_height();
+    int n = 0;
+    int idx = 0;
+    for (int i = 0; i < count; i++) {
+        const uint8_t *p = &buf[idx];
+        idx += (i == 0) ? 7 : 5;    // point 0 is followed by count + 0xAB
+        int x = (p[1] << 4) | (p[3] >> 4);
+        int y = (p[2] << 4) | (p[3] & 0x0F);
+#if TOUCH_SWAP_XY
+        int t = x; x = y; y = t;
+#endif
+#if TOUCH_MIRROR_X
+        x = lw - 1 - x;
+#endif
+#if TOUCH_MIRROR_Y
+        y = lh - 1 - y;
+#endif
+        if (x < 0 || x >= lw || y < 0 || y >= lh) {
+            continue;
+        }
+        pts[n].id = p[0] >> 4;
+        pts[n].x = x;
+        pts[n].y = y;
+        n++;
+    }
+    return n;
+}
+
+static void touch_irq_isr(void *arg)
+{
+    BaseType_t woken = pdFALSE;
+    if (s_touch_task) {
+        vTaskNotifyGiveFromISR(s_touch_task, &woken);
+    }
+    portYIELD_FROM_ISR(woken);
+}
+
+// Sleeps until the IRQ line signals a report; while touching, a missing
+// pulse triggers one re-read so a lost release cannot leave a stuck contact.
+static void touch_task(void *arg)
+{
+    bool touching = false;
+    while (1) {
+        TickType_t wait = touching ? pdMS_TO_TICKS(TOUCH_RELEASE_TIMEOUT_MS) : portMAX_DELAY;
+        ulTaskNotifyTake(pdTRUE, wait);
+
+        board_touch_point_t pts[CST226_MAX_POINTS];
+        int n = cst226_read_points(pts);
+        if (n < 0) {
+            continue;
+        }
+        board_touch_ring_report(&s_touch_ring, pts, n, esp_timer_get_time());
+        touching = n > 0;
+    }
+}
+
+static void start_touch_task(void)
+{
+    if (xTaskCreate(touch_task, "TouchCST226", 3072, NULL, 5, &s_touch_task) != pdPASS) {
+        ESP_LOGW(TAG, "Failed to start touch task");
+        return;
+    }
+#ifdef BOARD_TOUCH_IRQ
+    if (BOARD_TOUCH_IRQ != -1) {
+        esp_err_t err = gpio_install_isr_service(0);
+        if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+            ESP_LOGW(TAG, "GPIO ISR service: %s", esp_err_to_name(err));
+            return;
+        }
+        gpio_isr_handler_add(BOARD_TOUCH_IRQ, touch_irq_isr, NULL);
+    }
+#endif
+}
+
+int board_touch_read(board_touch_point_t *points, int max_points)
+{
+    return board_touch_ring_snapshot(&s_touch_ring, points, max_points);
+}
+
+int board_touch_get_events(board_touch_event_t *events, int max_events)
+{
+    int n = board_touch_ring_pop(&s_touch_ring, events, max_events);
+    if (n > 0) {
+        board_latency_mark(BOARD_LATENCY_TOUCH, events[0].timestamp_us);
+        board_latency_mark(BOARD_LATENCY_DEQUEUE, esp_timer_get_time());
+    }
+    return n;
+}
+
 bool touch_min_init(void)
 {
 #ifdef BOARD_TOUCH_RST
@@ -47,7 +184,7 @@ bool touch_min_init(void)
             .mode = GPIO_MODE_INPUT,
             .pull_up_en = GPIO_PULLUP_ENABLE,
             .pull_down_en = GPIO_PULLDOWN_DISABLE,
-            .intr_type = GPIO_INTR_DISABLE,
+            .intr_type = GPIO_INTR_NEGEDGE,
         };
         ESP_ERROR_CHECK(gpio_config(&irq_cfg));
     }
@@ -86,5 +223,6 @@ bool touch_min_init(void)
     val = 0x09;
     cst226_write(0xD1, &val, 1);
 
+    start_touch_task();
     return true;
 }
@@ -1,5 +1,7 @@
-// Minimal CST226 touch init for LilyGO T4 S3 AMOLED (no full SensorLib)
+// Minimal CST226 touch driver for LilyGO T4 S3 AMOLED (no full SensorLib)
 #pragma once
 #include <stdbool.h>
 
+// Probe the CST226 and start the IRQ-driven reader task that backs
+// board_touch_read() / board_touch_get_events(). Returns false if absent.
 bool touch_min_init(void);
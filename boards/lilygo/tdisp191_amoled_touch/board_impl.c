@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "board_interface.h"
+#include "board_touch_ring.h"
 
 #include <string.h>
 
@@ -11,6 +12,7 @@
 #include "esp_heap_caps.h"
 #include "esp_lcd_touch_cst816s.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 
@@ -38,7 +40,9 @@
 #define PIN_TOUCH_INT 21
 #define TOUCH_I2C_PORT I2C_NUM_0
 
-#define TOUCH_POLL_MS 50
+// The CST816 pulses INT on every report while a finger is down. If the
+// pulses stop without a release report, re-read once after this long.
+#define TOUCH_RELEASE_TIMEOUT_MS 100
 
 typedef struct {
     uint32_t addr;
@@ -61,6 +65,8 @@ static spi_device_handle_t s_spi = NULL;
 static bool s_lcd_ready = false;
 static esp_lcd_touch_handle_t s_touch = NULL;
 static bool s_touch_task_started = false;
+static TaskHandle_t s_touch_task = NULL;
+static board_touch_ring_t s_touch_ring;
 static uint16_t s_tx_buf[LCD_SEND_CHUNK_PIXELS];
 static uint16_t *s_fb = NULL;
 static const char *TAG = "BOARD_TDS3_AMOLED";
@@ -247,16 +253,38 @@ static void fill_screen(uint16_t color)
     }
 }
 
+// Runs in ISR context (registered through esp_lcd_touch on the INT pin).
+static void touch_int_cb(esp_lcd_touch_handle_t tp)
+{
+    (void)tp;
+    BaseType_t woken = pdFALSE;
+    if (s_touch_task) {
+        vTaskNotifyGiveFromISR(s_touch_task, &woken);
+    }
+    portYIELD_FROM_ISR(woken);
+}
+
+// Sleeps until the INT callback signals a report, so an idle panel costs no
+// CPU time or I2C traffic. While touching, a missing pulse triggers one re-read.
 static void touch_logger_task(void *arg)
 {
     bool touching = false;
     while (1) {
+        TickType_t wait = touching ? pdMS_TO_TICKS(TOUCH_RELEASE_TIMEOUT_MS) : portMAX_DELAY;
+        ulTaskNotifyTake(pdTRUE, wait);
+
         if (s_touch) {
             esp_lcd_touch_point_data_t points_data[1] = {0};
             uint8_t point_count = 0;
             esp_lcd_touch_read_data(s_touch);
             esp_err_t err = esp_lcd_touch_get_data(s_touch, points_data, &point_count, 1);
             bool pressed = (err == ESP_OK) && (point_count > 0);
+            board_touch_point_t pt = {
+                .id = 0,
+                .x = (int16_t)points_data[0].x,
+                .y = (int16_t)points_data[0].y,
+            };
+            board_touch_ring_report(&s_touch_ring, &pt, pressed ? 1 : 0, esp_timer_get_time());
             if (pressed) {
                 touching = true;
                 ESP_LOGI(TAG, "Touch (%u,%u)", (unsigned)points_data[0].x, (unsigned)points_data[0].y);
@@ -265,7 +293,6 @@ static void touch_logger_task(void *arg)
                 ESP_LOGI(TAG, "Touch released");
             }
         }
-        vTaskDelay(pdMS_TO_TICKS(TOUCH_POLL_MS));
     }
 }
 
@@ -274,7 +301,7 @@ static void start_touch_logger(void)
     if (s_touch_task_started) {
         return;
     }
-    BaseType_t ok = xTaskCreate(touch_logger_task, "TouchLoggerAmoled", 2048, NULL, 5, NULL);
+    BaseType_t ok = xTaskCreate(touch_logger_task, "TouchLoggerAmoled", 2048, NULL, 5, &s_touch_task);
     if (ok == pdPASS) {
         s_touch_task_started = true;
     } else {
@@ -310,6 +337,7 @@ static void init_touch(void)
             .mirror_x = 0,
             .mirror_y = 0,
         },
+        .interrupt_callback = touch_int_cb,
     };
     ESP_ERROR_CHECK(esp_lcd_touch_new_i2c_cst816s(tp_io, &touch_cfg, &s_touch));
     start_touch_logger();
@@ -362,14 +390,31 @@ void board_lcd_sanity_test(void)
 // (required by the RM67162 QSPI interface) is applied during flush
 // inside amoled_push_buffer().
 
+int board_touch_read(board_touch_point_t *points, int max_points)
+{
+    return board_touch_ring_snapshot(&s_touch_ring, points, max_points);
+}
+
+int board_touch_get_events(board_touch_event_t *events, int max_events)
+{
+    int n = board_touch_ring_pop(&s_touch_ring, events, max_events);
+    if (n > 0) {
+        board_latency_mark(BOARD_LATENCY_TOUCH, events[0].timestamp_us);
+        board_latency_mark(BOARD_LATENCY_DEQUEUE, esp_timer_get_time());
+    }
+    return n;
+}
+
 int board_lcd_width(void) { return LCD_H_RES; }
 int board_lcd_height(void) { return LCD_V_RES; }
 
 void board_lcd_flush(void)
 {
     if (!s_lcd_ready || !s_fb) return;
+    board_latency_mark(BOARD_LATENCY_RENDER, esp_timer_get_time());
     amoled_set_window(0, 0, LCD_H_RES - 1, LCD_V_RES - 1);
-    amoled_push_buffer(s_fb, LCD_H_RES * LCD_V_RES);
+    amoled_push_buffer(s_fb, LCD_H_RES * LCD_V_RES);   // polling, done on return
+    board_latency_mark(BOARD_LATENCY_FLUSH_DONE, esp_timer_get_time());
 }
 
 void board_lcd_clear(void)
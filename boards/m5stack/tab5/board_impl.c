@@ -5,10 +5,13 @@
 // Post-Oct-2025 hardware revision: ST7123 combined display+touch IC
 // 720x1280 MIPI-DSI 2-lane, RGB565
 //
-// Init sequence derived from M5Tab5-UserDemo (MIT, M5Stack Technology CO LTD)
+// Init sequence and touch report layout derived from M5Tab5-UserDemo
+// (MIT, M5Stack Technology CO LTD)
 // ST7123 LCD driver: Apache-2.0, Espressif Systems
 
 #include "board_interface.h"
+#include "board_touch_ring.h"
+#include "pi4ioe.h"
 
 #include <string.h>
 #include "driver/gpio.h"
@@ -21,6 +24,7 @@
 #include "esp_lcd_st7123.h"
 #include "esp_ldo_regulator.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 
@@ -34,20 +38,21 @@ static const char *TAG = "BOARD_TAB5";
 #define I2C_SCL_GPIO    32
 #define I2C_TIMEOUT_MS  50
 
+// ST7123 touch controller (same bus; reset via PI4IOE1 P5)
+#define ST7123_TP_ADDR      0x55
+#define ST7123_TP_INT_GPIO  23    // active LOW, pulses once per report
+#define ST7123_REG_REPORT   0x0014
+#define ST7123_REPORT_LEN   7     // per contact slot
+#define ST7123_VALID        0x80  // in byte 0 of a slot
+
+// While a finger is down the controller pulses INT on every report. If the
+// pulses stop without a report showing no contacts, re-read once after this.
+#define TOUCH_RELEASE_TIMEOUT_MS 100
+
 // PI4IOE5V6408 IO expander I2C addresses
 #define PI4IOE1_ADDR    0x43  // addr pin low
 #define PI4IOE2_ADDR    0x44  // addr pin high
 
-// PI4IOE register map
-#define PI4IO_REG_CHIP_RESET  0x01
-#define PI4IO_REG_IO_DIR      0x03
-#define PI4IO_REG_OUT_SET     0x05
-#define PI4IO_REG_OUT_H_IM    0x07
-#define PI4IO_REG_IN_DEF_STA  0x09
-#define PI4IO_REG_PULL_EN     0x0B
-#define PI4IO_REG_PULL_SEL    0x0D
-#define PI4IO_REG_INT_MASK    0x11
-
 // LDO channel for MIPI DSI PHY power
 #define DSI_PHY_LDO_CHAN        3
 #define DSI_PHY_LDO_VOLTAGE_MV  2500
@@ -72,6 +77,11 @@ static esp_lcd_panel_handle_t  s_panel   = NULL;
 static uint8_t                *s_fb      = NULL;  // hardware framebuffer (DPI)
 static uint8_t                *s_backbuf = NULL;  // render buffer (PSRAM)
 
+static i2c_master_bus_handle_t s_i2c_bus    = NULL;  // created in io_expander_init()
+static i2c_master_dev_handle_t s_touch_dev  = NULL;
+static TaskHandle_t            s_touch_task = NULL;
+static board_touch_ring_t      s_touch_ring;
+
 // --- ST7123 vendor init sequence (M5Stack Tab5, post-Oct-2025 hardware) ---
 static const st7123_lcd_init_cmd_t s_st7123_init[] = {
     {0x60, (uint8_t[]){0x71, 0x23, 0xa2}, 3, 0},
@@ -129,12 +139,37 @@ static const st7123_lcd_init_cmd_t s_st7123_init[] = {
     {0x35, (uint8_t[]){0x00}, 1, 100},
 };
 
-// --- PI4IOE5V6408 IO expander init ---
+// --- PI4IOE5V6408 IO expanders ---
 // Two chips: PI4IOE1 (0x43) controls LCD_RST, TP_RST, SPK_EN, EXT5V, CAM_RST
 //            PI4IOE2 (0x44) controls WLAN_PWR, USB5V, CHG_EN
-static void pi4ioe_init(void)
+// After init, gate them at runtime with pi4ioe_set_pins() (see pi4ioe.h).
+
+// PI4IOE1: P0=NC, P1=SPK_EN, P2=EXT5V_EN, P3=NC, P4=LCD_RST, P5=TP_RST, P6=CAM_RST, P7=IN
+static const pi4ioe_config_t s_pi4ioe1_cfg = {
+    .io_dir     = 0b01111111,   // P0-P6 output, P7 input
+    .out_hi_z   = 0b00000000,
+    .pull_sel   = 0b01111111,
+    .pull_en    = 0b01111111,
+    .in_def_sta = 0b00000000,
+    .int_mask   = 0b11111111,
+    // Drive EXT5V_EN(P2), LCD_RST(P4), TP_RST(P5), CAM_RST(P6) high; leave SPK_EN(P1) low
+    .out_set    = PI4IOE1_EXT5V_EN | PI4IOE1_LCD_RST | PI4IOE1_TP_RST | PI4IOE1_CAM_RST,
+};
+
+// PI4IOE2: P0=WLAN_PWR_EN, P3=USB5V_EN, P7=CHG_EN
+static const pi4ioe_config_t s_pi4ioe2_cfg = {
+    .io_dir     = 0b10111001,
+    .out_hi_z   = 0b00000110,
+    .pull_sel   = 0b10111001,
+    .pull_en    = 0b11111001,
+    .in_def_sta = 0b01000000,
+    .int_mask   = 0b10111111,   // P6 input change enabled
+    // Drive WLAN_PWR_EN(P0), USB5V_EN(P3) high
+    .out_set    = PI4IOE2_WLAN_PWR_EN | PI4IOE2_USB5V_EN,
+};
+
+static void io_expander_init(void)
 {
-    i2c_master_bus_handle_t bus;
     i2c_master_bus_config_t bus_cfg = {
         .clk_source              = I2C_CLK_SRC_DEFAULT,
         .i2c_port                = I2C_BUS_NUM,
@@ -142,62 +177,116 @@ static void pi4ioe_init(void)
         .scl_io_num              = I2C_SCL_GPIO,
         .flags.enable_internal_pullup = true,
     };
-    ESP_ERROR_CHECK(i2c_new_master_bus(&bus_cfg, &bus));
+    ESP_ERROR_CHECK(i2c_new_master_bus(&bus_cfg, &s_i2c_bus));
+
+    if (pi4ioe_init(s_i2c_bus, PI4IOE_CHIP1, PI4IOE1_ADDR, &s_pi4ioe1_cfg) != ESP_OK) {
+        ESP_LOGW(TAG, "PI4IOE1 init failed; LCD and touch resets may stay low");
+    }
+    if (pi4ioe_init(s_i2c_bus, PI4IOE_CHIP2, PI4IOE2_ADDR, &s_pi4ioe2_cfg) != ESP_OK) {
+        ESP_LOGW(TAG, "PI4IOE2 init failed");
+    }
+}
+
+// --- ST7123 touch ---
+// Contacts live in fixed slots from register 0x0014, 7 bytes each:
+//   [0] valid<<7 | x[13:8], [1] x[7:0], [2] y[15:8], [3] y[7:0],
+//   [4] area, [5] intensity, [6] reserved
+// The slot index is the contact's tracking id. Coordinates are in the
+// panel's native 720x1280 portrait frame, which is the framebuffer's.
+
+// Read all slots in one burst. Returns the number of contacts written to
+// pts, or -1 if the bus read failed.
+static int st7123_read_points(board_touch_point_t *pts)
+{
+    uint8_t reg[2] = { ST7123_REG_REPORT >> 8, ST7123_REG_REPORT & 0xFF };
+    uint8_t buf[BOARD_TOUCH_MAX_POINTS * ST7123_REPORT_LEN];
+    if (i2c_master_transmit_receive(s_touch_dev, reg, sizeof(reg), buf, sizeof(buf),
+                                    I2C_TIMEOUT_MS) != ESP_OK) {
+        return -1;
+    }
+
+    int n = 0;
+    for (int i = 0; i < BOARD_TOUCH_MAX_POINTS; i++) {
+        const uint8_t *p = &buf[i * ST7123_REPORT_LEN];
+        if (!(p[0] & ST7123_VALID)) {
+            continue;
+        }
+        int x = ((p[0] & 0x3F) << 8) | p[1];
+        int y = (p[2] << 8) | p[3];
+        if (x >= LCD_W || y >= LCD_H) {
+            continue;
+        }
+        pts[n].id = i;
+        pts[n].x = x;
+        pts[n].y = y;
+        n++;
+    }
+    return n;
+}
+
+static void IRAM_ATTR touch_int_isr(void *arg)
+{
+    BaseType_t woken = pdFALSE;
+    if (s_touch_task) {
+        vTaskNotifyGiveFromISR(s_touch_task, &woken);
+    }
+    portYIELD_FROM_ISR(woken);
+}
+
+// Sleeps until INT signals a report; while touching, a missing pulse
+// triggers one re-read so a lost release cannot leave a stuck contact.
+static void touch_task(void *arg)
+{
+    bool touching = false;
+    while (1) {
+        TickType_t wait = touching ? pdMS_TO_TICKS(TOUCH_RELEASE_TIMEOUT_MS) : portMAX_DELAY;
+        ulTaskNotifyTake(pdTRUE, wait);
+
+        board_touch_point_t pts[BOARD_TOUCH_MAX_POINTS];
+        int n = st7123_read_points(pts);
+        if (n < 0) {
+            continue;
+        }
+        board_touch_ring_report(&s_touch_ring, pts, n, esp_timer_get_time());
+        touching = n > 0;
+    }
+}
 
-    i2c_master_dev_handle_t dev1, dev2;
-    i2c_device_config_t dev_cfg1 = {
+static void touch_init(void)
+{
+    if (i2c_master_probe(s_i2c_bus, ST7123_TP_ADDR, I2C_TIMEOUT_MS) != ESP_OK) {
+        ESP_LOGW(TAG, "ST7123 touch not found at 0x%02X", ST7123_TP_ADDR);
+        return;
+    }
+    i2c_device_config_t dev_cfg = {
         .dev_addr_length = I2C_ADDR_BIT_LEN_7,
-        .device_address  = PI4IOE1_ADDR,
+        .device_address  = ST7123_TP_ADDR,
         .scl_speed_hz    = 400000,
     };
-    ESP_ERROR_CHECK(i2c_master_bus_add_device(bus, &dev_cfg1, &dev1));
-
-    uint8_t wb[2], rb[1];
-
-    // PI4IOE1: P0=NC, P1=SPK_EN, P2=EXT5V_EN, P3=NC, P4=LCD_RST, P5=TP_RST, P6=CAM_RST, P7=IN
-    wb[0] = PI4IO_REG_CHIP_RESET; wb[1] = 0xFF;
-    i2c_master_transmit(dev1, wb, 2, I2C_TIMEOUT_MS);
-    wb[0] = PI4IO_REG_CHIP_RESET;
-    i2c_master_transmit_receive(dev1, wb, 1, rb, 1, I2C_TIMEOUT_MS);
-    wb[0] = PI4IO_REG_IO_DIR; wb[1] = 0b01111111;  // P0-P6 output, P7 input
-    i2c_master_transmit(dev1, wb, 2, I2C_TIMEOUT_MS);
-    wb[0] = PI4IO_REG_OUT_H_IM; wb[1] = 0b00000000;
-    i2c_master_transmit(dev1, wb, 2, I2C_TIMEOUT_MS);
-    wb[0] = PI4IO_REG_PULL_SEL; wb[1] = 0b01111111;
-    i2c_master_transmit(dev1, wb, 2, I2C_TIMEOUT_MS);
-    wb[0] = PI4IO_REG_PULL_EN; wb[1] = 0b01111111;
-    i2c_master_transmit(dev1, wb, 2, I2C_TIMEOUT_MS);
-    // Drive EXT5V_EN(P2), LCD_RST(P4), TP_RST(P5), CAM_RST(P6) high; leave SPK_EN(P1) low
-    wb[0] = PI4IO_REG_OUT_SET; wb[1] = 0b01110100;
-    i2c_master_transmit(dev1, wb, 2, I2C_TIMEOUT_MS);
+    ESP_ERROR_CHECK(i2c_master_bus_add_device(s_i2c_bus, &dev_cfg, &s_touch_dev));
 
-    i2c_device_config_t dev_cfg2 = {
-        .dev_addr_length = I2C_ADDR_BIT_LEN_7,
-        .device_address  = PI4IOE2_ADDR,
-        .scl_speed_hz    = 400000,
+    if (xTaskCreate(touch_task, "TouchST7123", 3072, NULL, 5, &s_touch_task) != pdPASS) {
+        ESP_LOGW(TAG, "Failed to start touch task");
+        return;
+    }
+
+    gpio_config_t int_cfg = {
+        .pin_bit_mask = 1ULL << ST7123_TP_INT_GPIO,
+        .mode         = GPIO_MODE_INPUT,
+        .pull_up_en   = GPIO_PULLUP_ENABLE,
+        .pull_down_en = GPIO_PULLDOWN_DISABLE,
+        .intr_type    = GPIO_INTR_NEGEDGE,
     };
-    ESP_ERROR_CHECK(i2c_master_bus_add_device(bus, &dev_cfg2, &dev2));
-
-    // PI4IOE2: P0=WLAN_PWR_EN, P3=USB5V_EN, P7=CHG_EN
-    wb[0] = PI4IO_REG_CHIP_RESET; wb[1] = 0xFF;
-    i2c_master_transmit(dev2, wb, 2, I2C_TIMEOUT_MS);
-    wb[0] = PI4IO_REG_CHIP_RESET;
-    i2c_master_transmit_receive(dev2, wb, 1, rb, 1, I2C_TIMEOUT_MS);
-    wb[0] = PI4IO_REG_IO_DIR; wb[1] = 0b10111001;
-    i2c_master_transmit(dev2, wb, 2, I2C_TIMEOUT_MS);
-    wb[0] = PI4IO_REG_OUT_H_IM; wb[1] = 0b00000110;
-    i2c_master_transmit(dev2, wb, 2, I2C_TIMEOUT_MS);
-    wb[0] = PI4IO_REG_PULL_SEL; wb[1] = 0b10111001;
-    i2c_master_transmit(dev2, wb, 2, I2C_TIMEOUT_MS);
-    wb[0] = PI4IO_REG_PULL_EN; wb[1] = 0b11111001;
-    i2c_master_transmit(dev2, wb, 2, I2C_TIMEOUT_MS);
-    wb[0] = PI4IO_REG_IN_DEF_STA; wb[1] = 0b01000000;
-    i2c_master_transmit(dev2, wb, 2, I2C_TIMEOUT_MS);
-    wb[0] = PI4IO_REG_INT_MASK; wb[1] = 0b10111111;
-    i2c_master_transmit(dev2, wb, 2, I2C_TIMEOUT_MS);
-    // Drive WLAN_PWR_EN(P0), USB5V_EN(P3) high
-    wb[0] = PI4IO_REG_OUT_SET; wb[1] = 0b00001001;
-    i2c_master_transmit(dev2, wb, 2, I2C_TIMEOUT_MS);
+    ESP_ERROR_CHECK(gpio_config(&int_cfg));
+    esp_err_t err = gpio_install_isr_service(0);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+        ESP_LOGW(TAG, "GPIO ISR service: %s", esp_err_to_name(err));
+        return;
+    }
+    gpio_isr_handler_add(ST7123_TP_INT_GPIO, touch_int_isr, NULL);
+
+    // Pick up a contact that was already down before the ISR was armed.
+    xTaskNotifyGive(s_touch_task);
 }
 
 // --- RGB565 helpers ---
@@ -221,7 +310,7 @@ void board_init(void)
     ESP_LOGI(TAG, "%s init", BOARD_NAME);
 
     // 1. I2C + IO expander (must happen before display init to assert LCD_RST)
-    pi4ioe_init();
+    io_expander_init();
 
     // 2. LDO for MIPI DSI PHY
     esp_ldo_channel_handle_t phy_ldo = NULL;
@@ -327,6 +416,9 @@ void board_init(void)
     ledc_set_duty(LEDC_LOW_SPEED_MODE, LCD_LEDC_CHAN, LCD_LEDC_DUTY_MAX);
     ledc_update_duty(LEDC_LOW_SPEED_MODE, LCD_LEDC_CHAN);
 
+    // 10. Touch (TP_RST was released in io_expander_init, well before this)
+    touch_init();
+
     ESP_LOGI(TAG, "%s init done", BOARD_NAME);
 }
 
@@ -344,8 +436,10 @@ void board_lcd_clear(void)
 void board_lcd_flush(void)
 {
     if (!s_backbuf || !s_fb) return;
+    board_latency_mark(BOARD_LATENCY_RENDER, esp_timer_get_time());
     memcpy(s_fb, s_backbuf, FB_SIZE);
     esp_cache_msync(s_fb, FB_SIZE, ESP_CACHE_MSYNC_FLAG_DIR_C2M);
+    board_latency_mark(BOARD_LATENCY_FLUSH_DONE, esp_timer_get_time());
 }
 
 void board_lcd_fill(uint16_t color)
@@ -383,6 +477,23 @@ void board_lcd_unpack_rgb(uint16_t color, uint8_t *r, uint8_t *g, uint8_t *b)
     rgb565_to_rgb888(color, r, g, b);
 }
 
+// --- Touch API ---
+
+int board_touch_read(board_touch_point_t *points, int max_points)
+{
+    return board_touch_ring_snapshot(&s_touch_ring, points, max_points);
+}
+
+int board_touch_get_events(board_touch_event_t *events, int max_events)
+{
+    int n = board_touch_ring_pop(&s_touch_ring, events, max_events);
+    if (n > 0) {
+        board_latency_mark(BOARD_LATENCY_TOUCH, events[0].timestamp_us);
+        board_latency_mark(BOARD_LATENCY_DEQUEUE, esp_timer_get_time());
+    }
+    return n;
+}
+
 void board_lcd_sanity_test(void)
 {
     if (!s_panel) return;
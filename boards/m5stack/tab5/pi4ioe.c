@@ -0,0 +1,267 @@
+// Copyright 2026 David M. King
+// SPDX-License-Identifier: Apache-2.0
+
+#include "pi4ioe.h"
+
+#include <stdbool.h>
+
+#include "driver/gpio.h"
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+static const char *TAG = "PI4IOE";
+
+#define PI4IOE_TIMEOUT_MS   50
+#define PI4IOE_SCL_HZ       400000
+
+// Register map
+#define PI4IO_REG_CHIP_RESET  0x01
+#define PI4IO_REG_IO_DIR      0x03
+#define PI4IO_REG_OUT_SET     0x05
+#define PI4IO_REG_OUT_H_IM    0x07
+#define PI4IO_REG_IN_DEF_STA  0x09
+#define PI4IO_REG_PULL_EN     0x0B
+#define PI4IO_REG_PULL_SEL    0x0D
+#define PI4IO_REG_IN_STA      0x0F
+#define PI4IO_REG_INT_MASK    0x11
+#define PI4IO_REG_INT_STA     0x13  // clears on read
+
+// Power-on values of the registers pi4ioe_init() only writes when they differ.
+#define PI4IO_RESET_IN_DEF_STA  0x00
+#define PI4IO_RESET_INT_MASK    0xFF
+
+typedef struct {
+    i2c_master_dev_handle_t dev;
+    uint8_t out_set;        // shadows
+    uint8_t io_dir;
+    uint8_t int_mask;
+} pi4ioe_t;
+
+static pi4ioe_t          s_chips[PI4IOE_CHIP_COUNT];
+static SemaphoreHandle_t s_lock       = NULL;
+static TaskHandle_t      s_intr_task  = NULL;
+static int               s_intr_gpio  = -1;
+static pi4ioe_intr_cb_t  s_intr_cb    = NULL;
+static void             *s_intr_ctx   = NULL;
+
+static esp_err_t write_reg(pi4ioe_t *c, uint8_t reg, uint8_t val)
+{
+    uint8_t wb[2] = { reg, val };
+    return i2c_master_transmit(c->dev, wb, sizeof(wb), PI4IOE_TIMEOUT_MS);
+}
+
+static esp_err_t read_reg(pi4ioe_t *c, uint8_t reg, uint8_t *val)
+{
+    return i2c_master_transmit_receive(c->dev, &reg, 1, val, 1, PI4IOE_TIMEOUT_MS);
+}
+
+// Write reg only if it differs from the shadow; the shadow follows success.
+static esp_err_t update_reg(pi4ioe_t *c, uint8_t reg, uint8_t *shadow, uint8_t val)
+{
+    if (*shadow == val) {
+        return ESP_OK;
+    }
+    esp_err_t err = write_reg(c, reg, val);
+    if (err == ESP_OK) {
+        *shadow = val;
+    }
+    return err;
+}
+
+static pi4ioe_t *chip_get(pi4ioe_chip_t chip)
+{
+    if ((unsigned)chip >= PI4IOE_CHIP_COUNT || !s_chips[chip].dev) {
+        return NULL;
+    }
+    return &s_chips[chip];
+}
+
+esp_err_t pi4ioe_init(i2c_master_bus_handle_t bus, pi4ioe_chip_t chip, uint8_t addr,
+                      const pi4ioe_config_t *cfg)
+{
+    if (!bus || !cfg || (unsigned)chip >= PI4IOE_CHIP_COUNT) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!s_lock) {
+        s_lock = xSemaphoreCreateMutex();
+        if (!s_lock) {
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
+    pi4ioe_t *c = &s_chips[chip];
+    if (!c->dev) {
+        i2c_device_config_t dev_cfg = {
+            .dev_addr_length = I2C_ADDR_BIT_LEN_7,
+            .device_address  = addr,
+            .scl_speed_hz    = PI4IOE_SCL_HZ,
+        };
+        esp_err_t err = i2c_master_bus_add_device(bus, &dev_cfg, &c->dev);
+        if (err != ESP_OK) {
+            return err;
+        }
+    }
+
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    // Soft reset, then read the control register back to clear the reset flag.
+    uint8_t id;
+    esp_err_t err = write_reg(c, PI4IO_REG_CHIP_RESET, 0xFF);
+    if (err == ESP_OK) err = read_reg(c, PI4IO_REG_CHIP_RESET, &id);
+    if (err == ESP_OK) err = write_reg(c, PI4IO_REG_IO_DIR, cfg->io_dir);
+    if (err == ESP_OK) err = write_reg(c, PI4IO_REG_OUT_H_IM, cfg->out_hi_z);
+    if (err == ESP_OK) err = write_reg(c, PI4IO_REG_PULL_SEL, cfg->pull_sel);
+    if (err == ESP_OK) err = write_reg(c, PI4IO_REG_PULL_EN, cfg->pull_en);
+    if (err == ESP_OK && cfg->in_def_sta != PI4IO_RESET_IN_DEF_STA) {
+        err = write_reg(c, PI4IO_REG_IN_DEF_STA, cfg->in_def_sta);
+    }
+    if (err == ESP_OK && cfg->int_mask != PI4IO_RESET_INT_MASK) {
+        err = write_reg(c, PI4IO_REG_INT_MASK, cfg->int_mask);
+    }
+    if (err == ESP_OK) err = write_reg(c, PI4IO_REG_OUT_SET, cfg->out_set);
+    if (err == ESP_OK) {
+        c->io_dir   = cfg->io_dir;
+        c->out_set  = cfg->out_set;
+        c->int_mask = cfg->int_mask;
+    }
+    xSemaphoreGive(s_lock);
+
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "init 0x%02X failed: %s", addr, esp_err_to_name(err));
+    }
+    return err;
+}
+
+esp_err_t pi4ioe_set_pins(pi4ioe_chip_t chip, uint8_t mask, uint8_t value)
+{
+    pi4ioe_t *c = chip_get(chip);
+    if (!c) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    esp_err_t err = update_reg(c, PI4IO_REG_OUT_SET, &c->out_set,
+                               (c->out_set & ~mask) | (value & mask));
+    xSemaphoreGive(s_lock);
+    return err;
+}
+
+uint8_t pi4ioe_get_outputs(pi4ioe_chip_t chip)
+{
+    pi4ioe_t *c = chip_get(chip);
+    return c ? c->out_set : 0;
+}
+
+esp_err_t pi4ioe_set_direction(pi4ioe_chip_t chip, uint8_t mask, uint8_t outputs)
+{
+    pi4ioe_t *c = chip_get(chip);
+    if (!c) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    esp_err_t err = update_reg(c, PI4IO_REG_IO_DIR, &c->io_dir,
+                               (c->io_dir & ~mask) | (outputs & mask));
+    xSemaphoreGive(s_lock);
+    return err;
+}
+
+esp_err_t pi4ioe_read_inputs(pi4ioe_chip_t chip, uint8_t *levels)
+{
+    pi4ioe_t *c = chip_get(chip);
+    if (!c || !levels) {
+        return c ? ESP_ERR_INVALID_ARG : ESP_ERR_INVALID_STATE;
+    }
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    esp_err_t err = read_reg(c, PI4IO_REG_IN_STA, levels);
+    xSemaphoreGive(s_lock);
+    return err;
+}
+
+esp_err_t pi4ioe_set_int_mask(pi4ioe_chip_t chip, uint8_t enabled)
+{
+    pi4ioe_t *c = chip_get(chip);
+    if (!c) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    esp_err_t err = update_reg(c, PI4IO_REG_INT_MASK, &c->int_mask, (uint8_t)~enabled);
+    xSemaphoreGive(s_lock);
+    return err;
+}
+
+// --- Input-change interrupts ---
+
+static void IRAM_ATTR pi4ioe_isr(void *arg)
+{
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(s_intr_task, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+// Both chips share the open-drain INT line, so each wake-up checks every
+// chip with unmasked pins. Reading INT_STA releases that chip's INT; keep
+// going until the line is high again (or nothing was pending, so a line
+// held low by something else cannot spin the task).
+static void pi4ioe_intr_task(void *arg)
+{
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        bool serviced;
+        do {
+            serviced = false;
+            for (int i = 0; i < PI4IOE_CHIP_COUNT; i++) {
+                pi4ioe_t *c = &s_chips[i];
+                uint8_t changed = 0, levels = 0;
+                xSemaphoreTake(s_lock, portMAX_DELAY);
+                bool armed = c->dev && c->int_mask != 0xFF;
+                if (armed && read_reg(c, PI4IO_REG_INT_STA, &changed) == ESP_OK && changed) {
+                    read_reg(c, PI4IO_REG_IN_STA, &levels);
+                }
+                xSemaphoreGive(s_lock);
+                if (changed) {
+                    serviced = true;
+                    s_intr_cb((pi4ioe_chip_t)i, changed, levels, s_intr_ctx);
+                }
+            }
+        } while (serviced && gpio_get_level(s_intr_gpio) == 0);
+    }
+}
+
+esp_err_t pi4ioe_intr_start(int int_gpio, pi4ioe_intr_cb_t cb, void *ctx)
+{
+    if (!cb || int_gpio < 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_intr_task) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    s_intr_gpio = int_gpio;
+    s_intr_cb = cb;
+    s_intr_ctx = ctx;
+
+    if (xTaskCreate(pi4ioe_intr_task, "pi4ioe_int", 3072, NULL, 5, &s_intr_task) != pdPASS) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    gpio_config_t int_cfg = {
+        .pin_bit_mask = 1ULL << int_gpio,
+        .mode         = GPIO_MODE_INPUT,
+        .pull_up_en   = GPIO_PULLUP_ENABLE,
+        .intr_type    = GPIO_INTR_NEGEDGE,
+    };
+    ESP_ERROR_CHECK(gpio_config(&int_cfg));
+    esp_err_t err = gpio_install_isr_service(0);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+        return err;
+    }
+    err = gpio_isr_handler_add(int_gpio, pi4ioe_isr, NULL);
+    if (err != ESP_OK) {
+        return err;
+    }
+    // INT may already be asserted from before the handler was installed.
+    if (gpio_get_level(int_gpio) == 0) {
+        xTaskNotifyGive(s_intr_task);
+    }
+    return ESP_OK;
+}
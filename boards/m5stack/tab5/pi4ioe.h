@@ -0,0 +1,88 @@
+// Copyright 2026 David M. King
+// SPDX-License-Identifier: Apache-2.0
+
+// PI4IOE5V6408 8-bit I2C IO expander driver for the Tab5's two expanders.
+//
+// The driver keeps each chip's device handle and shadows its output,
+// direction and interrupt-mask registers, so changing pins is a single
+// register write (none if nothing changes) instead of a read-modify-write.
+// All calls are serialised on one mutex and may come from any task.
+//
+// Input-change interrupts: unmask pins with pi4ioe_set_int_mask() and call
+// pi4ioe_intr_start() with the GPIO the expanders' open-drain INT line is
+// wired to. A task then sleeps until INT falls and reports which pins
+// changed; there is no polling while idle.
+//
+// Usage:
+//   pi4ioe_set_pins(PI4IOE_CHIP1, PI4IOE1_SPK_EN, PI4IOE1_SPK_EN);   // speaker on
+//   pi4ioe_set_pins(PI4IOE_CHIP2, PI4IOE2_CHG_EN, 0);                // charging off
+
+#pragma once
+
+#include <stdint.h>
+#include "driver/i2c_master.h"
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    PI4IOE_CHIP1,       // 0x43
+    PI4IOE_CHIP2,       // 0x44
+    PI4IOE_CHIP_COUNT,
+} pi4ioe_chip_t;
+
+// Tab5 wiring
+#define PI4IOE1_SPK_EN      (1u << 1)
+#define PI4IOE1_EXT5V_EN    (1u << 2)
+#define PI4IOE1_LCD_RST     (1u << 4)
+#define PI4IOE1_TP_RST      (1u << 5)
+#define PI4IOE1_CAM_RST     (1u << 6)
+
+#define PI4IOE2_WLAN_PWR_EN (1u << 0)
+#define PI4IOE2_USB5V_EN    (1u << 3)
+#define PI4IOE2_CHG_EN      (1u << 7)
+
+// Register values applied by pi4ioe_init(), one bit per pin.
+typedef struct {
+    uint8_t io_dir;         // 1 = output
+    uint8_t out_set;        // output levels
+    uint8_t out_hi_z;       // 1 = output high-impedance
+    uint8_t pull_en;        // 1 = pull enabled
+    uint8_t pull_sel;       // 1 = pull-up, 0 = pull-down
+    uint8_t in_def_sta;     // input default state (interrupt polarity)
+    uint8_t int_mask;       // 0 = interrupt enabled
+} pi4ioe_config_t;
+
+// Soft-reset one expander, then apply cfg. bus must outlive the driver.
+esp_err_t pi4ioe_init(i2c_master_bus_handle_t bus, pi4ioe_chip_t chip, uint8_t addr,
+                      const pi4ioe_config_t *cfg);
+
+// Drive the output pins in mask to the matching bits of value. One
+// register write, skipped when the levels would not change.
+esp_err_t pi4ioe_set_pins(pi4ioe_chip_t chip, uint8_t mask, uint8_t value);
+
+// Output levels as last written (from the shadow, no bus access).
+uint8_t pi4ioe_get_outputs(pi4ioe_chip_t chip);
+
+// Make the pins in mask outputs where the matching bit of outputs is set,
+// inputs otherwise.
+esp_err_t pi4ioe_set_direction(pi4ioe_chip_t chip, uint8_t mask, uint8_t outputs);
+
+// Current input levels of all pins.
+esp_err_t pi4ioe_read_inputs(pi4ioe_chip_t chip, uint8_t *levels);
+
+// Enable input-change interrupts for the pins set in enabled (others masked).
+esp_err_t pi4ioe_set_int_mask(pi4ioe_chip_t chip, uint8_t enabled);
+
+// Called from the interrupt task with the pins that changed and the
+// current input levels.
+typedef void (*pi4ioe_intr_cb_t)(pi4ioe_chip_t chip, uint8_t changed, uint8_t levels, void *ctx);
+
+// Start the interrupt task on int_gpio (active LOW, shared by both chips).
+esp_err_t pi4ioe_intr_start(int int_gpio, pi4ioe_intr_cb_t cb, void *ctx);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,88 @@
+// Copyright 2026 David M. King
+// SPDX-License-Identifier: Apache-2.0
+//
+// Live mic monitor demo for waveshare/wvshr185_round
+//
+// Plays the microphone through the speaker continuously (full duplex),
+// high-passed to cut rumble and low-passed to tame feedback. Every 5
+// seconds it measures the mic-to-speaker latency with a click and logs it
+// with the pipeline stats. The LCD shows the input level in blue.
+//
+// Required features: --feature mic --feature speaker --feature audio_pipeline
+// For the lowest latency set MIC_FRAME_SAMPLES and SPEAKER_BLOCK_SAMPLES
+// to 64 in menuconfig. Keep the volume down: mic and speaker are close.
+//
+// To use: copy this file to your project's main/ alongside main.c,
+// or replace main.c with this file (rename app_main as needed).
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+
+#include "board_interface.h"
+#include "audio_pipeline.h"
+#include "speaker.h"
+#include "mic.h"
+
+static const char *TAG = "DEMO";
+
+static audio_biquad_t s_highpass, s_lowpass;
+static volatile uint16_t s_level;       // peak of the last frame
+
+// Sink: runs on the mic reader task, so only record the peak.
+static void level_sink(const int16_t *pcm, size_t n, void *ctx)
+{
+    int peak = 0;
+    for (size_t i = 0; i < n; i++) {
+        int a = pcm[i] < 0 ? -pcm[i] : pcm[i];
+        if (a > peak) peak = a;
+    }
+    s_level = (uint16_t)peak;
+}
+
+static void monitor_task(void *arg)
+{
+    ESP_ERROR_CHECK(mic_init());
+    ESP_ERROR_CHECK(speaker_init());
+
+    audio_biquad_highpass(&s_highpass, 150.0f, 0.707f);
+    audio_biquad_lowpass(&s_lowpass, 5000.0f, 0.707f);
+    ESP_ERROR_CHECK(audio_pipeline_add_stage(audio_stage_biquad, &s_highpass));
+    ESP_ERROR_CHECK(audio_pipeline_add_stage(audio_stage_biquad, &s_lowpass));
+
+    audio_pipeline_config_t cfg = {
+        .monitor = true,
+        .sink = level_sink,
+        .out_gain = SPEAKER_GAIN_UNITY / 2,
+    };
+    ESP_ERROR_CHECK(audio_pipeline_start(&cfg));
+
+    for (int frame = 1; ; frame++) {
+        uint8_t b = (uint8_t)(s_level >> 7);
+        board_lcd_fill(board_lcd_pack_rgb(0, 0, b));
+        vTaskDelay(pdMS_TO_TICKS(50));
+
+        if (frame % 100 == 0) {     // every 5 s
+            audio_latency_t lat;
+            if (audio_pipeline_measure_latency(&lat, pdMS_TO_TICKS(500)) == ESP_OK) {
+                ESP_LOGI(TAG, "Latency %lu us (round trip %lu + buffer %lu)",
+                         (unsigned long)lat.total_us, (unsigned long)lat.round_trip_us,
+                         (unsigned long)lat.buffer_us);
+            }
+            audio_pipeline_stats_t st;
+            audio_pipeline_get_stats(&st);
+            ESP_LOGI(TAG, "frames=%lu underruns=%lu overruns=%lu slowest=%lu us",
+                     (unsigned long)st.frames, (unsigned long)st.underruns,
+                     (unsigned long)st.overruns, (unsigned long)st.stage_us_max);
+        }
+    }
+}
+
+void app_main(void)
+{
+    board_init();
+    xTaskCreate(monitor_task, "monitor", 4096, NULL, 5, NULL);
+}
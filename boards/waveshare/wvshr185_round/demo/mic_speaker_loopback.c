@@ -4,10 +4,15 @@
 // Mic + Speaker loopback demo for waveshare/wvshr185_round
 //
 // Records 3 seconds of audio via the MSM261S4030H0R microphone,
-// then plays it back through the MAX98357A speaker amplifier.
+// then plays it back through the MAX98357A speaker amplifier. Without
+// PSRAM the recording is capped at 96 KB, i.e. shorter above 16 kHz.
 // LCD color indicates state: red=recording, green=playing, black=pause.
+// Playback runs on the speaker mixer, so the LCD keeps animating while it
+// plays, and a short beep is mixed over the start of the recording.
 //
 // Required features: --feature mic --feature speaker
+// If the mic and speaker sample rates differ, also add --resampler: the
+// recording is then converted to the speaker rate as it plays.
 //
 // To use: copy this file to your project's main/ alongside main.c,
 // or replace main.c with this file (rename app_main as needed).
@@ -17,6 +22,7 @@
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "esp_heap_caps.h"
 #include "esp_log.h"
 
 #include "board_interface.h"
@@ -25,35 +31,135 @@
 
 static const char *TAG = "DEMO";
 
-#define SAMPLE_RATE     16000
+#define MIC_RATE        CONFIG_MIC_SAMPLE_RATE
+#define SPEAKER_RATE    CONFIG_SPEAKER_SAMPLE_RATE
 #define RECORD_SECS     3
+#define BEEP_HZ         880
+#define BEEP_MS         150
+// Without PSRAM the recording is cut to what fits in this many samples of
+// internal RAM (3 s at 16 kHz; 1 s at 48 kHz).
+#define RECORD_MAX_INTERNAL 48000
+#define DISCARD_CHUNK   512
 
-static int16_t rec_buf[SAMPLE_RATE * RECORD_SECS];
+#if MIC_RATE != SPEAKER_RATE
+#include "resampler.h"
+
+// Converts the recording block by block on the mixer task, so no second
+// full-length buffer is needed at the speaker rate.
+#define CONVERT_IN  64
+typedef struct {
+    resampler_t rs;
+    const int16_t *pcm;
+    size_t left;                // input samples not yet converted
+    int16_t carry[RESAMPLER_OUT_MAX(CONVERT_IN, MIC_RATE, SPEAKER_RATE)];
+    size_t carry_n, carry_pos;
+} playback_t;
+
+static size_t playback_fill(int16_t *out, size_t samples, void *ctx)
+{
+    playback_t *p = ctx;
+    size_t n = 0;
+    while (n < samples) {
+        if (p->carry_pos == p->carry_n) {
+            if (p->left == 0) break;
+            size_t take = p->left < CONVERT_IN ? p->left : CONVERT_IN;
+            p->carry_n = resampler_process(&p->rs, p->pcm, take, p->carry);
+            p->carry_pos = 0;
+            p->pcm += take;
+            p->left -= take;
+            continue;
+        }
+        out[n++] = p->carry[p->carry_pos++];
+    }
+    return n;
+}
+
+static int play_recording(const int16_t *pcm, size_t n)
+{
+    static playback_t pb;
+    if (!pb.rs.coefs && !resampler_init(&pb.rs, MIC_RATE, SPEAKER_RATE, RESAMPLER_DEFAULT_TAPS)) {
+        ESP_LOGE(TAG, "No memory for the resampler");
+        return -1;
+    }
+    resampler_reset(&pb.rs);
+    pb.pcm = pcm;
+    pb.left = n;
+    pb.carry_n = pb.carry_pos = 0;
+    return speaker_play_stream(playback_fill, &pb, SPEAKER_GAIN_UNITY);
+}
+#else
+static int play_recording(const int16_t *pcm, size_t n)
+{
+    return speaker_play_clip(pcm, n, SPEAKER_GAIN_UNITY);
+}
+#endif
+
+// Square-wave beep generated block by block on the mixer task.
+typedef struct {
+    uint32_t phase;     // Q16 cycles
+    size_t left;        // samples still to play
+} beep_t;
+
+static size_t beep_fill(int16_t *out, size_t samples, void *ctx)
+{
+    beep_t *b = ctx;
+    size_t n = samples < b->left ? samples : b->left;
+    for (size_t i = 0; i < n; i++) {
+        out[i] = (b->phase & 0x8000) ? 8000 : -8000;
+        b->phase += (BEEP_HZ << 16) / SPEAKER_RATE;
+    }
+    b->left -= n;
+    return n;
+}
 
 static void loopback_task(void *arg)
 {
     ESP_ERROR_CHECK(mic_init());
     ESP_ERROR_CHECK(speaker_init());
 
-    const size_t n = sizeof(rec_buf) / sizeof(rec_buf[0]);
+    // The recording lives in PSRAM when the board has it enabled.
+    size_t n = MIC_RATE * RECORD_SECS;
+    int16_t *rec_buf = heap_caps_malloc(n * sizeof(int16_t), MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!rec_buf) {
+        if (n > RECORD_MAX_INTERNAL) n = RECORD_MAX_INTERNAL;
+        rec_buf = heap_caps_malloc(n * sizeof(int16_t), MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    }
+    if (!rec_buf) {
+        ESP_LOGE(TAG, "No memory for the recording buffer");
+        vTaskDelete(NULL);
+        return;
+    }
     // Discard buffer: absorbs residual speaker sound at start of each cycle
-    static int16_t discard[SAMPLE_RATE / 2];
+    static int16_t discard[DISCARD_CHUNK];
+    static beep_t beep;
 
     while (1) {
         board_lcd_fill(0xF800);  // red = recording
 
         // Discard first 0.5s (tail of previous playback)
         size_t dummy;
-        mic_read(discard, SAMPLE_RATE / 2, &dummy);
+        for (size_t left = MIC_RATE / 2; left > 0; left -= dummy) {
+            if (mic_read(discard, left < DISCARD_CHUNK ? left : DISCARD_CHUNK, &dummy) != ESP_OK
+                || dummy == 0) {
+                break;
+            }
+        }
 
-        ESP_LOGI(TAG, "Recording %ds...", RECORD_SECS);
+        ESP_LOGI(TAG, "Recording %u ms...", (unsigned)(n * 1000 / MIC_RATE));
         size_t got;
         mic_read(rec_buf, n, &got);
 
-        board_lcd_fill(0x07E0);  // green = playing back
         ESP_LOGI(TAG, "Playing back %u samples", (unsigned)got);
-        size_t written;
-        speaker_write(rec_buf, got, &written);
+        int voice = play_recording(rec_buf, got);
+        beep = (beep_t){ .left = SPEAKER_RATE * BEEP_MS / 1000 };
+        speaker_play_stream(beep_fill, &beep, SPEAKER_GAIN_UNITY / 2);
+
+        // green = playing back; pulse it to show the task is not blocked
+        for (int frame = 0; speaker_voice_active(voice); frame++) {
+            uint8_t g = 96 + (frame * 24) % 160;
+            board_lcd_fill(board_lcd_pack_rgb(0, g, 0));
+            vTaskDelay(pdMS_TO_TICKS(50));
+        }
 
         // Pause so speaker sound dies before mic opens again
         board_lcd_fill(0x0000);  // black = waiting
@@ -0,0 +1,104 @@
+// Copyright 2026 David M. King
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+// Full-duplex audio: the mic capture stream feeds the speaker mixer through
+// a chain of in-place processing stages, with no record/playback phases.
+// Requires the mic and speaker features (--feature mic --feature speaker
+// --feature audio_pipeline), both initialised. If their sample rates
+// differ, also add --resampler: mic frames are then converted to the
+// speaker rate, at which all stages run.
+//
+//   mic (frame cb) -> [echo canceller] -> stage 1..n -> sink (app)
+//                                                    -> monitor buffer -> speaker voice
+//   audio_pipeline_play() -----------------------------------------------^
+//
+// Stages run on the mic reader task, once per mic frame, and must not
+// block. For low latency use small frames on both streams, e.g.
+// MIC_FRAME_SAMPLES = SPEAKER_BLOCK_SAMPLES = 64 (4 ms at 16 kHz).
+//
+//   static audio_biquad_t hp;
+//   audio_biquad_highpass(&hp, 120.0f, 0.707f);
+//   audio_pipeline_add_stage(audio_stage_biquad, &hp);
+//   audio_pipeline_config_t cfg = { .monitor = true, .out_gain = SPEAKER_GAIN_UNITY };
+//   audio_pipeline_start(&cfg);
+
+typedef void (*audio_stage_fn_t)(int16_t *pcm, size_t n, void *ctx);
+typedef void (*audio_sink_t)(const int16_t *pcm, size_t n, void *ctx);
+
+typedef struct {
+    bool         monitor;       // play the processed mic signal on the speaker
+    audio_sink_t sink;          // also hand processed frames to the app (may be NULL)
+    void        *sink_ctx;
+    uint16_t     out_gain;      // speaker voice gain, Q15 (SPEAKER_GAIN_UNITY = 1.0)
+} audio_pipeline_config_t;
+
+typedef struct {
+    uint32_t round_trip_us;     // speaker hand-off -> click captured by the mic
+    uint32_t buffer_us;         // time spent in the monitor buffer
+    uint32_t total_us;          // mic-to-speaker latency for monitoring
+} audio_latency_t;
+
+typedef struct {
+    uint32_t frames;            // mic frames processed
+    uint32_t underruns;         // speaker blocks that ran out of monitor samples
+    uint32_t overruns;          // mic samples dropped because the monitor buffer was full
+    uint32_t play_dropped;      // audio_pipeline_play() samples that did not fit
+    uint32_t stage_us_max;      // slowest frame through AEC + stages
+    uint32_t aec_skipped;       // frames the canceller passed through unaligned
+    bool     aec_active;
+} audio_pipeline_stats_t;
+
+// Append a stage. Only while stopped; up to AUDIO_PIPELINE_MAX_STAGES.
+#define AUDIO_PIPELINE_MAX_STAGES 8
+esp_err_t audio_pipeline_add_stage(audio_stage_fn_t fn, void *ctx);
+
+// Start both streams. With the echo canceller enabled this first measures
+// the echo delay with a short click.
+esp_err_t audio_pipeline_start(const audio_pipeline_config_t *cfg);
+esp_err_t audio_pipeline_stop(void);
+
+// Queue far-end audio (e.g. the other side of an intercom) for the
+// speaker, mixed with the monitor signal. Never blocks; returns the number
+// of samples accepted.
+size_t audio_pipeline_play(const int16_t *pcm, size_t n);
+
+// Play a click and time its way back through the mic. Also re-aligns the
+// echo canceller, e.g. after the speaker mixer has stalled.
+esp_err_t audio_pipeline_measure_latency(audio_latency_t *out, TickType_t timeout);
+
+void audio_pipeline_get_stats(audio_pipeline_stats_t *out);
+
+// --- Built-in stages ---
+
+// ctx: uint16_t * Q15 gain (SPEAKER_GAIN_UNITY = 1.0, up to ~2.0), read per
+// frame so it can be changed while running. Saturates.
+void audio_stage_gain(int16_t *pcm, size_t n, void *ctx);
+
+// Second-order IIR filter (RBJ cookbook coefficients).
+typedef struct {
+    float b0, b1, b2, a1, a2;
+    float z1, z2;
+} audio_biquad_t;
+
+void audio_biquad_lowpass(audio_biquad_t *bq, float fc_hz, float q);
+void audio_biquad_highpass(audio_biquad_t *bq, float fc_hz, float q);
+void audio_stage_biquad(int16_t *pcm, size_t n, void *ctx);     // ctx: audio_biquad_t
+
+// Feedback delay ("echo" effect) over a caller-supplied buffer; its length
+// sets the delay (e.g. 4000 samples = 250 ms at 16 kHz).
+typedef struct {
+    int16_t *buf;               // zeroed, len samples
+    size_t   len;
+    size_t   pos;
+    uint16_t feedback;          // Q15, < SPEAKER_GAIN_UNITY
+    uint16_t mix;               // Q15 level of the delayed signal
+} audio_echo_t;
+
+void audio_stage_echo(int16_t *pcm, size_t n, void *ctx);       // ctx: audio_echo_t
@@ -2,18 +2,21 @@
 // SPDX-License-Identifier: Apache-2.0
 
 // QMI8658 6-axis IMU over I2C
-// I2C bus: SCL=IO10, SDA=IO11 (shared with RTC and IO expander)
+// I2C bus: shared system bus via i2c_bus.h (SCL=IO10, SDA=IO11)
 // I2C address: 0x6B (SA0 high) or 0x6A (SA0 low)
 
 #include "imu.h"
-#include "driver/i2c.h"
+
+#include <stdatomic.h>
+#include "i2c_bus.h"
+#include "driver/gpio.h"
 #include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 
 static const char *TAG = "IMU";
 
-#define I2C_PORT        CONFIG_IMU_I2C_PORT
-#define I2C_PIN_SCL     10
-#define I2C_PIN_SDA     11
 #define IMU_ADDR        0x6B
 
 // QMI8658 register map (subset)
@@ -22,46 +25,72 @@ static const char *TAG = "IMU";
 #define REG_CTRL2       0x03    // accel config
 #define REG_CTRL3       0x04    // gyro config
 #define REG_CTRL7       0x08    // enable sensors
+#define REG_CTRL9       0x0A    // host command
+#define REG_FIFO_WTM_TH 0x13    // watermark, samples
+#define REG_FIFO_CTRL   0x14
+#define REG_FIFO_SMPL_CNT 0x15  // FIFO level, LSB (followed by FIFO_STATUS)
+#define REG_FIFO_STATUS 0x16
+#define REG_FIFO_DATA   0x17
+#define REG_STATUSINT   0x2D
 #define REG_ACCEL_X_L   0x35
 #define REG_GYRO_X_L    0x3B
 
 #define QMI8658_WHO_AM_I 0x05
 
+// CTRL1 bits
+#define CTRL1_ADDR_AI   0x40    // auto-increment for burst reads
+#define CTRL1_INT2_EN   0x10    // drive INT2 (FIFO interrupt by default)
+
+// FIFO_CTRL: stream mode (oldest samples overwritten when full), 128 deep
+#define FIFO_CTRL_RD_MODE   0x80
+#define FIFO_CTRL_STREAM    0x0E
+
+// FIFO_STATUS bits; bits 1:0 are the FIFO level MSBs
+#define FIFO_STATUS_OVFLOW  0x20
+
+// CTRL9 host commands, acknowledged through STATUSINT.CmdDone
+#define CTRL_CMD_ACK        0x00
+#define CTRL_CMD_RST_FIFO   0x04
+#define CTRL_CMD_REQ_FIFO   0x05
+#define STATUSINT_CMD_DONE  0x80
+#define CTRL9_MAX_POLLS     100
+
+// One FIFO sample = accel xyz then gyro xyz, 16-bit each
+#define FIFO_SAMPLE_LEN     12
+#define FIFO_DEPTH          128
+
+// Sample ring between the stream task and imu_stream_read(); power of two.
+// 512 entries hold ~0.5 s at the highest ODR.
+#define RING_SIZE           512
+
+static i2c_master_dev_handle_t s_dev;
+
+static TaskHandle_t    s_stream_task;
+static volatile bool   s_stream_stop;
+static uint8_t         s_ctrl1;
+static uint8_t         s_fifo_buf[FIFO_DEPTH * FIFO_SAMPLE_LEN];
+
+static imu_sample_t    s_ring[RING_SIZE];
+static atomic_uint     s_ring_head;        // written by the stream task
+static atomic_uint     s_ring_tail;        // written by imu_stream_read()
+static atomic_uint     s_ring_dropped;
+static uint32_t        s_fifo_overflows;
+
 static esp_err_t i2c_write_reg(uint8_t reg, uint8_t val)
 {
-    uint8_t buf[2] = {reg, val};
-    return i2c_master_write_to_device(I2C_PORT, IMU_ADDR, buf, sizeof(buf), pdMS_TO_TICKS(50));
+    return i2c_bus_write_reg(s_dev, reg, val);
 }
 
 static esp_err_t i2c_read_regs(uint8_t reg, uint8_t *data, size_t len)
 {
-    return i2c_master_write_read_device(I2C_PORT, IMU_ADDR, &reg, 1, data, len, pdMS_TO_TICKS(50));
-}
-
-static esp_err_t init_i2c_bus(void)
-{
-    // Try install first. If already installed, skip param_config entirely —
-    // calling i2c_param_config resets the I2C peripheral (i2c_hal_master_init)
-    // and can corrupt in-progress bus state shared with other features.
-    esp_err_t ret = i2c_driver_install(I2C_PORT, I2C_MODE_MASTER, 0, 0, 0);
-    if (ret == ESP_FAIL || ret == ESP_ERR_INVALID_STATE) {
-        return ESP_OK;  // Already installed by another feature
-    }
-    if (ret != ESP_OK) return ret;
-    i2c_config_t cfg = {
-        .mode             = I2C_MODE_MASTER,
-        .sda_io_num       = I2C_PIN_SDA,
-        .scl_io_num       = I2C_PIN_SCL,
-        .sda_pullup_en    = GPIO_PULLUP_ENABLE,
-        .scl_pullup_en    = GPIO_PULLUP_ENABLE,
-        .master.clk_speed = 400000,
-    };
-    return i2c_param_config(I2C_PORT, &cfg);
+    return i2c_bus_read_regs(s_dev, reg, data, len);
 }
 
 esp_err_t imu_init(void)
 {
-    ESP_ERROR_CHECK(init_i2c_bus());
+    if (!s_dev) {
+        ESP_ERROR_CHECK(i2c_bus_add_device(IMU_ADDR, 400000, &s_dev));
+    }
 
     uint8_t who_am_i = 0;
     esp_err_t ret = i2c_read_regs(REG_WHO_AM_I, &who_am_i, 1);
@@ -73,21 +102,21 @@ esp_err_t imu_init(void)
         ESP_LOGW(TAG, "Unexpected WHO_AM_I: 0x%02X (expected 0x%02X)", who_am_i, QMI8658_WHO_AM_I);
     }
 
-    // Enable accel (4g, 125Hz ODR) and gyro (512dps, 125Hz ODR)
-    ESP_ERROR_CHECK(i2c_write_reg(REG_CTRL2, 0x23));  // accel 4g, 125Hz
-    ESP_ERROR_CHECK(i2c_write_reg(REG_CTRL3, 0x53));  // gyro 512dps, 125Hz
+    ESP_ERROR_CHECK(i2c_read_regs(REG_CTRL1, &s_ctrl1, 1));
+    s_ctrl1 |= CTRL1_ADDR_AI;
+    ESP_ERROR_CHECK(i2c_write_reg(REG_CTRL1, s_ctrl1));
+
+    // Enable accel (4g) and gyro (512dps) at CONFIG_IMU_ODR_CODE
+    ESP_ERROR_CHECK(i2c_write_reg(REG_CTRL2, 0x20 | CONFIG_IMU_ODR_CODE));
+    ESP_ERROR_CHECK(i2c_write_reg(REG_CTRL3, 0x50 | CONFIG_IMU_ODR_CODE));
     ESP_ERROR_CHECK(i2c_write_reg(REG_CTRL7, 0x03));  // enable accel + gyro
 
     ESP_LOGI(TAG, "QMI8658 IMU ready (WHO_AM_I=0x%02X)", who_am_i);
     return ESP_OK;
 }
 
-esp_err_t imu_read(imu_data_t *out)
+static void decode_sample(const uint8_t *raw, imu_data_t *out)
 {
-    uint8_t raw[12];
-    esp_err_t ret = i2c_read_regs(REG_ACCEL_X_L, raw, sizeof(raw));
-    if (ret != ESP_OK) return ret;
-
     int16_t ax = (int16_t)((raw[1]  << 8) | raw[0]);
     int16_t ay = (int16_t)((raw[3]  << 8) | raw[2]);
     int16_t az = (int16_t)((raw[5]  << 8) | raw[4]);
@@ -106,5 +135,220 @@ esp_err_t imu_read(imu_data_t *out)
     out->gyro_x  = gx * gyro_scale;
     out->gyro_y  = gy * gyro_scale;
     out->gyro_z  = gz * gyro_scale;
+}
+
+esp_err_t imu_read(imu_data_t *out)
+{
+    uint8_t raw[12];
+    esp_err_t ret = i2c_read_regs(REG_ACCEL_X_L, raw, sizeof(raw));
+    if (ret != ESP_OK) return ret;
+    decode_sample(raw, out);
     return ESP_OK;
 }
+
+// ---------------------------------------------------------------------------
+// FIFO streaming
+// ---------------------------------------------------------------------------
+
+// Sample period in 6-axis mode: 7174.4 Hz / 2^ODR_CODE.
+static int64_t sample_period_us(void)
+{
+    return ((int64_t)1000000 << CONFIG_IMU_ODR_CODE) * 10 / 71744;
+}
+
+// Run a CTRL9 command: issue it, wait for CmdDone, acknowledge, and wait
+// for CmdDone to clear. Caller holds the bus lock.
+static esp_err_t ctrl9_cmd(uint8_t cmd)
+{
+    esp_err_t err = i2c_write_reg(REG_CTRL9, cmd);
+    for (int phase = 0; phase < 2 && err == ESP_OK; phase++) {
+        uint8_t want = phase == 0 ? STATUSINT_CMD_DONE : 0;
+        int polls = 0;
+        uint8_t st = 0;
+        do {
+            err = i2c_read_regs(REG_STATUSINT, &st, 1);
+        } while (err == ESP_OK && (st & STATUSINT_CMD_DONE) != want && ++polls < CTRL9_MAX_POLLS);
+        if (err == ESP_OK && polls >= CTRL9_MAX_POLLS) {
+            err = ESP_ERR_TIMEOUT;
+        }
+        if (err == ESP_OK && phase == 0) {
+            err = i2c_write_reg(REG_CTRL9, CTRL_CMD_ACK);
+        }
+    }
+    return err;
+}
+
+static void ring_push(const imu_sample_t *s)
+{
+    unsigned head = atomic_load_explicit(&s_ring_head, memory_order_relaxed);
+    unsigned tail = atomic_load_explicit(&s_ring_tail, memory_order_acquire);
+    if (head - tail >= RING_SIZE) {
+        atomic_fetch_add_explicit(&s_ring_dropped, 1, memory_order_relaxed);
+        return;
+    }
+    s_ring[head % RING_SIZE] = *s;
+    atomic_store_explicit(&s_ring_head, head + 1, memory_order_release);
+}
+
+// Drain the whole FIFO in one burst read and push its samples to the ring.
+// Samples are timestamped back from now at the nominal period, the newest
+// one being the sample just taken.
+static esp_err_t fifo_drain(void)
+{
+    if (!i2c_bus_lock(portMAX_DELAY)) {
+        return ESP_ERR_TIMEOUT;
+    }
+    uint8_t lvl[2];
+    int64_t now_us = esp_timer_get_time();
+    esp_err_t err = i2c_read_regs(REG_FIFO_SMPL_CNT, lvl, sizeof(lvl));
+    size_t bytes = 0;
+    if (err == ESP_OK) {
+        if (lvl[1] & FIFO_STATUS_OVFLOW) {
+            s_fifo_overflows++;
+        }
+        bytes = 2 * ((((size_t)lvl[1] & 0x03) << 8) | lvl[0]);
+        if (bytes > sizeof(s_fifo_buf)) bytes = sizeof(s_fifo_buf);
+        bytes -= bytes % FIFO_SAMPLE_LEN;
+    }
+    if (err == ESP_OK && bytes > 0) {
+        err = ctrl9_cmd(CTRL_CMD_REQ_FIFO);
+        if (err == ESP_OK) {
+            err = i2c_read_regs(REG_FIFO_DATA, s_fifo_buf, bytes);
+        }
+        // Leave FIFO read mode so the FIFO resumes filling.
+        i2c_write_reg(REG_FIFO_CTRL, FIFO_CTRL_STREAM);
+    }
+    i2c_bus_unlock();
+    if (err != ESP_OK || bytes == 0) {
+        return err;
+    }
+
+    int n = bytes / FIFO_SAMPLE_LEN;
+    int64_t period = sample_period_us();
+    for (int i = 0; i < n; i++) {
+        imu_sample_t s = { .timestamp_us = now_us - (int64_t)(n - 1 - i) * period };
+        decode_sample(&s_fifo_buf[i * FIFO_SAMPLE_LEN], &s.data);
+        ring_push(&s);
+    }
+    return ESP_OK;
+}
+
+#if CONFIG_IMU_FIFO_INT_GPIO >= 0
+static void IRAM_ATTR fifo_isr(void *arg)
+{
+    BaseType_t woken = pdFALSE;
+    if (s_stream_task) {
+        vTaskNotifyGiveFromISR(s_stream_task, &woken);
+    }
+    portYIELD_FROM_ISR(woken);
+}
+#endif
+
+// Sleeps until the watermark interrupt (or, when polling, one watermark
+// period). With the interrupt wired the timeout is a safety net for a
+// missed edge.
+static void stream_task(void *arg)
+{
+    int64_t batch_us = CONFIG_IMU_FIFO_WATERMARK * sample_period_us();
+    TickType_t wait = pdMS_TO_TICKS(batch_us / 1000);
+    if (CONFIG_IMU_FIFO_INT_GPIO >= 0) wait *= 2;
+    if (wait == 0) wait = 1;
+
+    while (!s_stream_stop) {
+        ulTaskNotifyTake(pdTRUE, wait);
+        if (s_stream_stop) break;
+        esp_err_t err = fifo_drain();
+        if (err != ESP_OK) {
+            ESP_LOGW(TAG, "FIFO read failed: %s", esp_err_to_name(err));
+        }
+    }
+    s_stream_task = NULL;
+    vTaskDelete(NULL);
+}
+
+esp_err_t imu_stream_start(void)
+{
+    if (!s_dev) return ESP_ERR_INVALID_STATE;
+    if (s_stream_task) return ESP_OK;
+
+    if (!i2c_bus_lock(portMAX_DELAY)) return ESP_ERR_TIMEOUT;
+    esp_err_t err = i2c_write_reg(REG_FIFO_WTM_TH, CONFIG_IMU_FIFO_WATERMARK);
+    if (err == ESP_OK) err = i2c_write_reg(REG_FIFO_CTRL, FIFO_CTRL_STREAM);
+    if (err == ESP_OK) err = ctrl9_cmd(CTRL_CMD_RST_FIFO);
+    if (err == ESP_OK && CONFIG_IMU_FIFO_INT_GPIO >= 0) {
+        err = i2c_write_reg(REG_CTRL1, s_ctrl1 | CTRL1_INT2_EN);
+    }
+    i2c_bus_unlock();
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "FIFO setup failed: %s", esp_err_to_name(err));
+        return err;
+    }
+
+    s_stream_stop = false;
+    if (xTaskCreate(stream_task, "imu_stream", 3072, NULL, 6, &s_stream_task) != pdPASS) {
+        return ESP_ERR_NO_MEM;
+    }
+
+#if CONFIG_IMU_FIFO_INT_GPIO >= 0
+    {
+        gpio_config_t int_cfg = {
+            .pin_bit_mask = 1ULL << CONFIG_IMU_FIFO_INT_GPIO,
+            .mode         = GPIO_MODE_INPUT,
+            .pull_up_en   = GPIO_PULLUP_DISABLE,
+            .pull_down_en = GPIO_PULLDOWN_DISABLE,
+            .intr_type    = GPIO_INTR_POSEDGE,
+        };
+        ESP_ERROR_CHECK(gpio_config(&int_cfg));
+        err = gpio_install_isr_service(0);
+        if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+            ESP_LOGW(TAG, "GPIO ISR service: %s", esp_err_to_name(err));
+        } else {
+            gpio_isr_handler_add(CONFIG_IMU_FIFO_INT_GPIO, fifo_isr, NULL);
+        }
+    }
+#endif
+
+    ESP_LOGI(TAG, "Streaming: %lld us/sample, watermark %d, %s",
+             (long long)sample_period_us(), CONFIG_IMU_FIFO_WATERMARK,
+             CONFIG_IMU_FIFO_INT_GPIO >= 0 ? "interrupt" : "polled");
+    return ESP_OK;
+}
+
+esp_err_t imu_stream_stop(void)
+{
+    if (!s_stream_task) return ESP_OK;
+
+#if CONFIG_IMU_FIFO_INT_GPIO >= 0
+    gpio_isr_handler_remove(CONFIG_IMU_FIFO_INT_GPIO);
+#endif
+    s_stream_stop = true;
+    xTaskNotifyGive(s_stream_task);
+    while (s_stream_task) {
+        vTaskDelay(1);
+    }
+
+    if (!i2c_bus_lock(portMAX_DELAY)) return ESP_ERR_TIMEOUT;
+    esp_err_t err = i2c_write_reg(REG_FIFO_CTRL, 0x00);   // bypass
+    if (err == ESP_OK) err = i2c_write_reg(REG_CTRL1, s_ctrl1);
+    i2c_bus_unlock();
+    return err;
+}
+
+int imu_stream_read(imu_sample_t *out, int max)
+{
+    unsigned tail = atomic_load_explicit(&s_ring_tail, memory_order_relaxed);
+    unsigned head = atomic_load_explicit(&s_ring_head, memory_order_acquire);
+    int n = 0;
+    while (n < max && tail != head) {
+        out[n++] = s_ring[tail % RING_SIZE];
+        tail++;
+    }
+    atomic_store_explicit(&s_ring_tail, tail, memory_order_release);
+    return n;
+}
+
+void imu_stream_get_stats(imu_stream_stats_t *out)
+{
+    out->fifo_overflows = s_fifo_overflows;
+    out->ring_dropped = atomic_load(&s_ring_dropped);
+}
@@ -3,14 +3,49 @@
 
 #pragma once
 #include "esp_err.h"
+#include "freertos/FreeRTOS.h"
 #include <stdint.h>
 #include <stddef.h>
 
 // MSM261S4030H0R I2S digital microphone (BCK=IO15, WS=IO2, SD=IO39, EN=IO12).
-// Outputs right channel (L/R tied high). Sample rate configurable via menuconfig.
-// Returns 16-bit PCM samples converted from 32-bit I2S frames.
+// Outputs right channel (L/R tied high); only that slot is captured.
+// Sample rate, DMA data width, gain and DC removal configurable via menuconfig.
+// Returns 16-bit PCM samples.
+
+#define MIC_FRAME_SAMPLES   CONFIG_MIC_FRAME_SAMPLES
 
 esp_err_t mic_init(void);
 
 // Read PCM samples. Blocks until num_samples are available.
+// Not available while streaming.
 esp_err_t mic_read(int16_t *samples, size_t num_samples, size_t *read_count);
+
+// Digital gain, 0–36 dB (default CONFIG_MIC_GAIN_DB). Output saturates.
+esp_err_t mic_set_gain_db(int db);
+
+// --- Streaming capture ---
+// mic_stream_start() starts a reader task that converts each I2S DMA block
+// in place to MIC_FRAME_SAMPLES int16 samples as soon as it completes. The
+// frame goes to cb if one is given (on the reader task; return quickly),
+// otherwise into a single-consumer ring drained with mic_stream_read().
+//
+//   mic_stream_start(NULL, NULL);
+//   int16_t frame[MIC_FRAME_SAMPLES];
+//   while (mic_stream_read(frame, 1, portMAX_DELAY)) { ... }
+
+typedef void (*mic_stream_cb_t)(const int16_t *frame, size_t samples, void *ctx);
+
+typedef struct {
+    uint32_t frames;            // frames captured
+    uint32_t dma_overruns;      // DMA blocks lost because the reader fell behind
+    uint32_t ring_dropped;      // frames lost because the ring was full
+} mic_stream_stats_t;
+
+esp_err_t mic_stream_start(mic_stream_cb_t cb, void *ctx);
+esp_err_t mic_stream_stop(void);
+
+// Copy up to max_frames frames (MIC_FRAME_SAMPLES samples each) into out.
+// Waits up to wait ticks for the first one; returns the number copied.
+size_t mic_stream_read(int16_t *out, size_t max_frames, TickType_t wait);
+
+void mic_stream_get_stats(mic_stream_stats_t *out);
@@ -2,19 +2,25 @@
 // SPDX-License-Identifier: Apache-2.0
 
 // PCF85063 RTC over I2C
-// I2C bus: SCL=IO10, SDA=IO11 (shared with IMU and IO expander)
+// I2C bus: shared system bus via i2c_bus.h (SCL=IO10, SDA=IO11)
 // I2C address: 0x51
 // Note: this board uses a PCF85063 (NOT PCF8563) — time registers start at 0x04.
 
 #include "rtc.h"
-#include "driver/i2c.h"
+#include "i2c_bus.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <time.h>
+#include "driver/gpio.h"
+#include "esp_attr.h"
 #include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 
 static const char *TAG = "RTC";
 
-#define I2C_PORT        CONFIG_RTC_I2C_PORT
-#define I2C_PIN_SCL     10
-#define I2C_PIN_SDA     11
 #define PCF85063_ADDR   0x51
 
 // PCF85063 register map
@@ -27,56 +33,98 @@ static const char *TAG = "RTC";
 #define REG_WEEKDAY     0x08    // 0–6
 #define REG_MONTH       0x09    // BCD, mask 0x1F
 #define REG_YEAR        0x0A    // BCD 0–99
+#define REG_SEC_ALARM   0x0B    // alarm: seconds, minutes, hours, day, weekday
+#define REG_TIMER_VALUE 0x10
+#define REG_TIMER_MODE  0x11
 
 // CTRL1 bits
 #define CTRL1_CAP_SEL   0x01    // 12.5pF load capacitance
+#define CTRL1_STOP      0x20    // freeze the clock and reset the prescaler
+
+// CTRL2 bits. AF and TF are cleared by writing 0; writing 1 leaves them as is.
+#define CTRL2_AIE       0x80
+#define CTRL2_AF        0x40
+#define CTRL2_TF        0x08
+#define CTRL2_FLAGS     (CTRL2_AF | CTRL2_TF)
+
+// Alarm registers: bit7 set disables that field
+#define ALARM_DISABLE   0x80
+
+// TIMER_MODE bits
+#define TIMER_CLK_1HZ   (0x2 << 3)
+#define TIMER_CLK_1_60HZ (0x3 << 3)
+#define TIMER_TE        0x04
+#define TIMER_TIE       0x02
+
+#define SECONDS_OS      0x80
+
+// After STOP is released the first one-second increment comes
+// 507.813–507.935 ms later (datasheet), so release it this long before the
+// second we want the RTC to tick over on.
+#define STOP_RELEASE_US 507813
+
+// The seconds register is polled this often to find its edge, which bounds
+// the error of each drift measurement.
+#define EDGE_POLL_MS    10
+#define DRIFT_MIN_US    2000    // smaller offsets are left alone
+#define SAVE_CHECK_US   (EDGE_POLL_MS * 1000)   // allowed offset right after a save
 
 static uint8_t bcd2dec(uint8_t bcd) { return (bcd >> 4) * 10 + (bcd & 0x0F); }
 static uint8_t dec2bcd(uint8_t dec) { return ((dec / 10) << 4) | (dec % 10); }
 
+static i2c_master_dev_handle_t s_dev;
+static bool                    s_seeded;        // system clock follows the RTC
+static TaskHandle_t            s_sync_task;
+static volatile bool           s_saved;         // check the next offset against the save
+
+static TaskHandle_t   s_intr_task;
+static rtc_alarm_cb_t s_alarm_cb;
+static void          *s_alarm_ctx;
+static rtc_alarm_cb_t s_timer_cb;
+static void          *s_timer_ctx;
+
 static esp_err_t i2c_read_regs(uint8_t reg, uint8_t *data, size_t len)
 {
-    return i2c_master_write_read_device(I2C_PORT, PCF85063_ADDR, &reg, 1, data, len, pdMS_TO_TICKS(50));
+    return i2c_bus_read_regs(s_dev, reg, data, len);
 }
 
 static esp_err_t i2c_write_reg(uint8_t reg, uint8_t val)
 {
-    uint8_t buf[2] = {reg, val};
-    return i2c_master_write_to_device(I2C_PORT, PCF85063_ADDR, buf, sizeof(buf), pdMS_TO_TICKS(50));
+    return i2c_bus_write_reg(s_dev, reg, val);
 }
 
-static esp_err_t init_i2c_bus(void)
+// --- Calendar conversion (UTC, 2000–2099) ---
+
+static int64_t days_from_civil(int y, unsigned m, unsigned d)
 {
-    esp_err_t ret = i2c_driver_install(I2C_PORT, I2C_MODE_MASTER, 0, 0, 0);
-    if (ret == ESP_FAIL || ret == ESP_ERR_INVALID_STATE) {
-        return ESP_OK;  // Already installed by another feature
-    }
-    if (ret != ESP_OK) return ret;
-    i2c_config_t cfg = {
-        .mode             = I2C_MODE_MASTER,
-        .sda_io_num       = I2C_PIN_SDA,
-        .scl_io_num       = I2C_PIN_SCL,
-        .sda_pullup_en    = GPIO_PULLUP_ENABLE,
-        .scl_pullup_en    = GPIO_PULLUP_ENABLE,
-        .master.clk_speed = 400000,
-    };
-    return i2c_param_config(I2C_PORT, &cfg);
+    y -= m <= 2;
+    int era = y / 400;
+    unsigned yoe = (unsigned)(y - era * 400);
+    unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return (int64_t)era * 146097 + doe - 719468;
 }
 
-esp_err_t rtc_clock_init(void)
+static time_t rtc_to_epoch(const rtc_time_t *t)
 {
-    ESP_ERROR_CHECK(init_i2c_bus());
-    // Normal mode, RTC run, 12.5pF cap (matches vendor demo)
-    esp_err_t ret = i2c_write_reg(REG_CTRL1, CTRL1_CAP_SEL);
-    if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "PCF85063 init failed: %s", esp_err_to_name(ret));
-        return ret;
-    }
-    ESP_LOGI(TAG, "PCF85063 RTC ready");
-    return ESP_OK;
+    int64_t days = days_from_civil(t->year, t->month, t->day);
+    return (time_t)(days * 86400 + t->hours * 3600 + t->minutes * 60 + t->seconds);
 }
 
-esp_err_t rtc_get_time(rtc_time_t *out)
+static void epoch_to_rtc(time_t secs, rtc_time_t *out)
+{
+    struct tm tm;
+    gmtime_r(&secs, &tm);
+    out->seconds = tm.tm_sec;
+    out->minutes = tm.tm_min;
+    out->hours   = tm.tm_hour;
+    out->day     = tm.tm_mday;
+    out->month   = tm.tm_mon + 1;
+    out->year    = tm.tm_year + 1900;
+}
+
+// Time registers REG_SECONDS..REG_YEAR in one burst, so they are coherent.
+static esp_err_t read_hw(rtc_time_t *out, bool *valid)
 {
     uint8_t raw[7];
     esp_err_t ret = i2c_read_regs(REG_SECONDS, raw, sizeof(raw));
@@ -88,19 +136,382 @@ esp_err_t rtc_get_time(rtc_time_t *out)
     out->day     = bcd2dec(raw[3] & 0x3F);
     out->month   = bcd2dec(raw[5] & 0x1F);
     out->year    = 2000 + bcd2dec(raw[6]);
+    if (valid) {
+        *valid = !(raw[0] & SECONDS_OS);
+    }
     return ESP_OK;
 }
 
-esp_err_t rtc_set_time(const rtc_time_t *t)
+static esp_err_t write_hw(const rtc_time_t *t)
 {
+    int64_t days = days_from_civil(t->year, t->month, t->day);
     uint8_t buf[8];
     buf[0] = REG_SECONDS;
-    buf[1] = dec2bcd(t->seconds);
+    buf[1] = dec2bcd(t->seconds);           // also clears OS
     buf[2] = dec2bcd(t->minutes);
     buf[3] = dec2bcd(t->hours);
     buf[4] = dec2bcd(t->day);
-    buf[5] = 0x00;                          // weekday (not tracked)
+    buf[5] = (uint8_t)((days + 4) % 7);     // 1970-01-01 was a Thursday
     buf[6] = dec2bcd(t->month);
     buf[7] = dec2bcd((uint8_t)(t->year - 2000));
-    return i2c_master_write_to_device(I2C_PORT, PCF85063_ADDR, buf, sizeof(buf), pdMS_TO_TICKS(50));
+    return i2c_bus_write(s_dev, buf, sizeof(buf));
+}
+
+static int64_t system_time_us(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (int64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+}
+
+static void set_system_time_us(int64_t us)
+{
+    struct timeval tv = { .tv_sec = us / 1000000, .tv_usec = us % 1000000 };
+    settimeofday(&tv, NULL);
+}
+
+// Wait until the system clock reaches target_us: sleep most of the way,
+// then spin through the last tick.
+static void wait_until_us(int64_t target_us)
+{
+    int64_t tick_us = portTICK_PERIOD_MS * 1000;
+    int64_t left;
+    while ((left = target_us - system_time_us()) > 2 * tick_us) {
+        vTaskDelay((TickType_t)((left - tick_us) / tick_us));
+    }
+    while (system_time_us() < target_us) {
+    }
+}
+
+// --- Drift discipline ---
+
+// Measure system clock minus RTC, in microseconds. Polls the seconds
+// register until it ticks over; the RTC is then within EDGE_POLL_MS of
+// that whole second, which is far better than the 1 s register resolution.
+static esp_err_t measure_offset(int64_t *offset_us, bool *valid)
+{
+    rtc_time_t first, t;
+    esp_err_t ret = read_hw(&first, valid);
+    if (ret != ESP_OK || !*valid) return ret;
+
+    for (int i = 0; i < 1000 / EDGE_POLL_MS + 10; i++) {
+        vTaskDelay(pdMS_TO_TICKS(EDGE_POLL_MS));
+        ret = read_hw(&t, NULL);
+        int64_t sys_us = system_time_us();
+        if (ret != ESP_OK) return ret;
+        if (t.seconds != first.seconds) {
+            int64_t rtc_us = (int64_t)rtc_to_epoch(&t) * 1000000 + EDGE_POLL_MS * 500;
+            *offset_us = sys_us - rtc_us;
+            return ESP_OK;
+        }
+    }
+    return ESP_ERR_TIMEOUT;     // oscillator not running
+}
+
+static void discipline_task(void *arg)
+{
+    while (1) {
+        int64_t offset_us;
+        bool valid;
+        esp_err_t ret = measure_offset(&offset_us, &valid);
+        if (ret == ESP_OK && valid && s_saved) {
+            // Right after rtc_save_system_time() the two clocks should tick
+            // together, to within the edge polling error.
+            s_saved = false;
+            if (llabs(offset_us) > SAVE_CHECK_US) {
+                ESP_LOGW(TAG, "RTC is %+lld us off the system clock after saving",
+                         (long long)offset_us);
+            } else {
+                ESP_LOGD(TAG, "RTC saved, offset %+lld us", (long long)offset_us);
+            }
+        }
+        if (ret != ESP_OK) {
+            ESP_LOGW(TAG, "drift check failed: %s", esp_err_to_name(ret));
+        } else if (!valid) {
+            // RTC lost power; nothing to follow until the time is set.
+        } else if (llabs(offset_us) > (int64_t)CONFIG_RTC_STEP_LIMIT_MS * 1000) {
+            // Far more than drift: the app set the system clock (SNTP,
+            // settimeofday), so the RTC follows it instead.
+            ESP_LOGI(TAG, "system clock set (%+lld ms), saving to RTC", (long long)(offset_us / 1000));
+            rtc_save_system_time();
+        } else if (llabs(offset_us) > DRIFT_MIN_US) {
+            struct timeval delta = {
+                .tv_sec  = -offset_us / 1000000,
+                .tv_usec = -offset_us % 1000000,
+            };
+            adjtime(&delta, NULL);
+            ESP_LOGD(TAG, "slewing system clock by %+lld us", (long long)-offset_us);
+        }
+        // A save wakes us early to check it.
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(CONFIG_RTC_SYNC_INTERVAL_S * 1000));
+    }
+}
+
+esp_err_t rtc_clock_init(void)
+{
+    if (!s_dev) {
+        ESP_ERROR_CHECK(i2c_bus_add_device(PCF85063_ADDR, 400000, &s_dev));
+    }
+    // Normal mode, RTC run, 12.5pF cap (matches vendor demo)
+    esp_err_t ret = i2c_write_reg(REG_CTRL1, CTRL1_CAP_SEL);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "PCF85063 init failed: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    rtc_time_t t;
+    bool valid;
+    ret = read_hw(&t, &valid);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "PCF85063 read failed: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    if (valid) {
+        // The register only resolves whole seconds; start mid-second and
+        // let the discipline task pull in the rest.
+        set_system_time_us((int64_t)rtc_to_epoch(&t) * 1000000 + 500000);
+        s_seeded = true;
+        ESP_LOGI(TAG, "PCF85063 RTC ready, %04u-%02u-%02u %02u:%02u:%02u UTC",
+                 t.year, t.month, t.day, t.hours, t.minutes, t.seconds);
+    } else {
+        ESP_LOGW(TAG, "PCF85063 RTC ready, but its time is invalid (oscillator stopped)");
+    }
+
+    static bool s_task_started;
+    if (!s_task_started
+        && xTaskCreate(discipline_task, "rtc_sync", 3072, NULL, 2, &s_sync_task) == pdPASS) {
+        s_task_started = true;
+    }
+    return ESP_OK;
+}
+
+esp_err_t rtc_get_time(rtc_time_t *out)
+{
+    if (!s_seeded) {
+        return read_hw(out, NULL);
+    }
+    epoch_to_rtc(time(NULL), out);
+    return ESP_OK;
+}
+
+esp_err_t rtc_set_time(const rtc_time_t *t)
+{
+    esp_err_t ret = write_hw(t);
+    if (ret == ESP_OK) {
+        set_system_time_us((int64_t)rtc_to_epoch(t) * 1000000);
+        s_seeded = true;
+    }
+    return ret;
+}
+
+esp_err_t rtc_save_system_time(void)
+{
+    // Stop the clock with the second before tick_s loaded, then release
+    // STOP so that its first increment, to tick_s, lands on the system
+    // clock's. The bus is free while we wait; only the time registers are
+    // frozen.
+    int64_t tick_s = (system_time_us() + STOP_RELEASE_US + 20000) / 1000000 + 1;
+    rtc_time_t t;
+    epoch_to_rtc((time_t)(tick_s - 1), &t);
+
+    if (!i2c_bus_lock(portMAX_DELAY)) {
+        return ESP_ERR_TIMEOUT;
+    }
+    esp_err_t ret = i2c_write_reg(REG_CTRL1, CTRL1_CAP_SEL | CTRL1_STOP);
+    if (ret == ESP_OK) ret = write_hw(&t);
+    i2c_bus_unlock();
+
+    wait_until_us(tick_s * 1000000 - STOP_RELEASE_US);
+    esp_err_t rel = i2c_write_reg(REG_CTRL1, CTRL1_CAP_SEL);    // always restart
+    if (ret == ESP_OK) ret = rel;
+    if (ret == ESP_OK) {
+        s_seeded = true;
+        s_saved = true;
+        if (s_sync_task) xTaskNotifyGive(s_sync_task);
+    }
+    return ret;
+}
+
+// --- Alarm and timer interrupt ---
+
+// Write CTRL2, clearing the flags in clear and leaving the others set.
+static esp_err_t ctrl2_write(uint8_t ctrl2, uint8_t clear)
+{
+    return i2c_write_reg(REG_CTRL2, (ctrl2 | CTRL2_FLAGS) & ~clear);
+}
+
+static void IRAM_ATTR rtc_isr(void *arg)
+{
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(s_intr_task, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+// INT stays low until the flag that caused it is cleared. Both events are
+// one-shot, so the alarm interrupt and the timer are switched off here too.
+static void rtc_intr_task(void *arg)
+{
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        bool serviced;
+        do {
+            serviced = false;
+            rtc_alarm_cb_t alarm_cb = NULL, timer_cb = NULL;
+            void *alarm_ctx = NULL, *timer_ctx = NULL;
+            uint8_t ctrl2;
+
+            i2c_bus_lock(portMAX_DELAY);
+            uint8_t fired = 0;
+            if (i2c_read_regs(REG_CTRL2, &ctrl2, 1) == ESP_OK) {
+                fired = ctrl2 & CTRL2_FLAGS;
+            }
+            if (fired & CTRL2_TF) {
+                i2c_write_reg(REG_TIMER_MODE, 0);
+                timer_cb = s_timer_cb;
+                timer_ctx = s_timer_ctx;
+                s_timer_cb = NULL;
+            }
+            if (fired & CTRL2_AF) {
+                ctrl2 &= ~CTRL2_AIE;
+                alarm_cb = s_alarm_cb;
+                alarm_ctx = s_alarm_ctx;
+                s_alarm_cb = NULL;
+            }
+            if (fired) {
+                ctrl2_write(ctrl2, fired);
+            }
+            i2c_bus_unlock();
+
+            if (fired) {
+                serviced = true;
+                if (alarm_cb) alarm_cb(alarm_ctx);
+                if (timer_cb) timer_cb(timer_ctx);
+            }
+        } while (serviced && gpio_get_level(CONFIG_RTC_INT_GPIO) == 0);
+    }
+}
+
+static esp_err_t intr_start(void)
+{
+    if (s_intr_task) {
+        return ESP_OK;
+    }
+    if (CONFIG_RTC_INT_GPIO < 0) {
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+    if (xTaskCreate(rtc_intr_task, "rtc_int", 3072, NULL, 5, &s_intr_task) != pdPASS) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    gpio_config_t int_cfg = {
+        .pin_bit_mask = 1ULL << CONFIG_RTC_INT_GPIO,
+        .mode         = GPIO_MODE_INPUT,
+        .pull_up_en   = GPIO_PULLUP_ENABLE,
+        .intr_type    = GPIO_INTR_NEGEDGE,
+    };
+    ESP_ERROR_CHECK(gpio_config(&int_cfg));
+    esp_err_t err = gpio_install_isr_service(0);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+        return err;
+    }
+    err = gpio_isr_handler_add(CONFIG_RTC_INT_GPIO, rtc_isr, NULL);
+    if (err != ESP_OK) {
+        return err;
+    }
+    // A flag left over from before reset may already hold INT low.
+    if (gpio_get_level(CONFIG_RTC_INT_GPIO) == 0) {
+        xTaskNotifyGive(s_intr_task);
+    }
+    return ESP_OK;
+}
+
+esp_err_t rtc_set_alarm(const rtc_time_t *when, rtc_alarm_cb_t cb, void *ctx)
+{
+    if (!when || !cb) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_err_t ret = intr_start();
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    uint8_t buf[6] = {
+        REG_SEC_ALARM,
+        dec2bcd(when->seconds),
+        dec2bcd(when->minutes),
+        dec2bcd(when->hours),
+        dec2bcd(when->day),
+        ALARM_DISABLE,                      // weekday
+    };
+    uint8_t ctrl2;
+    i2c_bus_lock(portMAX_DELAY);
+    ret = i2c_read_regs(REG_CTRL2, &ctrl2, 1);
+    // Disarm and clear a stale flag before changing the match registers.
+    if (ret == ESP_OK) ret = ctrl2_write(ctrl2 & ~CTRL2_AIE, CTRL2_AF);
+    if (ret == ESP_OK) ret = i2c_bus_write(s_dev, buf, sizeof(buf));
+    if (ret == ESP_OK) {
+        s_alarm_cb = cb;
+        s_alarm_ctx = ctx;
+        ret = ctrl2_write(ctrl2 | CTRL2_AIE, CTRL2_AF);
+    }
+    i2c_bus_unlock();
+    return ret;
+}
+
+esp_err_t rtc_cancel_alarm(void)
+{
+    uint8_t ctrl2;
+    i2c_bus_lock(portMAX_DELAY);
+    esp_err_t ret = i2c_read_regs(REG_CTRL2, &ctrl2, 1);
+    if (ret == ESP_OK) ret = ctrl2_write(ctrl2 & ~CTRL2_AIE, CTRL2_AF);
+    s_alarm_cb = NULL;
+    i2c_bus_unlock();
+    return ret;
+}
+
+esp_err_t rtc_set_timer(uint32_t seconds, rtc_alarm_cb_t cb, void *ctx)
+{
+    if (!seconds || !cb) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    uint8_t mode, value;
+    if (seconds <= 255) {
+        mode = TIMER_CLK_1HZ;
+        value = (uint8_t)seconds;
+    } else if ((seconds + 59) / 60 <= 255) {
+        mode = TIMER_CLK_1_60HZ;
+        value = (uint8_t)((seconds + 59) / 60);
+    } else {
+        return ESP_ERR_INVALID_ARG;
+    }
+    esp_err_t ret = intr_start();
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    uint8_t ctrl2;
+    i2c_bus_lock(portMAX_DELAY);
+    ret = i2c_write_reg(REG_TIMER_MODE, 0);
+    if (ret == ESP_OK) ret = i2c_read_regs(REG_CTRL2, &ctrl2, 1);
+    if (ret == ESP_OK) ret = ctrl2_write(ctrl2, CTRL2_TF);
+    if (ret == ESP_OK) ret = i2c_write_reg(REG_TIMER_VALUE, value);
+    if (ret == ESP_OK) {
+        s_timer_cb = cb;
+        s_timer_ctx = ctx;
+        ret = i2c_write_reg(REG_TIMER_MODE, mode | TIMER_TE | TIMER_TIE);
+    }
+    i2c_bus_unlock();
+    return ret;
+}
+
+esp_err_t rtc_cancel_timer(void)
+{
+    uint8_t ctrl2;
+    i2c_bus_lock(portMAX_DELAY);
+    esp_err_t ret = i2c_write_reg(REG_TIMER_MODE, 0);
+    if (ret == ESP_OK) ret = i2c_read_regs(REG_CTRL2, &ctrl2, 1);
+    if (ret == ESP_OK) ret = ctrl2_write(ctrl2, CTRL2_TF);
+    s_timer_cb = NULL;
+    i2c_bus_unlock();
+    return ret;
 }
@@ -6,7 +6,16 @@
 #include <stdint.h>
 
 // PCF85063 RTC over I2C (SCL=IO10, SDA=IO11, INT=IO9).
-// Shared I2C bus with IMU — call board_init() first.
+// Shares the system I2C bus with the IMU via i2c_bus.h.
+//
+// rtc_clock_init() reads the RTC once and seeds the system clock with
+// settimeofday(), so time(), gettimeofday() and rtc_get_time() are served
+// from the system clock with no I2C traffic. A low-priority task compares
+// the two clocks every CONFIG_RTC_SYNC_INTERVAL_S and slews the system
+// clock back onto the RTC with adjtime(). The RTC holds UTC.
+//
+// Alarm and countdown timer: the PCF85063 pulls INT low when either fires;
+// a task sleeps on that edge and runs the callback. Both are one-shot.
 
 typedef struct {
     uint8_t seconds;    // 0–59
@@ -18,5 +27,25 @@ typedef struct {
 } rtc_time_t;
 
 esp_err_t rtc_clock_init(void);
+
+// Current UTC time. From the system clock once it has been seeded,
+// otherwise read from the RTC.
 esp_err_t rtc_get_time(rtc_time_t *out);
+
+// Set the RTC and the system clock together.
 esp_err_t rtc_set_time(const rtc_time_t *t);
+
+// Write the system clock to the RTC, e.g. after an SNTP sync.
+esp_err_t rtc_save_system_time(void);
+
+typedef void (*rtc_alarm_cb_t)(void *ctx);
+
+// Fire cb when the RTC's day, hours, minutes and seconds match when
+// (month and year are ignored). Replaces any pending alarm.
+esp_err_t rtc_set_alarm(const rtc_time_t *when, rtc_alarm_cb_t cb, void *ctx);
+esp_err_t rtc_cancel_alarm(void);
+
+// Fire cb after seconds (1 s resolution up to 255 s, then whole minutes
+// up to 255 min). Replaces any running timer.
+esp_err_t rtc_set_timer(uint32_t seconds, rtc_alarm_cb_t cb, void *ctx);
+esp_err_t rtc_cancel_timer(void);
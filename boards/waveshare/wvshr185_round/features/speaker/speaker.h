@@ -3,13 +3,40 @@
 
 #pragma once
 #include "esp_err.h"
+#include <stdbool.h>
 #include <stdint.h>
 #include <stddef.h>
 
 // I2S speaker output (LRCK=IO38, DIN=IO47, BCK=IO48).
 // Sample rate and bits configurable via menuconfig.
+//
+// A playback task mixes up to CONFIG_SPEAKER_VOICES voices into the I2S
+// DMA buffers, one block at a time. Each voice is a clip (a PCM buffer) or
+// a stream (a callback that fills each block) with its own Q15 gain; the
+// mix saturates instead of wrapping. Starting, stopping and re-gaining a
+// voice never blocks, so the caller (e.g. a UI loop) keeps running while
+// audio plays.
+//
+//   int v = speaker_play_clip(pcm, n, SPEAKER_GAIN_UNITY);
+//   while (speaker_voice_active(v)) { ...update the LCD... }
+
+#define SPEAKER_GAIN_UNITY  32768   // Q15 1.0; up to 65535 (~2.0)
+
+// Fill out with up to samples mono samples; returning fewer ends the voice.
+// Runs on the playback task, so it must not block.
+typedef size_t (*speaker_stream_cb_t)(int16_t *out, size_t samples, void *ctx);
 
 esp_err_t speaker_init(void);
 
-// Write PCM samples. Blocks until written.
+// Write PCM samples. Blocks until written. Mixes with any playing voices.
 esp_err_t speaker_write(const int16_t *samples, size_t num_samples, size_t *written);
+
+// Start a voice. Returns a voice handle, or -1 if every voice is busy.
+// A clip's pcm buffer must stay valid until the voice ends.
+int speaker_play_clip(const int16_t *pcm, size_t samples, uint16_t gain);
+int speaker_play_stream(speaker_stream_cb_t cb, void *ctx, uint16_t gain);
+
+// Handles of voices that have ended are stale and safely ignored.
+esp_err_t speaker_set_gain(int voice, uint16_t gain);
+esp_err_t speaker_stop(int voice);
+bool speaker_voice_active(int voice);
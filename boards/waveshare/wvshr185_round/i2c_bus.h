@@ -0,0 +1,75 @@
+// Copyright 2026 David M. King
+// SPDX-License-Identifier: Apache-2.0
+
+// Shared I2C bus service for the board's system bus
+// (I2C_NUM_0, SCL=IO10, SDA=IO11: QMI8658 IMU, PCF85063 RTC, TCA9554 expander).
+//
+// The service owns the i2c_master bus handle and hands out device handles,
+// so features never install or reconfigure the bus themselves. All access
+// goes through one recursive lock; hold it with i2c_bus_lock() around a
+// multi-transfer sequence that must not be interleaved.
+//
+// Transfers can also be queued with i2c_bus_submit(): a worker task runs
+// them in order and calls the completion callback from its own context, so
+// the caller never blocks on the bus.
+//
+// Usage:
+//   i2c_master_dev_handle_t dev;
+//   ESP_ERROR_CHECK(i2c_bus_add_device(0x6B, 400000, &dev));
+//   uint8_t who;
+//   i2c_bus_read_regs(dev, 0x00, &who, 1);
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "driver/i2c_master.h"
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define I2C_BUS_MAX_TX  16      // inline write payload of a queued transfer
+
+// Create the bus and the async worker. Safe to call from every feature's
+// init; only the first call does the work.
+esp_err_t i2c_bus_init(void);
+
+// Register a 7-bit device on the bus (calls i2c_bus_init() if needed).
+esp_err_t i2c_bus_add_device(uint8_t addr, uint32_t scl_hz, i2c_master_dev_handle_t *out);
+
+// Hold the bus across several transfers. Recursive, so the helpers below
+// may be called while holding it. Returns false on timeout.
+bool i2c_bus_lock(TickType_t wait);
+void i2c_bus_unlock(void);
+
+// Blocking transfers, each serialised on the bus lock.
+esp_err_t i2c_bus_write(i2c_master_dev_handle_t dev, const uint8_t *data, size_t len);
+esp_err_t i2c_bus_write_reg(i2c_master_dev_handle_t dev, uint8_t reg, uint8_t val);
+esp_err_t i2c_bus_read_regs(i2c_master_dev_handle_t dev, uint8_t reg, uint8_t *data, size_t len);
+
+typedef void (*i2c_bus_done_cb_t)(esp_err_t err, void *ctx);
+
+// A queued transfer: write tx[0..tx_len), then, if rx_len > 0, read rx_len
+// bytes into rx with a repeated start. tx is copied when submitted; rx must
+// stay valid until the callback runs.
+typedef struct {
+    i2c_master_dev_handle_t dev;
+    uint8_t tx[I2C_BUS_MAX_TX];
+    size_t tx_len;
+    uint8_t *rx;
+    size_t rx_len;
+    i2c_bus_done_cb_t cb;       // may be NULL
+    void *ctx;
+} i2c_bus_xfer_t;
+
+// Queue a transfer for the worker task. Returns ESP_ERR_TIMEOUT if the
+// queue stayed full for wait ticks.
+esp_err_t i2c_bus_submit(const i2c_bus_xfer_t *xfer, TickType_t wait);
+
+#ifdef __cplusplus
+}
+#endif
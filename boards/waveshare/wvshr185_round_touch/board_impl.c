@@ -2,10 +2,11 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "board_interface.h"
+#include "board_touch_ring.h"
 
 #include <string.h>
 #include "driver/gpio.h"
-#include "driver/i2c.h"
+#include "driver/i2c_master.h"
 #include "driver/spi_master.h"
 #include "esp_err.h"
 #include "esp_heap_caps.h"
@@ -14,6 +15,7 @@
 #include "esp_lcd_panel_vendor.h"
 #include "esp_lcd_st77916.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
@@ -37,10 +39,14 @@
 #define PIN_TOUCH_SCL 3
 #define PIN_TOUCH_INT 4
 
-#define TOUCH_I2C_PORT I2C_NUM_1
+#define TOUCH_I2C_PORT 1   // own bus; port 0 is the i2c_bus.h system bus
 #define CST816_ADDR 0x15
 #define CST816_DATA_REG 0x02
 
+// While a finger is down the CST816 pulses INT on every report. If the
+// pulses stop without a release report, re-read once after this long.
+#define TOUCH_RELEASE_TIMEOUT_MS 100
+
 #define LCD_OPCODE_WRITE_CMD 0x02ULL
 #define LCD_OPCODE_READ_CMD  0x0BULL
 #define LCD_OPCODE_WRITE_COLOR 0x32ULL
@@ -50,6 +56,9 @@ static uint16_t *s_fb = NULL;
 static SemaphoreHandle_t s_flush_sem = NULL;
 static const char *TAG = "BOARD_WVSHR_1V85_T";
 static bool s_touch_task_started = false;
+static TaskHandle_t s_touch_task = NULL;
+static board_touch_ring_t s_touch_ring;
+static i2c_master_dev_handle_t s_touch_dev = NULL;
 
 static const st77916_lcd_init_cmd_t vendor_specific_init_touch[] = {
     {0xF0, (uint8_t[]){0x28}, 1, 0},
@@ -289,19 +298,40 @@ static void init_backlight(void)
 
 static void init_touch_bus(void)
 {
-    const i2c_port_t port = TOUCH_I2C_PORT;
-    i2c_config_t cfg = {
-        .mode = I2C_MODE_MASTER,
+    i2c_master_bus_handle_t bus = NULL;
+    i2c_master_bus_config_t bus_cfg = {
+        .i2c_port = TOUCH_I2C_PORT,
         .sda_io_num = PIN_TOUCH_SDA,
         .scl_io_num = PIN_TOUCH_SCL,
-        .sda_pullup_en = GPIO_PULLUP_ENABLE,
-        .scl_pullup_en = GPIO_PULLUP_ENABLE,
-        .master.clk_speed = 400000,
+        .clk_source = I2C_CLK_SRC_DEFAULT,
+        .glitch_ignore_cnt = 7,
+        .flags.enable_internal_pullup = true,
+    };
+    ESP_ERROR_CHECK(i2c_new_master_bus(&bus_cfg, &bus));
+    i2c_device_config_t dev_cfg = {
+        .dev_addr_length = I2C_ADDR_BIT_LEN_7,
+        .device_address = CST816_ADDR,
+        .scl_speed_hz = 400000,
+    };
+    ESP_ERROR_CHECK(i2c_master_bus_add_device(bus, &dev_cfg, &s_touch_dev));
+
+    gpio_config_t int_cfg = {
+        .pin_bit_mask = 1ULL << PIN_TOUCH_INT,
+        .mode = GPIO_MODE_INPUT,
+        .pull_up_en = GPIO_PULLUP_ENABLE,
+        .pull_down_en = GPIO_PULLDOWN_DISABLE,
+        .intr_type = GPIO_INTR_NEGEDGE,
     };
-    i2c_param_config(port, &cfg);
-    i2c_driver_install(port, cfg.mode, 0, 0, 0);
-    gpio_reset_pin(PIN_TOUCH_INT);
-    gpio_set_direction(PIN_TOUCH_INT, GPIO_MODE_INPUT);
+    gpio_config(&int_cfg);
+}
+
+static void touch_int_isr(void *arg)
+{
+    BaseType_t woken = pdFALSE;
+    if (s_touch_task) {
+        vTaskNotifyGiveFromISR(s_touch_task, &woken);
+    }
+    portYIELD_FROM_ISR(woken);
 }
 
 static esp_err_t cst816_read(uint8_t reg, uint8_t *data, size_t len)
@@ -309,20 +339,7 @@ static esp_err_t cst816_read(uint8_t reg, uint8_t *data, size_t len)
     if (!data || len == 0) {
         return ESP_ERR_INVALID_ARG;
     }
-    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-    i2c_master_start(cmd);
-    i2c_master_write_byte(cmd, (CST816_ADDR << 1) | I2C_MASTER_WRITE, true);
-    i2c_master_write_byte(cmd, reg, true);
-    i2c_master_start(cmd);
-    i2c_master_write_byte(cmd, (CST816_ADDR << 1) | I2C_MASTER_READ, true);
-    if (len > 1) {
-        i2c_master_read(cmd, data, len - 1, I2C_MASTER_ACK);
-    }
-    i2c_master_read_byte(cmd, data + len - 1, I2C_MASTER_NACK);
-    i2c_master_stop(cmd);
-    esp_err_t err = i2c_master_cmd_begin(TOUCH_I2C_PORT, cmd, pdMS_TO_TICKS(50));
-    i2c_cmd_link_delete(cmd);
-    return err;
+    return i2c_master_transmit_receive(s_touch_dev, &reg, 1, data, len, 50);
 }
 
 static bool cst816_get_point(uint16_t *x, uint16_t *y)
@@ -346,13 +363,20 @@ static bool cst816_get_point(uint16_t *x, uint16_t *y)
     return true;
 }
 
+// Sleeps until the INT ISR signals a report, so an idle panel costs no CPU
+// time or I2C traffic. While touching, a missing pulse triggers one re-read.
 static void touch_logger_task(void *arg)
 {
     bool touching = false;
     while (1) {
+        TickType_t wait = touching ? pdMS_TO_TICKS(TOUCH_RELEASE_TIMEOUT_MS) : portMAX_DELAY;
+        ulTaskNotifyTake(pdTRUE, wait);
+
         uint16_t x = 0;
         uint16_t y = 0;
         bool pressed = cst816_get_point(&x, &y);
+        board_touch_point_t pt = { .id = 0, .x = (int16_t)x, .y = (int16_t)y };
+        board_touch_ring_report(&s_touch_ring, &pt, pressed ? 1 : 0, esp_timer_get_time());
         if (pressed) {
             touching = true;
             ESP_LOGI(TAG, "Touch (%u,%u)", (unsigned)x, (unsigned)y);
@@ -360,7 +384,6 @@ static void touch_logger_task(void *arg)
             touching = false;
             ESP_LOGI(TAG, "Touch released");
         }
-        vTaskDelay(pdMS_TO_TICKS(50));
     }
 }
 
@@ -369,12 +392,19 @@ static void start_touch_logger(void)
     if (s_touch_task_started) {
         return;
     }
-    BaseType_t ok = xTaskCreate(touch_logger_task, "TouchLogger", 2048, NULL, 5, NULL);
-    if (ok == pdPASS) {
-        s_touch_task_started = true;
-    } else {
+    BaseType_t ok = xTaskCreate(touch_logger_task, "TouchLogger", 2048, NULL, 5, &s_touch_task);
+    if (ok != pdPASS) {
         ESP_LOGW(TAG, "Failed to start touch logger task");
+        return;
+    }
+    s_touch_task_started = true;
+
+    esp_err_t err = gpio_install_isr_service(0);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+        ESP_LOGW(TAG, "GPIO ISR service: %s", esp_err_to_name(err));
+        return;
     }
+    gpio_isr_handler_add(PIN_TOUCH_INT, touch_int_isr, NULL);
 }
 
 void board_init(void)
@@ -512,14 +542,31 @@ void board_lcd_sanity_test(void)
 
 // --- Display drawing API ---
 
+int board_touch_read(board_touch_point_t *points, int max_points)
+{
+    return board_touch_ring_snapshot(&s_touch_ring, points, max_points);
+}
+
+int board_touch_get_events(board_touch_event_t *events, int max_events)
+{
+    int n = board_touch_ring_pop(&s_touch_ring, events, max_events);
+    if (n > 0) {
+        board_latency_mark(BOARD_LATENCY_TOUCH, events[0].timestamp_us);
+        board_latency_mark(BOARD_LATENCY_DEQUEUE, esp_timer_get_time());
+    }
+    return n;
+}
+
 int board_lcd_width(void) { return LCD_H_RES; }
 int board_lcd_height(void) { return LCD_V_RES; }
 
 void board_lcd_flush(void)
 {
     if (!s_panel || !s_fb) return;
+    board_latency_mark(BOARD_LATENCY_RENDER, esp_timer_get_time());
     esp_lcd_panel_draw_bitmap(s_panel, 0, 0, LCD_H_RES, LCD_V_RES, s_fb);
     xSemaphoreTake(s_flush_sem, portMAX_DELAY);
+    board_latency_mark(BOARD_LATENCY_FLUSH_DONE, esp_timer_get_time());
 }
 
 void board_lcd_clear(void)
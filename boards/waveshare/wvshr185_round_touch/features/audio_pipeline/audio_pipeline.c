@@ -0,0 +1,525 @@
+// Copyright 2026 David M. King
+// SPDX-License-Identifier: Apache-2.0
+
+// Mic-to-speaker pipeline for waveshare/wvshr185_round.
+// Both ends already stream: mic_stream_start() delivers each DMA frame on
+// the mic reader task, and a speaker_play_stream() voice is pulled once per
+// mixer block. The pipeline processes each mic frame in the mic callback
+// and hands it to the speaker callback through a lock-free monitor buffer,
+// so the only added latency is that buffer's fill level. With the
+// resampler module installed the mic may run at a different rate; frames
+// are converted to the speaker rate first and everything after that runs
+// at the speaker rate.
+
+#include "audio_pipeline.h"
+#include <math.h>
+#include <stdatomic.h>
+#include <string.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "mic.h"
+#include "speaker.h"
+
+static const char *TAG = "AUDIO_PIPE";
+
+#define MIC_RATE        CONFIG_MIC_SAMPLE_RATE
+#define SAMPLE_RATE     CONFIG_SPEAKER_SAMPLE_RATE
+
+#if MIC_RATE != SAMPLE_RATE
+#if !__has_include("resampler.h")
+#error "audio_pipeline: mic and speaker rates differ; add --resampler or match CONFIG_MIC_SAMPLE_RATE"
+#endif
+#include "resampler.h"
+#define RESAMPLE        1
+#define WORK_SAMPLES    RESAMPLER_OUT_MAX(MIC_FRAME_SAMPLES, MIC_RATE, SAMPLE_RATE)
+static resampler_t s_rs;
+#else
+#define RESAMPLE        0
+#define WORK_SAMPLES    MIC_FRAME_SAMPLES
+#endif
+
+#define BUFFER_SAMPLES  CONFIG_AUDIO_PIPELINE_BUFFER_SAMPLES
+// Above this fill the mic is ahead of the speaker; drop rather than let
+// the latency creep up.
+#define BUFFER_LIMIT    (BUFFER_SAMPLES + WORK_SAMPLES + CONFIG_SPEAKER_BLOCK_SAMPLES)
+
+// Monitor ring: the smallest power of 2 above BUFFER_LIMIT. The Kconfig
+// ranges put that anywhere from ~100 to ~11000 samples (more when
+// resampling up), so size it here rather than hard-coding the worst case.
+// MON_BOUND is BUFFER_LIMIT without the casts, so #if can evaluate it.
+#define MON_BOUND       (BUFFER_SAMPLES + CONFIG_SPEAKER_BLOCK_SAMPLES + 1 + \
+                         (MIC_FRAME_SAMPLES * SAMPLE_RATE + MIC_RATE - 1) / MIC_RATE)
+#if MON_BOUND < 1024
+#define MON_SIZE        1024
+#elif MON_BOUND < 2048
+#define MON_SIZE        2048
+#elif MON_BOUND < 4096
+#define MON_SIZE        4096
+#elif MON_BOUND < 8192
+#define MON_SIZE        8192
+#elif MON_BOUND < 16384
+#define MON_SIZE        16384
+#elif MON_BOUND < 32768
+#define MON_SIZE        32768
+#else
+#error "audio_pipeline: monitor buffer would exceed 32768 samples; lower the buffer or frame sizes"
+#endif
+#define FAR_SIZE        4096    // power of 2
+
+#define CLICK_LEVEL     24000
+#define CLICK_HZ        2000
+#define CLICK_SAMPLES   (2 * SAMPLE_RATE / CLICK_HZ)    // two cycles
+#define CLICK_THRESHOLD 8000
+
+_Static_assert((MON_SIZE & (MON_SIZE - 1)) == 0, "MON_SIZE must be a power of 2");
+_Static_assert(MON_SIZE > BUFFER_LIMIT, "monitor buffer too small");
+
+static inline int16_t sat16(int32_t v)
+{
+    if (v > INT16_MAX) return INT16_MAX;
+    if (v < INT16_MIN) return INT16_MIN;
+    return (int16_t)v;
+}
+
+typedef struct {
+    audio_stage_fn_t fn;
+    void *ctx;
+} stage_t;
+
+static stage_t s_stages[AUDIO_PIPELINE_MAX_STAGES];
+static int s_num_stages;
+static audio_pipeline_config_t s_cfg;
+static volatile bool s_running;
+static int s_voice = -1;
+
+// Single-producer / single-consumer sample rings
+static int16_t s_mon[MON_SIZE];         // mic task -> mixer task
+static atomic_uint s_mon_head, s_mon_tail;
+static bool s_primed;                   // mixer task only
+static int16_t s_far[FAR_SIZE];         // app -> mixer task
+static atomic_uint s_far_head, s_far_tail;
+
+static int16_t s_work[WORK_SAMPLES];
+
+// Sample counters in each stream's own time base. Both I2S ports run from
+// the same clock, so their difference is constant while neither drops.
+static uint32_t s_in_count;             // mic task only
+static atomic_uint s_out_count;         // written by the mixer task
+static uint32_t s_mic_overruns;
+
+static struct {
+    uint32_t frames, underruns, overruns, play_dropped, stage_us_max, aec_skipped;
+} s_stats;
+
+// --- Latency measurement: a click injected on the output, detected on the input ---
+
+enum { MEAS_IDLE, MEAS_ARMED, MEAS_SENT, MEAS_DONE };
+static atomic_int s_meas = MEAS_IDLE;
+static SemaphoreHandle_t s_meas_sem;
+static int64_t s_click_us;
+static uint32_t s_click_idx;            // out-count of the first click sample
+static uint32_t s_click_fill;           // monitor fill when the click went out
+static int64_t s_detect_us;
+static uint32_t s_detect_idx;           // in-count of the first sample above threshold
+
+static void meas_detect(const int16_t *x, size_t n, int64_t now)
+{
+    if (atomic_load_explicit(&s_meas, memory_order_acquire) != MEAS_SENT) return;
+    for (size_t i = 0; i < n; i++) {
+        if (x[i] > CLICK_THRESHOLD || x[i] < -CLICK_THRESHOLD) {
+            // The frame completed at now; sample i is (n - i) samples older.
+            int64_t t = now - (int64_t)(n - i) * 1000000 / SAMPLE_RATE;
+            if (t <= s_click_us) continue;      // captured before the click played
+            s_detect_us = t;
+            s_detect_idx = s_in_count + i;
+            int expected = MEAS_SENT;
+            if (atomic_compare_exchange_strong(&s_meas, &expected, MEAS_DONE)) {
+                xSemaphoreGive(s_meas_sem);
+            }
+            return;
+        }
+    }
+}
+
+// --- Echo canceller (NLMS) ---
+// The reference is what this voice hands the speaker, kept by out-count.
+// Mic sample i hears reference sample i - s_aec_offset, where the offset is
+// taken from the click measurement; TAPS weights model the echo path from
+// a few samples before the measured onset.
+
+#if CONFIG_AUDIO_PIPELINE_AEC
+#define TAPS        CONFIG_AUDIO_PIPELINE_AEC_TAPS
+#define AEC_MU      (CONFIG_AUDIO_PIPELINE_AEC_STEP_MILLI / 1000.0f)
+#define AEC_EPS     (TAPS * 1024.0f)   // regularises near-silent reference
+#define AEC_LEAD    16                  // taps before the measured onset
+#define REF_SIZE    8192                // power of 2
+
+_Static_assert(REF_SIZE > 2 * (TAPS + WORK_SAMPLES + CONFIG_SPEAKER_BLOCK_SAMPLES),
+               "reference ring too small");
+
+static int16_t s_ref[REF_SIZE];
+static float s_w[TAPS];
+static float s_win[TAPS - 1 + WORK_SAMPLES];
+static volatile bool s_aec_on;         // owned by the mic task
+static uint32_t s_aec_offset;
+static atomic_uint s_aec_pending;       // new offset + 1, picked up per frame
+
+static void aec_frame(int16_t *x, size_t n)
+{
+    // Window covers the reference from TAPS-1 before the first sample's
+    // alignment point to the last sample's; it must still be in the ring
+    // and already written.
+    uint32_t first = s_in_count - s_aec_offset - (TAPS - 1);
+    uint32_t end   = s_in_count + n - s_aec_offset;
+    uint32_t written = atomic_load_explicit(&s_out_count, memory_order_acquire);
+    if ((int32_t)(written - end) < 0 ||
+        written - first > REF_SIZE - CONFIG_SPEAKER_BLOCK_SAMPLES) {
+        s_stats.aec_skipped++;
+        return;
+    }
+    for (size_t k = 0; k < TAPS - 1 + n; k++) {
+        s_win[k] = s_ref[(first + k) & (REF_SIZE - 1)];
+    }
+    for (size_t i = 0; i < n; i++) {
+        const float *r = &s_win[i];
+        float y = 0.0f, p = 0.0f;
+        for (int k = 0; k < TAPS; k++) {
+            y += s_w[k] * r[k];
+            p += r[k] * r[k];
+        }
+        float e = (float)x[i] - y;
+        float g = AEC_MU * e / (p + AEC_EPS);
+        for (int k = 0; k < TAPS; k++) {
+            s_w[k] += g * r[k];
+        }
+        x[i] = sat16((int32_t)lrintf(e));
+    }
+}
+#endif
+
+// --- Mic side: runs on the mic reader task ---
+
+static void in_frame(const int16_t *frame, size_t n, void *ctx)
+{
+    int64_t now = esp_timer_get_time();
+
+    // A lost DMA block is a gap in the input time base; keep the count true.
+    mic_stream_stats_t ms;
+    mic_stream_get_stats(&ms);
+    s_in_count += (uint32_t)((uint64_t)(ms.dma_overruns - s_mic_overruns) *
+                             MIC_FRAME_SAMPLES * SAMPLE_RATE / MIC_RATE);
+    s_mic_overruns = ms.dma_overruns;
+
+#if RESAMPLE
+    n = resampler_process(&s_rs, frame, n, s_work);
+#else
+    memcpy(s_work, frame, n * sizeof(int16_t));
+#endif
+    meas_detect(s_work, n, now);
+#if CONFIG_AUDIO_PIPELINE_AEC
+    // A new alignment invalidates the learned echo path.
+    uint32_t pending = atomic_exchange(&s_aec_pending, 0);
+    if (pending) {
+        s_aec_offset = pending - 1;
+        memset(s_w, 0, sizeof(s_w));
+        s_aec_on = true;
+    }
+    if (s_aec_on) aec_frame(s_work, n);
+#endif
+    for (int i = 0; i < s_num_stages; i++) {
+        s_stages[i].fn(s_work, n, s_stages[i].ctx);
+    }
+    uint32_t us = (uint32_t)(esp_timer_get_time() - now);
+    if (us > s_stats.stage_us_max) s_stats.stage_us_max = us;
+    s_in_count += n;
+    s_stats.frames++;
+
+    if (s_cfg.sink) s_cfg.sink(s_work, n, s_cfg.sink_ctx);
+    if (!s_cfg.monitor) return;
+
+    unsigned head = atomic_load_explicit(&s_mon_head, memory_order_relaxed);
+    unsigned tail = atomic_load_explicit(&s_mon_tail, memory_order_acquire);
+    if (head - tail + n > BUFFER_LIMIT) {
+        s_stats.overruns += n;
+        return;
+    }
+    for (size_t i = 0; i < n; i++) {
+        s_mon[(head + i) & (MON_SIZE - 1)] = s_work[i];
+    }
+    atomic_store_explicit(&s_mon_head, head + n, memory_order_release);
+}
+
+// --- Speaker side: the stream voice's fill callback, on the mixer task ---
+
+static size_t out_fill(int16_t *out, size_t samples, void *ctx)
+{
+    if (!s_running) return 0;       // ends the voice
+
+    unsigned head = atomic_load_explicit(&s_mon_head, memory_order_acquire);
+    unsigned tail = atomic_load_explicit(&s_mon_tail, memory_order_relaxed);
+    unsigned fill = head - tail;
+    size_t n = 0;
+    if (!s_primed && fill >= BUFFER_SAMPLES) s_primed = true;
+    if (s_primed) {
+        n = fill < samples ? fill : samples;
+        for (size_t i = 0; i < n; i++) {
+            out[i] = s_mon[(tail + i) & (MON_SIZE - 1)];
+        }
+        atomic_store_explicit(&s_mon_tail, tail + n, memory_order_release);
+        if (n < samples) {
+            s_stats.underruns++;
+            s_primed = false;       // refill to BUFFER_SAMPLES before resuming
+        }
+    }
+    memset(out + n, 0, (samples - n) * sizeof(int16_t));
+
+    head = atomic_load_explicit(&s_far_head, memory_order_acquire);
+    tail = atomic_load_explicit(&s_far_tail, memory_order_relaxed);
+    n = head - tail < samples ? head - tail : samples;
+    for (size_t i = 0; i < n; i++) {
+        out[i] = sat16(out[i] + s_far[(tail + i) & (FAR_SIZE - 1)]);
+    }
+    atomic_store_explicit(&s_far_tail, tail + n, memory_order_release);
+
+    uint32_t idx = atomic_load_explicit(&s_out_count, memory_order_relaxed);
+    if (samples >= CLICK_SAMPLES &&
+        atomic_load_explicit(&s_meas, memory_order_acquire) == MEAS_ARMED) {
+        for (int i = 0; i < CLICK_SAMPLES; i++) {
+            int half = (i * 2 * CLICK_HZ / SAMPLE_RATE) & 1;
+            out[i] = sat16(out[i] + (half ? -CLICK_LEVEL : CLICK_LEVEL));
+        }
+        s_click_idx = idx;
+        s_click_fill = fill;
+        s_click_us = esp_timer_get_time();
+        int expected = MEAS_ARMED;      // fails if the caller timed out meanwhile
+        atomic_compare_exchange_strong(&s_meas, &expected, MEAS_SENT);
+    }
+
+#if CONFIG_AUDIO_PIPELINE_AEC
+    for (size_t i = 0; i < samples; i++) {
+        s_ref[(idx + i) & (REF_SIZE - 1)] = out[i];
+    }
+#endif
+    atomic_store_explicit(&s_out_count, idx + samples, memory_order_release);
+    return samples;
+}
+
+// --- Public API ---
+
+esp_err_t audio_pipeline_add_stage(audio_stage_fn_t fn, void *ctx)
+{
+    if (!fn) return ESP_ERR_INVALID_ARG;
+    if (s_running) return ESP_ERR_INVALID_STATE;
+    if (s_num_stages >= AUDIO_PIPELINE_MAX_STAGES) return ESP_ERR_NO_MEM;
+    s_stages[s_num_stages++] = (stage_t){ .fn = fn, .ctx = ctx };
+    return ESP_OK;
+}
+
+size_t audio_pipeline_play(const int16_t *pcm, size_t n)
+{
+    unsigned head = atomic_load_explicit(&s_far_head, memory_order_relaxed);
+    unsigned tail = atomic_load_explicit(&s_far_tail, memory_order_acquire);
+    size_t room = FAR_SIZE - (head - tail);
+    size_t take = n < room ? n : room;
+    for (size_t i = 0; i < take; i++) {
+        s_far[(head + i) & (FAR_SIZE - 1)] = pcm[i];
+    }
+    atomic_store_explicit(&s_far_head, head + take, memory_order_release);
+    s_stats.play_dropped += n - take;
+    return take;
+}
+
+esp_err_t audio_pipeline_measure_latency(audio_latency_t *out, TickType_t timeout)
+{
+    if (!s_running) return ESP_ERR_INVALID_STATE;
+    int expected = MEAS_IDLE;
+    if (!atomic_compare_exchange_strong(&s_meas, &expected, MEAS_ARMED)) {
+        return ESP_ERR_INVALID_STATE;   // another measurement in progress
+    }
+    xSemaphoreTake(s_meas_sem, 0);
+    if (xSemaphoreTake(s_meas_sem, timeout) != pdTRUE) {
+        // Lost the race only if the mic task completed it just now.
+        int state = atomic_exchange(&s_meas, MEAS_IDLE);
+        if (state != MEAS_DONE) {
+            ESP_LOGW(TAG, "Click not detected (speaker muted or mic gain too low?)");
+            return ESP_ERR_TIMEOUT;
+        }
+    }
+    uint32_t rt_us = (uint32_t)(s_detect_us - s_click_us);
+    uint32_t buf_us = (uint32_t)((uint64_t)s_click_fill * 1000000 / SAMPLE_RATE);
+#if CONFIG_AUDIO_PIPELINE_AEC
+    // An echo path shorter than AEC_LEAD starts the taps at the click itself.
+    int32_t delay = (int32_t)(s_detect_idx - s_click_idx);
+    uint32_t offset = delay > AEC_LEAD ? (uint32_t)(delay - AEC_LEAD) : 0;
+    if (!s_aec_on || offset != s_aec_offset) {
+        atomic_store(&s_aec_pending, offset + 1);
+    }
+#endif
+    atomic_store(&s_meas, MEAS_IDLE);
+    if (out) {
+        out->round_trip_us = rt_us;
+        out->buffer_us = buf_us;
+        out->total_us = rt_us + buf_us;
+    }
+    return ESP_OK;
+}
+
+esp_err_t audio_pipeline_start(const audio_pipeline_config_t *cfg)
+{
+    if (!cfg) return ESP_ERR_INVALID_ARG;
+    if (s_running) return ESP_ERR_INVALID_STATE;
+    if (!s_meas_sem) {
+        s_meas_sem = xSemaphoreCreateBinary();
+        if (!s_meas_sem) return ESP_ERR_NO_MEM;
+    }
+#if RESAMPLE
+    if (!s_rs.coefs && !resampler_init(&s_rs, MIC_RATE, SAMPLE_RATE, RESAMPLER_DEFAULT_TAPS)) {
+        return ESP_ERR_NO_MEM;
+    }
+    resampler_reset(&s_rs);
+#endif
+
+    s_cfg = *cfg;
+    atomic_store(&s_mon_head, 0);
+    atomic_store(&s_mon_tail, 0);
+    atomic_store(&s_far_head, 0);
+    atomic_store(&s_far_tail, 0);
+    atomic_store(&s_out_count, 0);
+    atomic_store(&s_meas, MEAS_IDLE);
+    s_primed = false;
+    s_in_count = 0;
+    memset(&s_stats, 0, sizeof(s_stats));
+    mic_stream_stats_t ms;
+    mic_stream_get_stats(&ms);
+    s_mic_overruns = ms.dma_overruns;
+#if CONFIG_AUDIO_PIPELINE_AEC
+    s_aec_on = false;
+    atomic_store(&s_aec_pending, 0);
+#endif
+
+    s_running = true;
+    s_voice = speaker_play_stream(out_fill, NULL, cfg->out_gain);
+    if (s_voice < 0) {
+        s_running = false;
+        ESP_LOGE(TAG, "No speaker voice free (speaker_init() not called?)");
+        return ESP_ERR_INVALID_STATE;
+    }
+    esp_err_t err = mic_stream_start(in_frame, NULL);
+    if (err != ESP_OK) {
+        audio_pipeline_stop();
+        return err;
+    }
+
+    ESP_LOGI(TAG, "Started: %d stages, %d-sample buffer (%d us), monitor %s",
+             s_num_stages, BUFFER_SAMPLES, BUFFER_SAMPLES * 1000 / (SAMPLE_RATE / 1000),
+             cfg->monitor ? "on" : "off");
+#if CONFIG_AUDIO_PIPELINE_AEC
+    audio_latency_t lat;
+    if (audio_pipeline_measure_latency(&lat, pdMS_TO_TICKS(500)) == ESP_OK) {
+        ESP_LOGI(TAG, "Echo canceller aligned: round trip %lu us, %d taps",
+                 (unsigned long)lat.round_trip_us, TAPS);
+    } else {
+        ESP_LOGW(TAG, "Echo canceller disabled until audio_pipeline_measure_latency() succeeds");
+    }
+#endif
+    return ESP_OK;
+}
+
+esp_err_t audio_pipeline_stop(void)
+{
+    if (!s_running) return ESP_ERR_INVALID_STATE;
+    mic_stream_stop();
+    s_running = false;
+    // out_fill() ends the voice on its next block; wait so a late call
+    // cannot race the next start().
+    for (int i = 0; i < 100 && speaker_voice_active(s_voice); i++) {
+        vTaskDelay(1);
+    }
+    s_voice = -1;
+#if CONFIG_AUDIO_PIPELINE_AEC
+    s_aec_on = false;
+#endif
+    return ESP_OK;
+}
+
+void audio_pipeline_get_stats(audio_pipeline_stats_t *out)
+{
+    out->frames = s_stats.frames;
+    out->underruns = s_stats.underruns;
+    out->overruns = s_stats.overruns;
+    out->play_dropped = s_stats.play_dropped;
+    out->stage_us_max = s_stats.stage_us_max;
+    out->aec_skipped = s_stats.aec_skipped;
+#if CONFIG_AUDIO_PIPELINE_AEC
+    out->aec_active = s_aec_on;
+#else
+    out->aec_active = false;
+#endif
+}
+
+// --- Built-in stages ---
+
+void audio_stage_gain(int16_t *pcm, size_t n, void *ctx)
+{
+    int32_t gain = *(const volatile uint16_t *)ctx;
+    for (size_t i = 0; i < n; i++) {
+        pcm[i] = sat16((pcm[i] * gain) >> 15);
+    }
+}
+
+static void biquad_set(audio_biquad_t *bq, float b0, float b1, float b2,
+                       float a0, float a1, float a2)
+{
+    bq->b0 = b0 / a0;
+    bq->b1 = b1 / a0;
+    bq->b2 = b2 / a0;
+    bq->a1 = a1 / a0;
+    bq->a2 = a2 / a0;
+    bq->z1 = bq->z2 = 0.0f;
+}
+
+void audio_biquad_lowpass(audio_biquad_t *bq, float fc_hz, float q)
+{
+    float w0 = 2.0f * (float)M_PI * fc_hz / SAMPLE_RATE;
+    float c = cosf(w0), alpha = sinf(w0) / (2.0f * q);
+    biquad_set(bq, (1.0f - c) / 2.0f, 1.0f - c, (1.0f - c) / 2.0f,
+               1.0f + alpha, -2.0f * c, 1.0f - alpha);
+}
+
+void audio_biquad_highpass(audio_biquad_t *bq, float fc_hz, float q)
+{
+    float w0 = 2.0f * (float)M_PI * fc_hz / SAMPLE_RATE;
+    float c = cosf(w0), alpha = sinf(w0) / (2.0f * q);
+    biquad_set(bq, (1.0f + c) / 2.0f, -(1.0f + c), (1.0f + c) / 2.0f,
+               1.0f + alpha, -2.0f * c, 1.0f - alpha);
+}
+
+// Transposed direct form II: two state variables, no input history.
+void audio_stage_biquad(int16_t *pcm, size_t n, void *ctx)
+{
+    audio_biquad_t *bq = ctx;
+    float z1 = bq->z1, z2 = bq->z2;
+    for (size_t i = 0; i < n; i++) {
+        float x = pcm[i];
+        float y = bq->b0 * x + z1;
+        z1 = bq->b1 * x - bq->a1 * y + z2;
+        z2 = bq->b2 * x - bq->a2 * y;
+        pcm[i] = sat16((int32_t)lrintf(y));
+    }
+    bq->z1 = z1;
+    bq->z2 = z2;
+}
+
+void audio_stage_echo(int16_t *pcm, size_t n, void *ctx)
+{
+    audio_echo_t *e = ctx;
+    for (size_t i = 0; i < n; i++) {
+        int32_t d = e->buf[e->pos];
+        int32_t x = pcm[i];
+        e->buf[e->pos] = sat16(x + ((d * e->feedback) >> 15));
+        pcm[i] = sat16(x + ((d * e->mix) >> 15));
+        if (++e->pos == e->len) e->pos = 0;
+    }
+}
@@ -2,10 +2,11 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #pragma once
+#include <stdint.h>
 #include "esp_err.h"
 
 // Initialize the QMI8658 IMU over I2C (SCL=IO10, SDA=IO11).
-// The I2C bus is shared with the RTC — call board_init() first.
+// The I2C bus is shared with the RTC and IO expander via i2c_bus.h.
 esp_err_t imu_init(void);
 
 typedef struct {
@@ -13,4 +14,35 @@ typedef struct {
     float gyro_x,  gyro_y,  gyro_z;    // deg/s
 } imu_data_t;
 
+// Latest sample from the data registers.
 esp_err_t imu_read(imu_data_t *out);
+
+// --- FIFO streaming ---
+// imu_stream_start() puts the QMI8658 FIFO in stream mode and starts a task
+// that, on each watermark (CONFIG_IMU_FIFO_WATERMARK samples), drains the
+// whole FIFO in one burst read and queues timestamped samples in a ring.
+// The app drains the ring with imu_stream_read() at its own pace.
+//
+// Usage:
+//   imu_init();
+//   imu_stream_start();
+//   imu_sample_t s[64];
+//   int n = imu_stream_read(s, 64);
+
+typedef struct {
+    int64_t timestamp_us;   // esp_timer time the sample was taken (estimated)
+    imu_data_t data;
+} imu_sample_t;
+
+typedef struct {
+    uint32_t fifo_overflows;    // FIFO filled before it was drained
+    uint32_t ring_dropped;      // samples lost because the ring was full
+} imu_stream_stats_t;
+
+esp_err_t imu_stream_start(void);
+esp_err_t imu_stream_stop(void);
+
+// Pop up to max samples, oldest first. Returns the number copied.
+int imu_stream_read(imu_sample_t *out, int max);
+
+void imu_stream_get_stats(imu_stream_stats_t *out);
@@ -5,10 +5,17 @@
 // Pins: SCK=IO15, WS=IO2, SD=IO39, EN=IO12
 
 #include "mic.h"
+#include <math.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <string.h>
 #include "driver/i2s_std.h"
 #include "driver/gpio.h"
+#include "esp_attr.h"
 #include "esp_log.h"
 #include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
 
 static const char *TAG = "MIC";
 
@@ -19,8 +26,108 @@ static const char *TAG = "MIC";
 #define MIC_EN_GPIO     12
 #define SAMPLE_RATE     CONFIG_MIC_SAMPLE_RATE
 
+// Only the right slot is captured, as 32- or 16-bit DMA words.
+#if CONFIG_MIC_DATA_BITS_16
+typedef int16_t mic_word_t;
+#define I2S_DATA_BITS   I2S_DATA_BIT_WIDTH_16BIT
+#define WORD_TO_V(w)    ((int32_t)(w) << 4)
+#else
+typedef int32_t mic_word_t;
+#define I2S_DATA_BITS   I2S_DATA_BIT_WIDTH_32BIT
+#define WORD_TO_V(w)    ((w) >> 12)
+#endif
+
+// The conversion works on 20-bit samples (WORD_TO_V): enough for the mic's
+// ~61 dB SNR, with headroom for the DC accumulator in 32 bits.
+#define V_TO_16_SHIFT   4
+#define GAIN_Q          8       // gain is Q8: 256 = 0 dB
+#define DC_SHIFT        10      // high-pass pole at fs / (2*pi*1024)
+
+// One DMA block: MIC_FRAME_SAMPLES mono words.
+#define BLOCK_BYTES     (MIC_FRAME_SAMPLES * sizeof(mic_word_t))
+
+// Frame ring between the reader task and mic_stream_read(); power of two.
+#define RING_FRAMES     CONFIG_MIC_RING_FRAMES
+_Static_assert((RING_FRAMES & (RING_FRAMES - 1)) == 0, "MIC_RING_FRAMES must be a power of two");
+
+// mic_read() converts through a stack buffer this many samples at a time.
+#define READ_CHUNK      256
+
+#define READ_TIMEOUT_MS 100     // lets the reader task notice a stop request
+#define STREAM_PRIO     7       // above app tasks so capture is never starved
+
 static i2s_chan_handle_t rx_handle = NULL;
 
+static TaskHandle_t       s_stream_task;
+static volatile bool      s_stream_stop;
+static mic_stream_cb_t    s_stream_cb;
+static void              *s_stream_ctx;
+static mic_word_t         s_block[MIC_FRAME_SAMPLES];
+
+static int16_t            s_ring[RING_FRAMES][MIC_FRAME_SAMPLES];
+static atomic_uint        s_ring_head;        // written by the reader task
+static atomic_uint        s_ring_tail;        // written by mic_stream_read()
+static SemaphoreHandle_t  s_ring_ready;       // given when a frame is pushed
+
+static uint32_t           s_frames;
+static atomic_uint        s_ring_dropped;
+static atomic_uint        s_dma_overruns;
+
+static int32_t            s_gain = 256;       // Q8
+static int32_t            s_dc_acc;           // DC estimate << DC_SHIFT
+
+static inline int16_t sat16(int32_t v)
+{
+    return v > INT16_MAX ? INT16_MAX : v < INT16_MIN ? INT16_MIN : (int16_t)v;
+}
+
+static inline int16_t convert_one(mic_word_t w, int32_t *acc, int32_t gain)
+{
+    int32_t v = WORD_TO_V(w);
+#if CONFIG_MIC_DC_REMOVAL
+    int32_t dc = *acc >> DC_SHIFT;
+    *acc += v - dc;
+    v -= dc;
+#endif
+    return sat16((int32_t)(((int64_t)v * gain) >> (GAIN_Q + V_TO_16_SHIFT)));
+}
+
+// DMA words to int16 with DC removal and gain, four samples per iteration
+// so the loads, multiplies and stores of neighbouring samples overlap.
+// out may alias raw: sample i is written at or below where it was read.
+static void convert(const mic_word_t *raw, size_t n, int16_t *out)
+{
+    int32_t acc = s_dc_acc;
+    int32_t gain = s_gain;
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        mic_word_t w0 = raw[i], w1 = raw[i + 1], w2 = raw[i + 2], w3 = raw[i + 3];
+        out[i]     = convert_one(w0, &acc, gain);
+        out[i + 1] = convert_one(w1, &acc, gain);
+        out[i + 2] = convert_one(w2, &acc, gain);
+        out[i + 3] = convert_one(w3, &acc, gain);
+    }
+    for (; i < n; i++) {
+        out[i] = convert_one(raw[i], &acc, gain);
+    }
+    s_dc_acc = acc;
+}
+
+esp_err_t mic_set_gain_db(int db)
+{
+    if (db < 0 || db > 36) return ESP_ERR_INVALID_ARG;
+    s_gain = (int32_t)lroundf((1 << GAIN_Q) * powf(10.0f, db / 20.0f));
+    return ESP_OK;
+}
+
+// The I2S driver queues completed DMA blocks for i2s_channel_read(); when
+// that queue is full it drops the oldest block and calls this.
+static bool IRAM_ATTR on_recv_q_ovf(i2s_chan_handle_t handle, i2s_event_data_t *event, void *ctx)
+{
+    atomic_fetch_add_explicit(&s_dma_overruns, 1, memory_order_relaxed);
+    return false;
+}
+
 esp_err_t mic_init(void)
 {
     gpio_config_t io_cfg = {
@@ -33,17 +140,22 @@ esp_err_t mic_init(void)
     gpio_config(&io_cfg);
     gpio_set_level(MIC_EN_GPIO, 1);
 
+    // One DMA block per stream frame, so a frame is ready the moment its
+    // block completes.
     i2s_chan_config_t chan_cfg = I2S_CHANNEL_DEFAULT_CONFIG(I2S_PORT, I2S_ROLE_MASTER);
+    chan_cfg.dma_desc_num  = CONFIG_MIC_DMA_BUFFERS;
+    chan_cfg.dma_frame_num = MIC_FRAME_SAMPLES;
     esp_err_t ret = i2s_new_channel(&chan_cfg, NULL, &rx_handle);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "i2s_new_channel failed: %s", esp_err_to_name(ret));
         return ret;
     }
 
-    // Philips I2S, stereo 32-bit — MSM261 outputs 24-bit audio in 32-bit frame
+    // Philips I2S, 32-bit slots — MSM261 outputs 24-bit audio in 32-bit frame,
+    // on the right channel only (L/R pin tied high), so capture just that slot.
     i2s_std_config_t std_cfg = {
         .clk_cfg  = I2S_STD_CLK_DEFAULT_CONFIG(SAMPLE_RATE),
-        .slot_cfg = I2S_STD_PHILIPS_SLOT_DEFAULT_CONFIG(I2S_DATA_BIT_WIDTH_32BIT, I2S_SLOT_MODE_STEREO),
+        .slot_cfg = I2S_STD_PHILIPS_SLOT_DEFAULT_CONFIG(I2S_DATA_BITS, I2S_SLOT_MODE_MONO),
         .gpio_cfg = {
             .mclk = I2S_GPIO_UNUSED,
             .bclk = I2S_PIN_BCK,
@@ -54,6 +166,10 @@ esp_err_t mic_init(void)
         },
     };
 
+    std_cfg.slot_cfg.slot_bit_width = I2S_SLOT_BIT_WIDTH_32BIT;
+    std_cfg.slot_cfg.slot_mask = I2S_STD_SLOT_RIGHT;
+    mic_set_gain_db(CONFIG_MIC_GAIN_DB);
+
     ret = i2s_channel_init_std_mode(rx_handle, &std_cfg);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "i2s_channel_init_std_mode failed: %s", esp_err_to_name(ret));
@@ -62,6 +178,16 @@ esp_err_t mic_init(void)
         return ret;
     }
 
+    // Must be registered while the channel is still disabled.
+    i2s_event_callbacks_t cbs = { .on_recv_q_ovf = on_recv_q_ovf };
+    ret = i2s_channel_register_event_callback(rx_handle, &cbs, NULL);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "i2s_channel_register_event_callback failed: %s", esp_err_to_name(ret));
+        i2s_del_channel(rx_handle);
+        rx_handle = NULL;
+        return ret;
+    }
+
     ret = i2s_channel_enable(rx_handle);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "i2s_channel_enable failed: %s", esp_err_to_name(ret));
@@ -76,30 +202,138 @@ esp_err_t mic_init(void)
 
 esp_err_t mic_read(int16_t *samples, size_t num_samples, size_t *read_count)
 {
-    if (!rx_handle) return ESP_ERR_INVALID_STATE;
+    if (!rx_handle || s_stream_task) return ESP_ERR_INVALID_STATE;
 
-    static int32_t raw[2048];  // stereo 32-bit pairs
+    mic_word_t raw[READ_CHUNK];
     size_t total = 0;
 
     while (total < num_samples) {
         size_t chunk = num_samples - total;
-        if (chunk > 1024) chunk = 1024;
+        if (chunk > READ_CHUNK) chunk = READ_CHUNK;
 
         size_t bytes_read = 0;
-        esp_err_t ret = i2s_channel_read(rx_handle, raw, chunk * 2 * sizeof(int32_t),
+        esp_err_t ret = i2s_channel_read(rx_handle, raw, chunk * sizeof(mic_word_t),
                                          &bytes_read, portMAX_DELAY);
         if (ret != ESP_OK) return ret;
 
-        size_t pairs = bytes_read / (2 * sizeof(int32_t));
+        size_t n = bytes_read / sizeof(mic_word_t);
+        convert(raw, n, &samples[total]);
+        total += n;
+    }
+
+    if (read_count) *read_count = total;
+    return ESP_OK;
+}
+
+// --- Streaming capture ---
+
+static void ring_push(const int16_t *frame)
+{
+    unsigned head = atomic_load_explicit(&s_ring_head, memory_order_relaxed);
+    unsigned tail = atomic_load_explicit(&s_ring_tail, memory_order_acquire);
+    if (head - tail >= RING_FRAMES) {
+        atomic_fetch_add_explicit(&s_ring_dropped, 1, memory_order_relaxed);
+        return;
+    }
+    memcpy(s_ring[head % RING_FRAMES], frame, sizeof(s_ring[0]));
+    atomic_store_explicit(&s_ring_head, head + 1, memory_order_release);
+    xSemaphoreGive(s_ring_ready);
+}
+
+// i2s_channel_read() sleeps on the driver's queue of completed DMA blocks,
+// so the task wakes once per block. A read cut short by the stop timeout
+// keeps its partial block and resumes filling it.
+static void stream_task(void *arg)
+{
+    size_t fill = 0;
+    while (!s_stream_stop) {
+        size_t got = 0;
+        esp_err_t err = i2s_channel_read(rx_handle, (uint8_t *)s_block + fill, BLOCK_BYTES - fill,
+                                         &got, pdMS_TO_TICKS(READ_TIMEOUT_MS));
+        fill += got;
+        if (err != ESP_OK && err != ESP_ERR_TIMEOUT) {
+            ESP_LOGW(TAG, "I2S read failed: %s", esp_err_to_name(err));
+        }
+        if (fill < BLOCK_BYTES) {
+            continue;
+        }
+        fill = 0;
 
-        // MSM261 outputs on right channel (L/R pin tied high)
-        // 24-bit audio in upper bits of 32-bit frame, shift to 16-bit
-        for (size_t i = 0; i < pairs; i++) {
-            samples[total + i] = (int16_t)(raw[i * 2 + 1] >> 14);
+        int16_t *frame = (int16_t *)s_block;
+        convert(s_block, MIC_FRAME_SAMPLES, frame);
+        s_frames++;
+        if (s_stream_cb) {
+            s_stream_cb(frame, MIC_FRAME_SAMPLES, s_stream_ctx);
+        } else {
+            ring_push(frame);
         }
-        total += pairs;
     }
+    s_stream_task = NULL;
+    vTaskDelete(NULL);
+}
 
-    if (read_count) *read_count = total;
+esp_err_t mic_stream_start(mic_stream_cb_t cb, void *ctx)
+{
+    if (!rx_handle) return ESP_ERR_INVALID_STATE;
+    if (s_stream_task) return ESP_OK;
+
+    if (!s_ring_ready) {
+        s_ring_ready = xSemaphoreCreateBinary();
+        if (!s_ring_ready) return ESP_ERR_NO_MEM;
+    }
+    // Start from an empty ring so the first frame read is fresh audio.
+    atomic_store(&s_ring_tail, atomic_load(&s_ring_head));
+    xSemaphoreTake(s_ring_ready, 0);
+
+    s_stream_cb = cb;
+    s_stream_ctx = ctx;
+    s_stream_stop = false;
+    if (xTaskCreate(stream_task, "mic_stream", 3072, NULL, STREAM_PRIO, &s_stream_task) != pdPASS) {
+        return ESP_ERR_NO_MEM;
+    }
+    ESP_LOGI(TAG, "Streaming: %d samples/frame (%d ms), %s",
+             MIC_FRAME_SAMPLES, MIC_FRAME_SAMPLES * 1000 / SAMPLE_RATE,
+             cb ? "callback" : "ring");
+    return ESP_OK;
+}
+
+esp_err_t mic_stream_stop(void)
+{
+    if (!s_stream_task) return ESP_OK;
+
+    s_stream_stop = true;
+    while (s_stream_task) {
+        vTaskDelay(1);
+    }
     return ESP_OK;
 }
+
+size_t mic_stream_read(int16_t *out, size_t max_frames, TickType_t wait)
+{
+    unsigned tail = atomic_load_explicit(&s_ring_tail, memory_order_relaxed);
+    unsigned head = atomic_load_explicit(&s_ring_head, memory_order_acquire);
+    // The semaphore may still be given for a frame already read, so check
+    // the ring again after each wake-up.
+    TickType_t start = xTaskGetTickCount();
+    while (tail == head && s_ring_ready) {
+        TickType_t elapsed = xTaskGetTickCount() - start;
+        if (elapsed >= wait) break;
+        xSemaphoreTake(s_ring_ready, wait == portMAX_DELAY ? portMAX_DELAY : wait - elapsed);
+        head = atomic_load_explicit(&s_ring_head, memory_order_acquire);
+    }
+    size_t n = 0;
+    while (n < max_frames && tail != head) {
+        memcpy(&out[n * MIC_FRAME_SAMPLES], s_ring[tail % RING_FRAMES], sizeof(s_ring[0]));
+        n++;
+        tail++;
+    }
+    atomic_store_explicit(&s_ring_tail, tail, memory_order_release);
+    return n;
+}
+
+void mic_stream_get_stats(mic_stream_stats_t *out)
+{
+    out->frames = s_frames;
+    out->dma_overruns = atomic_load(&s_dma_overruns);
+    out->ring_dropped = atomic_load(&s_ring_dropped);
+}
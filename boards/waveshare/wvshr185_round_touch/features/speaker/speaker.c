@@ -5,9 +5,13 @@
 // I2S pins: LRCK=IO38, DIN=IO47, BCK=IO48
 
 #include "speaker.h"
+#include <stdatomic.h>
+#include <string.h>
 #include "driver/i2s_std.h"
 #include "esp_log.h"
 #include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
 
 static const char *TAG = "SPEAKER";
 
@@ -19,11 +23,166 @@ static const char *TAG = "SPEAKER";
 #define SAMPLE_RATE     CONFIG_SPEAKER_SAMPLE_RATE
 #define BITS_PER_SAMPLE CONFIG_SPEAKER_BITS_PER_SAMPLE
 
+#define VOICES          CONFIG_SPEAKER_VOICES
+#define BLOCK           CONFIG_SPEAKER_BLOCK_SAMPLES
+#define MIX_PRIO        7       // above app tasks so the DMA never runs dry
+#define MIX_STACK       4096    // stream callbacks run on it
+
+#if BITS_PER_SAMPLE == 16
+typedef int16_t out_t;
+#define OUT_SAMPLE(s)   (s)
+#elif BITS_PER_SAMPLE == 32
+typedef int32_t out_t;
+#define OUT_SAMPLE(s)   ((int32_t)(s) << 16)
+#else
+#error "CONFIG_SPEAKER_BITS_PER_SAMPLE must be 16 or 32"
+#endif
+
+enum { VOICE_FREE, VOICE_SETUP, VOICE_PLAYING };
+
+// A slot is claimed by the API (FREE -> SETUP), filled in, then handed to
+// the mixer (-> PLAYING); the mixer alone sets it FREE again. Handles carry
+// the slot's generation so a stale one can never touch a later voice.
+// speaker_write() waits on its own semaphore rather than one per slot, so
+// a write that claims the slot as soon as it is FREE cannot take the
+// completion meant for the previous one.
+typedef struct {
+    atomic_int          state;
+    atomic_uint         gen;
+    atomic_uint         stop_gen;   // stop requested for this generation
+    atomic_uint         gain;       // Q15
+    const int16_t      *pcm;        // clip
+    size_t              len;
+    size_t              pos;
+    speaker_stream_cb_t cb;         // stream
+    void               *ctx;
+    SemaphoreHandle_t   done;       // given when the voice ends (may be NULL)
+} voice_t;
+
 static i2s_chan_handle_t tx_handle = NULL;
+static TaskHandle_t      s_mix_task;
+static voice_t           s_voices[VOICES];
+
+static int32_t           s_acc[BLOCK];
+static int16_t           s_src[BLOCK];     // stream callback output
+static out_t             s_out[BLOCK];
+
+static inline int16_t sat16(int32_t v)
+{
+    return v > INT16_MAX ? INT16_MAX : v < INT16_MIN ? INT16_MIN : (int16_t)v;
+}
+
+static void voice_end(voice_t *v)
+{
+    SemaphoreHandle_t done = v->done;
+    atomic_store_explicit(&v->state, VOICE_FREE, memory_order_release);
+    if (done) {
+        xSemaphoreGive(done);
+    }
+}
+
+// Add one block of voice v to the accumulator. Returns false once the
+// voice has ended.
+static bool voice_mix(voice_t *v)
+{
+    unsigned gen = atomic_load_explicit(&v->gen, memory_order_relaxed);
+    if (atomic_load_explicit(&v->stop_gen, memory_order_relaxed) == gen) {
+        return false;
+    }
+    const int16_t *src;
+    size_t n;
+    if (v->cb) {
+        n = v->cb(s_src, BLOCK, v->ctx);
+        if (n > BLOCK) n = BLOCK;
+        src = s_src;
+    } else {
+        n = v->len - v->pos;
+        if (n > BLOCK) n = BLOCK;
+        src = v->pcm + v->pos;
+        v->pos += n;
+    }
+    // |sample * gain| < 2^31 for gain <= 65535, so no per-voice clipping.
+    int32_t gain = (int32_t)atomic_load_explicit(&v->gain, memory_order_relaxed);
+    for (size_t i = 0; i < n; i++) {
+        s_acc[i] += (src[i] * gain) >> 15;
+    }
+    return v->cb ? n == BLOCK : v->pos < v->len;
+}
+
+// Mixes one block per pass and hands it to i2s_channel_write(), which
+// returns as soon as a DMA buffer is free; with two buffers the next block
+// is mixed while the previous one plays. Sleeps while no voice is playing
+// (auto_clear sends silence meanwhile).
+static void mix_task(void *arg)
+{
+    while (1) {
+        bool any = false;
+        memset(s_acc, 0, sizeof(s_acc));
+        for (int i = 0; i < VOICES; i++) {
+            voice_t *v = &s_voices[i];
+            if (atomic_load_explicit(&v->state, memory_order_acquire) != VOICE_PLAYING) {
+                continue;
+            }
+            any = true;
+            if (!voice_mix(v)) {
+                voice_end(v);
+            }
+        }
+        if (!any) {
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            continue;
+        }
+        for (int i = 0; i < BLOCK; i++) {
+            s_out[i] = OUT_SAMPLE(sat16(s_acc[i]));
+        }
+        size_t bytes_written = 0;
+        i2s_channel_write(tx_handle, s_out, sizeof(s_out), &bytes_written, portMAX_DELAY);
+    }
+}
+
+static voice_t *voice_get(int handle)
+{
+    if (handle < 0) return NULL;
+    voice_t *v = &s_voices[handle % VOICES];
+    if (atomic_load(&v->gen) != (unsigned)(handle / VOICES)) return NULL;
+    return v;
+}
+
+static int voice_start(const int16_t *pcm, size_t len, speaker_stream_cb_t cb, void *ctx,
+                       uint16_t gain, SemaphoreHandle_t done)
+{
+    if (!s_mix_task) return -1;
+    for (int i = 0; i < VOICES; i++) {
+        voice_t *v = &s_voices[i];
+        int expected = VOICE_FREE;
+        if (!atomic_compare_exchange_strong(&v->state, &expected, VOICE_SETUP)) {
+            continue;
+        }
+        unsigned gen = (atomic_load(&v->gen) + 1) % (INT32_MAX / VOICES);
+        atomic_store(&v->gen, gen);
+        atomic_store(&v->stop_gen, ~0u);
+        atomic_store(&v->gain, gain);
+        v->pcm = pcm;
+        v->len = len;
+        v->pos = 0;
+        v->cb = cb;
+        v->ctx = ctx;
+        v->done = done;
+        atomic_store_explicit(&v->state, VOICE_PLAYING, memory_order_release);
+        xTaskNotifyGive(s_mix_task);
+        return (int)(gen * VOICES + i);
+    }
+    return -1;
+}
 
 esp_err_t speaker_init(void)
 {
+    // One DMA buffer per mix block; auto_clear plays silence when the mixer
+    // is idle instead of repeating the last block.
     i2s_chan_config_t chan_cfg = I2S_CHANNEL_DEFAULT_CONFIG(I2S_PORT, I2S_ROLE_MASTER);
+    chan_cfg.dma_desc_num  = CONFIG_SPEAKER_DMA_BUFFERS;
+    chan_cfg.dma_frame_num = BLOCK;
+    chan_cfg.auto_clear    = true;
     esp_err_t ret = i2s_new_channel(&chan_cfg, &tx_handle, NULL);
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "i2s_new_channel failed: %s", esp_err_to_name(ret));
@@ -63,16 +222,60 @@ esp_err_t speaker_init(void)
         return ret;
     }
 
-    ESP_LOGI(TAG, "Speaker ready (%dHz, %d-bit)", SAMPLE_RATE, BITS_PER_SAMPLE);
+    if (xTaskCreate(mix_task, "speaker_mix", MIX_STACK, NULL, MIX_PRIO, &s_mix_task) != pdPASS) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    ESP_LOGI(TAG, "Speaker ready (%dHz, %d-bit, %d voices, %d-sample blocks)",
+             SAMPLE_RATE, BITS_PER_SAMPLE, VOICES, BLOCK);
     return ESP_OK;
 }
 
 esp_err_t speaker_write(const int16_t *samples, size_t num_samples, size_t *written)
 {
     if (!tx_handle) return ESP_ERR_INVALID_STATE;
-    size_t bytes_written = 0;
-    esp_err_t ret = i2s_channel_write(tx_handle, samples, num_samples * sizeof(int16_t),
-                                      &bytes_written, portMAX_DELAY);
-    if (written) *written = bytes_written / sizeof(int16_t);
-    return ret;
+    StaticSemaphore_t done_buf;
+    SemaphoreHandle_t done = xSemaphoreCreateBinaryStatic(&done_buf);
+    int h = voice_start(samples, num_samples, NULL, NULL, SPEAKER_GAIN_UNITY, done);
+    if (h >= 0) {
+        xSemaphoreTake(done, portMAX_DELAY);
+    }
+    vSemaphoreDelete(done);
+    if (h < 0) return ESP_ERR_NO_MEM;
+    if (written) *written = num_samples;
+    return ESP_OK;
+}
+
+int speaker_play_clip(const int16_t *pcm, size_t samples, uint16_t gain)
+{
+    if (!pcm || !samples) return -1;
+    return voice_start(pcm, samples, NULL, NULL, gain, NULL);
+}
+
+int speaker_play_stream(speaker_stream_cb_t cb, void *ctx, uint16_t gain)
+{
+    if (!cb) return -1;
+    return voice_start(NULL, 0, cb, ctx, gain, NULL);
+}
+
+esp_err_t speaker_set_gain(int voice, uint16_t gain)
+{
+    voice_t *v = voice_get(voice);
+    if (!v) return ESP_ERR_NOT_FOUND;
+    atomic_store(&v->gain, gain);
+    return ESP_OK;
+}
+
+esp_err_t speaker_stop(int voice)
+{
+    voice_t *v = voice_get(voice);
+    if (!v) return ESP_ERR_NOT_FOUND;
+    atomic_store(&v->stop_gen, (unsigned)(voice / VOICES));
+    return ESP_OK;
+}
+
+bool speaker_voice_active(int voice)
+{
+    voice_t *v = voice_get(voice);
+    return v && atomic_load_explicit(&v->state, memory_order_acquire) != VOICE_FREE;
 }
@@ -6,7 +6,7 @@
 
 #include "tf_card.h"
 
-#include "driver/i2c.h"
+#include "tca9554.h"
 #include "driver/sdmmc_host.h"
 #include "esp_vfs_fat.h"
 #include "sdmmc_cmd.h"
@@ -14,15 +14,6 @@
 
 static const char *TAG = "TF_CARD";
 
-// I2C bus (shared with IMU, RTC, IO expander)
-#define I2C_PORT        0
-#define I2C_PIN_SCL     10
-#define I2C_PIN_SDA     11
-
-// TCA9554PWR IO expander
-#define TCA9554_ADDR        0x20
-#define TCA9554_CONFIG_REG  0x03    // 0=output, 1=input per bit
-
 // SDMMC native 1-bit pins
 #define SD_PIN_CLK  14
 #define SD_PIN_CMD  17
@@ -30,44 +21,20 @@ static const char *TAG = "TF_CARD";
 
 static sdmmc_card_t *s_card = NULL;
 
-static esp_err_t init_i2c_bus(void)
-{
-    esp_err_t ret = i2c_driver_install(I2C_PORT, I2C_MODE_MASTER, 0, 0, 0);
-    if (ret == ESP_FAIL || ret == ESP_ERR_INVALID_STATE) {
-        return ESP_OK;  // Already installed by another feature
-    }
-    if (ret != ESP_OK) return ret;
-    i2c_config_t cfg = {
-        .mode             = I2C_MODE_MASTER,
-        .sda_io_num       = I2C_PIN_SDA,
-        .scl_io_num       = I2C_PIN_SCL,
-        .sda_pullup_en    = GPIO_PULLUP_ENABLE,
-        .scl_pullup_en    = GPIO_PULLUP_ENABLE,
-        .master.clk_speed = 400000,
-    };
-    return i2c_param_config(I2C_PORT, &cfg);
-}
-
-static esp_err_t tca9554_init(void)
-{
-    // Set all 8 pins as outputs (CONFIG_REG = 0x00)
-    // Power-on default output register is 0xFF, so D3/CS stays HIGH
-    uint8_t buf[2] = {TCA9554_CONFIG_REG, 0x00};
-    return i2c_master_write_to_device(I2C_PORT, TCA9554_ADDR, buf, sizeof(buf),
-                                      pdMS_TO_TICKS(50));
-}
-
 esp_err_t tf_card_init(void)
 {
     esp_err_t ret;
 
-    ret = init_i2c_bus();
-    if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "I2C init failed: %s", esp_err_to_name(ret));
-        return ret;
-    }
-
+    // All 8 expander pins are outputs; D3/CS must be HIGH before the card
+    // sees its first command, so drive it and make it an output in one go
+    // (set_direction flushes the pending level first).
     ret = tca9554_init();
+    if (ret == ESP_OK) {
+        ret = tca9554_set_pins(TCA9554_SD_D3, TCA9554_SD_D3);
+    }
+    if (ret == ESP_OK) {
+        ret = tca9554_set_direction(0xFF, 0xFF);
+    }
     if (ret != ESP_OK) {
         ESP_LOGE(TAG, "TCA9554 init failed: %s", esp_err_to_name(ret));
         return ret;
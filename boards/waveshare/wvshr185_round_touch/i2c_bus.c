@@ -0,0 +1,179 @@
+// Copyright 2026 David M. King
+// SPDX-License-Identifier: Apache-2.0
+//
+// Shared I2C bus service — see i2c_bus.h.
+
+#include "i2c_bus.h"
+
+#include <stdatomic.h>
+#include "esp_log.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+static const char *TAG = "I2C_BUS";
+
+#define I2C_PORT            0
+#define I2C_PIN_SCL         10
+#define I2C_PIN_SDA         11
+
+// A register transfer at 400 kHz takes well under a millisecond; a device
+// holding the bus longer than this is wedged, not busy. Long bursts (e.g. an
+// IMU FIFO drain) get extra time at ~40 bytes/ms.
+#define XFER_TIMEOUT_MS     20
+#define XFER_BYTES_PER_MS   40
+#define LOCK_TIMEOUT_MS     100
+
+#define QUEUE_DEPTH         16
+#define WORKER_STACK        3072
+#define WORKER_PRIO         6
+
+enum { STATE_NONE, STATE_INITIALIZING, STATE_READY, STATE_FAILED };
+
+static atomic_int              s_state = STATE_NONE;
+static esp_err_t               s_init_err;
+static i2c_master_bus_handle_t s_bus;
+static SemaphoreHandle_t       s_lock;
+static QueueHandle_t           s_queue;
+
+static esp_err_t run_xfer(i2c_master_dev_handle_t dev, const uint8_t *tx, size_t tx_len,
+                          uint8_t *rx, size_t rx_len)
+{
+    if (!i2c_bus_lock(pdMS_TO_TICKS(LOCK_TIMEOUT_MS))) {
+        return ESP_ERR_TIMEOUT;
+    }
+    int timeout_ms = XFER_TIMEOUT_MS + (int)((tx_len + rx_len) / XFER_BYTES_PER_MS);
+    esp_err_t err = rx_len
+        ? i2c_master_transmit_receive(dev, tx, tx_len, rx, rx_len, timeout_ms)
+        : i2c_master_transmit(dev, tx, tx_len, timeout_ms);
+    i2c_bus_unlock();
+    return err;
+}
+
+static void worker_task(void *arg)
+{
+    i2c_bus_xfer_t x;
+    while (1) {
+        if (xQueueReceive(s_queue, &x, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+        esp_err_t err = run_xfer(x.dev, x.tx, x.tx_len, x.rx, x.rx_len);
+        if (err != ESP_OK) {
+            ESP_LOGD(TAG, "queued transfer failed: %s", esp_err_to_name(err));
+        }
+        if (x.cb) {
+            x.cb(err, x.ctx);
+        }
+    }
+}
+
+static esp_err_t do_init(void)
+{
+    i2c_master_bus_config_t cfg = {
+        .i2c_port                     = I2C_PORT,
+        .sda_io_num                   = I2C_PIN_SDA,
+        .scl_io_num                   = I2C_PIN_SCL,
+        .clk_source                   = I2C_CLK_SRC_DEFAULT,
+        .glitch_ignore_cnt            = 7,
+        .flags.enable_internal_pullup = true,
+    };
+    esp_err_t err = i2c_new_master_bus(&cfg, &s_bus);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    s_lock = xSemaphoreCreateRecursiveMutex();
+    s_queue = xQueueCreate(QUEUE_DEPTH, sizeof(i2c_bus_xfer_t));
+    if (s_lock && s_queue &&
+        xTaskCreate(worker_task, "i2c_bus", WORKER_STACK, NULL, WORKER_PRIO, NULL) == pdPASS) {
+        ESP_LOGI(TAG, "I2C%d ready (SCL=IO%d, SDA=IO%d)", I2C_PORT, I2C_PIN_SCL, I2C_PIN_SDA);
+        return ESP_OK;
+    }
+
+    // Undo everything so a failed init leaves nothing behind.
+    if (s_queue) {
+        vQueueDelete(s_queue);
+        s_queue = NULL;
+    }
+    if (s_lock) {
+        vSemaphoreDelete(s_lock);
+        s_lock = NULL;
+    }
+    i2c_del_master_bus(s_bus);
+    s_bus = NULL;
+    return ESP_ERR_NO_MEM;
+}
+
+esp_err_t i2c_bus_init(void)
+{
+    int expected = STATE_NONE;
+    if (atomic_compare_exchange_strong(&s_state, &expected, STATE_INITIALIZING)) {
+        s_init_err = do_init();
+        atomic_store(&s_state, s_init_err == ESP_OK ? STATE_READY : STATE_FAILED);
+        if (s_init_err != ESP_OK) {
+            ESP_LOGE(TAG, "init failed: %s", esp_err_to_name(s_init_err));
+        }
+        return s_init_err;
+    }
+    // Another feature is initializing concurrently; wait for it.
+    while (atomic_load(&s_state) == STATE_INITIALIZING) {
+        vTaskDelay(1);
+    }
+    return atomic_load(&s_state) == STATE_READY ? ESP_OK : s_init_err;
+}
+
+esp_err_t i2c_bus_add_device(uint8_t addr, uint32_t scl_hz, i2c_master_dev_handle_t *out)
+{
+    esp_err_t err = i2c_bus_init();
+    if (err != ESP_OK) {
+        return err;
+    }
+    i2c_device_config_t dev_cfg = {
+        .dev_addr_length = I2C_ADDR_BIT_LEN_7,
+        .device_address  = addr,
+        .scl_speed_hz    = scl_hz,
+    };
+    if (!i2c_bus_lock(pdMS_TO_TICKS(LOCK_TIMEOUT_MS))) {
+        return ESP_ERR_TIMEOUT;
+    }
+    err = i2c_master_bus_add_device(s_bus, &dev_cfg, out);
+    i2c_bus_unlock();
+    return err;
+}
+
+bool i2c_bus_lock(TickType_t wait)
+{
+    return s_lock && xSemaphoreTakeRecursive(s_lock, wait) == pdTRUE;
+}
+
+void i2c_bus_unlock(void)
+{
+    xSemaphoreGiveRecursive(s_lock);
+}
+
+esp_err_t i2c_bus_write(i2c_master_dev_handle_t dev, const uint8_t *data, size_t len)
+{
+    return run_xfer(dev, data, len, NULL, 0);
+}
+
+esp_err_t i2c_bus_write_reg(i2c_master_dev_handle_t dev, uint8_t reg, uint8_t val)
+{
+    uint8_t buf[2] = {reg, val};
+    return run_xfer(dev, buf, sizeof(buf), NULL, 0);
+}
+
+esp_err_t i2c_bus_read_regs(i2c_master_dev_handle_t dev, uint8_t reg, uint8_t *data, size_t len)
+{
+    return run_xfer(dev, &reg, 1, data, len);
+}
+
+esp_err_t i2c_bus_submit(const i2c_bus_xfer_t *xfer, TickType_t wait)
+{
+    if (!xfer || !xfer->dev || xfer->tx_len > I2C_BUS_MAX_TX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (atomic_load(&s_state) != STATE_READY) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    return xQueueSend(s_queue, xfer, wait) == pdTRUE ? ESP_OK : ESP_ERR_TIMEOUT;
+}
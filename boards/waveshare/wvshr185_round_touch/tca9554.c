@@ -0,0 +1,334 @@
+// Copyright 2026 David M. King
+// SPDX-License-Identifier: Apache-2.0
+//
+// TCA9554PWR IO expander service — see tca9554.h.
+
+#include "tca9554.h"
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include "i2c_bus.h"
+#include "driver/gpio.h"
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "freertos/timers.h"
+
+static const char *TAG = "TCA9554";
+
+#define TCA9554_ADDR        0x20
+#define TCA9554_SCL_HZ      400000
+
+// Register map
+#define REG_INPUT           0x00
+#define REG_OUTPUT          0x01
+#define REG_CONFIG          0x03    // 1 = input, 0 = output
+
+#define OUT_UNKNOWN         (-1)
+#define SUBMIT_WAIT_MS      100
+
+enum { STATE_NONE, STATE_INITIALIZING, STATE_READY, STATE_FAILED };
+
+static atomic_int              s_state = STATE_NONE;
+static esp_err_t               s_init_err;
+static i2c_master_dev_handle_t s_dev;
+static SemaphoreHandle_t       s_lock;          // shadows below
+static TimerHandle_t           s_flush_timer;
+
+static uint8_t s_out;               // requested output levels
+static uint8_t s_cfg;               // config register as written
+static int     s_queued;            // last output value sent to the bus, or OUT_UNKNOWN
+static int     s_inflight;          // queued output writes not yet completed
+static bool    s_flush_pending;     // timer armed
+
+// tca9554_flush() waits on its own write reaching the front of the bus queue.
+static SemaphoreHandle_t s_flush_mutex;
+static SemaphoreHandle_t s_flush_done;
+static esp_err_t         s_flush_err;
+
+static TaskHandle_t      s_intr_task;
+static int               s_intr_gpio = -1;
+static tca9554_intr_cb_t s_intr_cb;
+static void             *s_intr_ctx;
+static uint8_t           s_in_last;
+
+static void write_done(esp_err_t err, void *ctx)
+{
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    s_inflight--;
+    if (err != ESP_OK) {
+        s_queued = OUT_UNKNOWN;     // rewrite on the next change or flush
+    }
+    xSemaphoreGive(s_lock);
+
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "output write failed: %s", esp_err_to_name(err));
+    }
+    if (ctx) {
+        s_flush_err = err;
+        xSemaphoreGive(s_flush_done);
+    }
+}
+
+// Queue an output register write. Call with s_lock held; the bus queue is
+// FIFO, so the last value queued is the one the pins end up at.
+static esp_err_t submit_out_locked(uint8_t val, void *ctx)
+{
+    i2c_bus_xfer_t x = {
+        .dev    = s_dev,
+        .tx     = { REG_OUTPUT, val },
+        .tx_len = 2,
+        .cb     = write_done,
+        .ctx    = ctx,
+    };
+    esp_err_t err = i2c_bus_submit(&x, 0);
+    if (err == ESP_OK) {
+        s_queued = val;
+        s_inflight++;
+    }
+    return err;
+}
+
+// Runs on the timer service task one tick after the first tca9554_set_pins()
+// of a burst; everything requested since then goes out as one write.
+static void flush_timer_cb(TimerHandle_t t)
+{
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    s_flush_pending = false;
+    esp_err_t err = ESP_OK;
+    if (s_out != s_queued) {
+        err = submit_out_locked(s_out, NULL);
+    }
+    xSemaphoreGive(s_lock);
+
+    if (err != ESP_OK) {
+        // Bus queue full; leave the shadow dirty for the next change or flush.
+        ESP_LOGW(TAG, "output write not queued: %s", esp_err_to_name(err));
+    }
+}
+
+static esp_err_t do_init(void)
+{
+    s_lock = xSemaphoreCreateMutex();
+    s_flush_mutex = xSemaphoreCreateMutex();
+    s_flush_done = xSemaphoreCreateBinary();
+    s_flush_timer = xTimerCreate("tca9554", 1, pdFALSE, NULL, flush_timer_cb);
+    if (!s_lock || !s_flush_mutex || !s_flush_done || !s_flush_timer) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    esp_err_t err = i2c_bus_add_device(TCA9554_ADDR, TCA9554_SCL_HZ, &s_dev);
+    if (err != ESP_OK) {
+        return err;
+    }
+    // Start from what the chip holds, so nothing a previous boot stage set
+    // is overwritten by a guess.
+    uint8_t out, cfg;
+    err = i2c_bus_read_regs(s_dev, REG_OUTPUT, &out, 1);
+    if (err == ESP_OK) {
+        err = i2c_bus_read_regs(s_dev, REG_CONFIG, &cfg, 1);
+    }
+    if (err != ESP_OK) {
+        return err;
+    }
+    s_out = out;
+    s_queued = out;
+    s_cfg = cfg;
+    ESP_LOGI(TAG, "ready (out=0x%02X, cfg=0x%02X)", out, cfg);
+    return ESP_OK;
+}
+
+esp_err_t tca9554_init(void)
+{
+    int expected = STATE_NONE;
+    if (atomic_compare_exchange_strong(&s_state, &expected, STATE_INITIALIZING)) {
+        s_init_err = do_init();
+        atomic_store(&s_state, s_init_err == ESP_OK ? STATE_READY : STATE_FAILED);
+        if (s_init_err != ESP_OK) {
+            ESP_LOGE(TAG, "init failed: %s", esp_err_to_name(s_init_err));
+        }
+        return s_init_err;
+    }
+    // Another feature is initializing concurrently; wait for it.
+    while (atomic_load(&s_state) == STATE_INITIALIZING) {
+        vTaskDelay(1);
+    }
+    return atomic_load(&s_state) == STATE_READY ? ESP_OK : s_init_err;
+}
+
+static bool ready(void)
+{
+    return atomic_load(&s_state) == STATE_READY;
+}
+
+esp_err_t tca9554_set_pins(uint8_t mask, uint8_t value)
+{
+    if (!ready()) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    s_out = (s_out & ~mask) | (value & mask);
+    bool arm = !s_flush_pending && s_out != s_queued;
+    if (arm) {
+        s_flush_pending = true;
+    }
+    xSemaphoreGive(s_lock);
+
+    if (arm && xTimerStart(s_flush_timer, 0) != pdPASS) {
+        xSemaphoreTake(s_lock, portMAX_DELAY);
+        s_flush_pending = false;
+        xSemaphoreGive(s_lock);
+        return ESP_ERR_TIMEOUT;
+    }
+    return ESP_OK;
+}
+
+uint8_t tca9554_get_outputs(void)
+{
+    return s_out;
+}
+
+esp_err_t tca9554_flush(void)
+{
+    if (!ready()) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    xSemaphoreTake(s_flush_mutex, portMAX_DELAY);
+
+    // Even with the value already queued, queue behind it so we return only
+    // once it has reached the chip. Don't wait for queue space with s_lock
+    // held: the worker needs it to complete the writes ahead of ours.
+    esp_err_t err;
+    bool wait;
+    TickType_t start = xTaskGetTickCount();
+    while (1) {
+        xSemaphoreTake(s_lock, portMAX_DELAY);
+        wait = s_out != s_queued || s_inflight;
+        err = wait ? submit_out_locked(s_out, &s_flush_done) : ESP_OK;
+        xSemaphoreGive(s_lock);
+        if (err != ESP_ERR_TIMEOUT
+            || xTaskGetTickCount() - start >= pdMS_TO_TICKS(SUBMIT_WAIT_MS)) {
+            break;
+        }
+        vTaskDelay(1);
+    }
+    wait = wait && err == ESP_OK;
+
+    if (wait) {
+        xSemaphoreTake(s_flush_done, portMAX_DELAY);
+        err = s_flush_err;
+    }
+    xSemaphoreGive(s_flush_mutex);
+    return err;
+}
+
+esp_err_t tca9554_set_direction(uint8_t mask, uint8_t outputs)
+{
+    if (!ready()) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    // New outputs come up at the level already requested for them.
+    esp_err_t err = tca9554_flush();
+    if (err != ESP_OK) {
+        return err;
+    }
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    uint8_t cfg = (s_cfg & ~mask) | (~outputs & mask);
+    if (cfg != s_cfg) {
+        err = i2c_bus_write_reg(s_dev, REG_CONFIG, cfg);
+        if (err == ESP_OK) {
+            s_cfg = cfg;
+        }
+    }
+    xSemaphoreGive(s_lock);
+    return err;
+}
+
+esp_err_t tca9554_read_inputs(uint8_t *levels)
+{
+    if (!levels) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!ready()) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    return i2c_bus_read_regs(s_dev, REG_INPUT, levels, 1);
+}
+
+// --- Input-change interrupts ---
+
+static void IRAM_ATTR tca9554_isr(void *arg)
+{
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(s_intr_task, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+// Reading the input register releases INT. Keep reading while the line is
+// still low (an input changed again meanwhile), but stop once a read shows
+// no change, so a line held low by something else cannot spin the task.
+static void tca9554_intr_task(void *arg)
+{
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        bool serviced;
+        do {
+            serviced = false;
+            uint8_t levels;
+            if (i2c_bus_read_regs(s_dev, REG_INPUT, &levels, 1) != ESP_OK) {
+                break;
+            }
+            uint8_t changed = (levels ^ s_in_last) & s_cfg;
+            s_in_last = levels;
+            if (changed) {
+                serviced = true;
+                s_intr_cb(changed, levels, s_intr_ctx);
+            }
+        } while (serviced && gpio_get_level(s_intr_gpio) == 0);
+    }
+}
+
+esp_err_t tca9554_intr_start(int int_gpio, tca9554_intr_cb_t cb, void *ctx)
+{
+    if (!cb || int_gpio < 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!ready() || s_intr_task) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    // Baseline for change detection; this read also releases a stale INT.
+    esp_err_t err = i2c_bus_read_regs(s_dev, REG_INPUT, &s_in_last, 1);
+    if (err != ESP_OK) {
+        return err;
+    }
+    s_intr_gpio = int_gpio;
+    s_intr_cb = cb;
+    s_intr_ctx = ctx;
+
+    if (xTaskCreate(tca9554_intr_task, "tca9554_int", 3072, NULL, 5, &s_intr_task) != pdPASS) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    gpio_config_t int_cfg = {
+        .pin_bit_mask = 1ULL << int_gpio,
+        .mode         = GPIO_MODE_INPUT,
+        .pull_up_en   = GPIO_PULLUP_ENABLE,
+        .intr_type    = GPIO_INTR_NEGEDGE,
+    };
+    ESP_ERROR_CHECK(gpio_config(&int_cfg));
+    err = gpio_install_isr_service(0);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+        return err;
+    }
+    err = gpio_isr_handler_add(int_gpio, tca9554_isr, NULL);
+    if (err != ESP_OK) {
+        return err;
+    }
+    // An input may have changed between the baseline read and now.
+    if (gpio_get_level(int_gpio) == 0) {
+        xTaskNotifyGive(s_intr_task);
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,70 @@
+// Copyright 2026 David M. King
+// SPDX-License-Identifier: Apache-2.0
+
+// TCA9554PWR IO expander service (I2C 0x20 on the i2c_bus.c system bus).
+//
+// One owner for the expander, so features share its pins instead of each
+// probing it and overwriting the others' lines. The service keeps shadows
+// of the output and config registers, read back from the chip at init.
+//
+// tca9554_set_pins() only updates the output shadow and returns at once.
+// All changes made within one tick go out as a single register write,
+// queued with i2c_bus_submit(). Call tca9554_flush() when a level must
+// have reached the pin before continuing (e.g. a reset line before talking
+// to the part behind it).
+//
+// Usage:
+//   ESP_ERROR_CHECK(tca9554_init());
+//   tca9554_set_direction(TCA9554_LCD_RST, TCA9554_LCD_RST);   // output
+//   tca9554_set_pins(TCA9554_LCD_RST, 0);
+//   tca9554_flush();
+//   vTaskDelay(pdMS_TO_TICKS(10));
+//   tca9554_set_pins(TCA9554_LCD_RST, TCA9554_LCD_RST);
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Pins, by the board's EXIO numbering (EXIO1 = P0)
+#define TCA9554_EXIO(n)     (1u << ((n) - 1))
+#define TCA9554_TP_RST      TCA9554_EXIO(1)     // touch variant only
+#define TCA9554_LCD_RST     TCA9554_EXIO(2)
+#define TCA9554_SD_D3       TCA9554_EXIO(3)
+
+// Attach to the expander and load the shadows. Safe to call from every
+// feature's init; only the first call does the work.
+esp_err_t tca9554_init(void);
+
+// Make the pins in mask outputs where the matching bit of outputs is set,
+// inputs otherwise. Written immediately (skipped if unchanged).
+esp_err_t tca9554_set_direction(uint8_t mask, uint8_t outputs);
+
+// Set the output levels of the pins in mask to the matching bits of value.
+// Never blocks; the write follows within a tick. Task context only.
+esp_err_t tca9554_set_pins(uint8_t mask, uint8_t value);
+
+// Output levels as requested so far (from the shadow, no bus access).
+uint8_t tca9554_get_outputs(void);
+
+// Block until every pending pin change has been written to the chip.
+esp_err_t tca9554_flush(void);
+
+// Current levels of all pins.
+esp_err_t tca9554_read_inputs(uint8_t *levels);
+
+// Called from the interrupt task with the input pins that changed and the
+// current levels of all pins.
+typedef void (*tca9554_intr_cb_t)(uint8_t changed, uint8_t levels, void *ctx);
+
+// Watch the expander's INT output (active LOW) on int_gpio. The TCA9554
+// raises INT on any input change and clears it when the inputs are read.
+esp_err_t tca9554_intr_start(int int_gpio, tca9554_intr_cb_t cb, void *ctx);
+
+#ifdef __cplusplus
+}
+#endif
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "board_interface.h"
+#include "board_touch_ring.h"
 
 #include <string.h>
 #include "driver/gpio.h"
@@ -13,6 +14,7 @@
 #include "esp_lcd_panel_vendor.h"
 #include "esp_lcd_touch_cst816s.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
@@ -34,14 +36,24 @@
 
 #define PIN_TOUCH_SDA 48
 #define PIN_TOUCH_SCL 47
+// TP_INT is not populated on this board, so touch is polled. On a unit with
+// the INT line wired, set the GPIO here to switch to interrupt-driven reads.
+#define PIN_TOUCH_INT -1
 #define TOUCH_I2C_PORT I2C_NUM_0
 
+#define TOUCH_POLL_MS 50
+// The CST816 pulses INT on every report while a finger is down. If the
+// pulses stop without a release report, re-read once after this long.
+#define TOUCH_RELEASE_TIMEOUT_MS 100
+
 static esp_lcd_panel_handle_t s_panel = NULL;
 static esp_lcd_touch_handle_t s_touch = NULL;
 static uint16_t *s_fb = NULL;
 static SemaphoreHandle_t s_flush_sem = NULL;
 static const char *TAG = "BOARD_WVSHR_2V0_T";
 static bool s_touch_task_started = false;
+static TaskHandle_t s_touch_task = NULL;
+static board_touch_ring_t s_touch_ring;
 
 static inline uint16_t swap_bytes_to_panel_color(uint16_t color)
 {
@@ -94,6 +106,17 @@ static void init_backlight(void)
 
 static void start_touch_logger(void);
 
+// Runs in ISR context (registered through esp_lcd_touch on the INT pin).
+static void touch_int_cb(esp_lcd_touch_handle_t tp)
+{
+    (void)tp;
+    BaseType_t woken = pdFALSE;
+    if (s_touch_task) {
+        vTaskNotifyGiveFromISR(s_touch_task, &woken);
+    }
+    portYIELD_FROM_ISR(woken);
+}
+
 static void init_touch(void)
 {
     i2c_config_t cfg = {
@@ -116,27 +139,43 @@ static void init_touch(void)
         .x_max = LCD_V_RES,
         .y_max = LCD_H_RES,
         .rst_gpio_num = -1,
-        .int_gpio_num = -1,
+        .int_gpio_num = PIN_TOUCH_INT,
         .flags = {
             .swap_xy = 0,
             .mirror_x = 0,
             .mirror_y = 0,
         },
+        .interrupt_callback = touch_int_cb,
     };
     ESP_ERROR_CHECK(esp_lcd_touch_new_i2c_cst816s(tp_io, &touch_cfg, &s_touch));
     start_touch_logger();
 }
 
+// With PIN_TOUCH_INT wired, sleeps until the INT callback signals a report
+// (no idle CPU time or I2C traffic); otherwise polls every TOUCH_POLL_MS.
 static void touch_logger_task(void *arg)
 {
     bool touching = false;
     while (1) {
+        if (PIN_TOUCH_INT >= 0) {
+            TickType_t wait = touching ? pdMS_TO_TICKS(TOUCH_RELEASE_TIMEOUT_MS) : portMAX_DELAY;
+            ulTaskNotifyTake(pdTRUE, wait);
+        } else {
+            vTaskDelay(pdMS_TO_TICKS(TOUCH_POLL_MS));
+        }
+
         if (s_touch) {
             esp_lcd_touch_point_data_t points_data[1] = {0};
             uint8_t point_count = 0;
             esp_lcd_touch_read_data(s_touch);
             esp_err_t err = esp_lcd_touch_get_data(s_touch, points_data, &point_count, 1);
             bool pressed = (err == ESP_OK) && (point_count > 0);
+            board_touch_point_t pt = {
+                .id = 0,
+                .x = (int16_t)points_data[0].x,
+                .y = (int16_t)points_data[0].y,
+            };
+            board_touch_ring_report(&s_touch_ring, &pt, pressed ? 1 : 0, esp_timer_get_time());
             if (pressed) {
                 touching = true;
                 ESP_LOGI(TAG, "Touch (%u,%u)", (unsigned)points_data[0].x, (unsigned)points_data[0].y);
@@ -145,7 +184,6 @@ static void touch_logger_task(void *arg)
                 ESP_LOGI(TAG, "Touch released");
             }
         }
-        vTaskDelay(pdMS_TO_TICKS(50));
     }
 }
 
@@ -154,7 +192,7 @@ static void start_touch_logger(void)
     if (s_touch_task_started) {
         return;
     }
-    BaseType_t ok = xTaskCreate(touch_logger_task, "TouchLogger2", 2048, NULL, 5, NULL);
+    BaseType_t ok = xTaskCreate(touch_logger_task, "TouchLogger2", 2048, NULL, 5, &s_touch_task);
     if (ok == pdPASS) {
         s_touch_task_started = true;
     } else {
@@ -248,14 +286,31 @@ void board_lcd_sanity_test(void)
 
 // --- Display drawing API ---
 
+int board_touch_read(board_touch_point_t *points, int max_points)
+{
+    return board_touch_ring_snapshot(&s_touch_ring, points, max_points);
+}
+
+int board_touch_get_events(board_touch_event_t *events, int max_events)
+{
+    int n = board_touch_ring_pop(&s_touch_ring, events, max_events);
+    if (n > 0) {
+        board_latency_mark(BOARD_LATENCY_TOUCH, events[0].timestamp_us);
+        board_latency_mark(BOARD_LATENCY_DEQUEUE, esp_timer_get_time());
+    }
+    return n;
+}
+
 int board_lcd_width(void) { return LCD_H_RES; }
 int board_lcd_height(void) { return LCD_V_RES; }
 
 void board_lcd_flush(void)
 {
     if (!s_panel || !s_fb) return;
+    board_latency_mark(BOARD_LATENCY_RENDER, esp_timer_get_time());
     esp_lcd_panel_draw_bitmap(s_panel, 0, 0, LCD_H_RES, LCD_V_RES, s_fb);
     xSemaphoreTake(s_flush_sem, portMAX_DELAY);
+    board_latency_mark(BOARD_LATENCY_FLUSH_DONE, esp_timer_get_time());
 }
 
 void board_lcd_clear(void)
@@ -7,9 +7,11 @@
 // Display init ported from gh-stats-dashboard (verified working on hardware).
 
 #include "board_interface.h"
+#include "gt911.h"
 
 #include <string.h>
 #include "driver/gpio.h"
+#include "driver/i2c_master.h"
 #include "driver/ppa.h"
 #include "esp_cache.h"
 #include "esp_heap_caps.h"
@@ -19,6 +21,7 @@
 #include "esp_lcd_st7703.h"
 #include "esp_ldo_regulator.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/semphr.h"
 #include "freertos/task.h"
@@ -40,6 +43,15 @@ static const char *TAG = "BOARD_WVSHR_P4_720";
 #define DSI_BK_LIGHT_GPIO   26   // active LOW: 0 = on
 #define DSI_RST_GPIO        27
 
+// Touch (GT911) on I2C port 0. INT is not routed to the P4 on this board
+// revision, so the driver polls the status register; set the GPIO here on
+// boards that wire it.
+#define TOUCH_I2C_PORT      0
+#define TOUCH_I2C_SDA       7
+#define TOUCH_I2C_SCL       8
+#define TOUCH_INT_GPIO      -1
+#define TOUCH_REPORT_MS     5    // fastest GT911 rate, for smooth drags
+
 // Framebuffer size
 #define FB_SIZE (LCD_W * LCD_H * BPP)
 
@@ -225,6 +237,24 @@ void board_init(void)
     flush_async();
     flush_wait();
 
+    // Touch
+    i2c_master_bus_handle_t i2c_bus = NULL;
+    i2c_master_bus_config_t i2c_cfg = {
+        .i2c_port                     = TOUCH_I2C_PORT,
+        .sda_io_num                   = TOUCH_I2C_SDA,
+        .scl_io_num                   = TOUCH_I2C_SCL,
+        .clk_source                   = I2C_CLK_SRC_DEFAULT,
+        .glitch_ignore_cnt            = 7,
+        .flags.enable_internal_pullup = true,
+    };
+    ESP_ERROR_CHECK(i2c_new_master_bus(&i2c_cfg, &i2c_bus));
+    if (gt911_init(i2c_bus, TOUCH_INT_GPIO)) {
+        esp_err_t err = gt911_set_report_period(TOUCH_REPORT_MS);
+        if (err != ESP_OK) {
+            ESP_LOGW(TAG, "GT911 report period: %s", esp_err_to_name(err));
+        }
+    }
+
     ESP_LOGI(TAG, "%s init done", BOARD_NAME);
 }
 
@@ -243,8 +273,10 @@ void board_lcd_clear(void)
 
 void board_lcd_flush(void)
 {
+    board_latency_mark(BOARD_LATENCY_RENDER, esp_timer_get_time());
     flush_async();
     flush_wait();
+    board_latency_mark(BOARD_LATENCY_FLUSH_DONE, esp_timer_get_time());
 }
 
 void board_lcd_fill(uint16_t color)
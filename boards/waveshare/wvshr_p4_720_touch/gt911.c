@@ -0,0 +1,275 @@
+// Copyright 2026 David M. King
+// SPDX-License-Identifier: Apache-2.0
+//
+// GT911 touch driver — see gt911.h.
+
+#include "gt911.h"
+
+#include <string.h>
+#include "board_interface.h"
+#include "board_touch_ring.h"
+#include "driver/gpio.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#define GT911_ADDR          0x5D
+#define GT911_ADDR_ALT      0x14
+#define GT911_I2C_HZ        400000
+
+// Registers are 16-bit, sent big-endian.
+#define GT911_REG_CONFIG    0x8047   // config block: version .. 0x80FE
+#define GT911_REG_MODULE_SW 0x804D   // bits 1:0 = INT trigger mode
+#define GT911_REG_REFRESH   0x8056   // bits 3:0 = report period - 5 ms
+#define GT911_REG_CHECKSUM  0x80FF
+#define GT911_REG_PRODUCT   0x8140
+#define GT911_REG_STATUS    0x814E   // bit 7 = buffer ready, bits 3:0 = points
+#define GT911_REG_POINTS    0x814F   // first point record
+
+#define GT911_CONFIG_LEN    (GT911_REG_CHECKSUM - GT911_REG_CONFIG)   // 184
+
+// Up to five 8-byte point records follow the status byte:
+//   [0] track id, [1..2] x (LE), [3..4] y (LE), [5..6] size, [7] reserved
+#define GT911_MAX_POINTS    5
+#define GT911_POINT_LEN     8
+#define GT911_STATUS_READY  0x80
+
+#define GT911_PERIOD_MIN_MS 5
+#define GT911_PERIOD_MAX_MS 20
+
+// While a finger is down the GT911 signals every report. If INT stops
+// without an empty report, re-read once after this long.
+#define TOUCH_RELEASE_TIMEOUT_MS 100
+
+static const char *TAG = "GT911";
+
+static i2c_master_dev_handle_t s_dev        = NULL;
+static TaskHandle_t            s_touch_task = NULL;
+static board_touch_ring_t      s_touch_ring;
+static int                     s_int_gpio   = -1;
+static int                     s_period_ms  = 10;
+
+static esp_err_t gt911_read(uint16_t reg, uint8_t *data, size_t len)
+{
+    uint8_t addr[2] = { reg >> 8, reg & 0xFF };
+    return i2c_master_transmit_receive(s_dev, addr, sizeof(addr), data, len, 50);
+}
+
+static esp_err_t gt911_write(uint16_t reg, const uint8_t *data, size_t len)
+{
+    uint8_t buf[2 + GT911_CONFIG_LEN + 2];
+    if (len > sizeof(buf) - 2) return ESP_ERR_INVALID_ARG;
+    buf[0] = reg >> 8;
+    buf[1] = reg & 0xFF;
+    if (len) memcpy(&buf[2], data, len);
+    return i2c_master_transmit(s_dev, buf, len + 2, 50);
+}
+
+// Read one report. Returns the number of points written to pts (0 = no
+// touch), or -1 if there was no new report or the bus read failed.
+// Only the status byte is read until a report is ready, and then only the
+// records it announces, so idle polling costs a 1-byte read.
+static int gt911_read_points(board_touch_point_t *pts)
+{
+    uint8_t status;
+    if (gt911_read(GT911_REG_STATUS, &status, 1) != ESP_OK) {
+        return -1;
+    }
+    if (!(status & GT911_STATUS_READY)) {
+        return -1;
+    }
+
+    int count = status & 0x0F;
+    uint8_t buf[GT911_MAX_POINTS * GT911_POINT_LEN];
+    esp_err_t err = ESP_OK;
+    if (count > 0 && count <= GT911_MAX_POINTS) {
+        err = gt911_read(GT911_REG_POINTS, buf, count * GT911_POINT_LEN);
+    }
+
+    // Release the buffer so the next report can be latched.
+    uint8_t zero = 0;
+    gt911_write(GT911_REG_STATUS, &zero, 1);
+
+    if (err != ESP_OK || count > GT911_MAX_POINTS) {
+        return -1;
+    }
+
+    const int lw = board_lcd_width();
+    const int lh = board_lcd_height();
+    int n = 0;
+    for (int i = 0; i < count; i++) {
+        const uint8_t *p = &buf[i * GT911_POINT_LEN];
+        int x = p[1] | (p[2] << 8);
+        int y = p[3] | (p[4] << 8);
+        if (x >= lw || y >= lh) {
+            continue;
+        }
+        pts[n].id = p[0];
+        pts[n].x = x;
+        pts[n].y = y;
+        n++;
+    }
+    return n;
+}
+
+static void IRAM_ATTR touch_int_isr(void *arg)
+{
+    BaseType_t woken = pdFALSE;
+    if (s_touch_task) {
+        vTaskNotifyGiveFromISR(s_touch_task, &woken);
+    }
+    portYIELD_FROM_ISR(woken);
+}
+
+// With INT wired, sleeps until a report is signalled; a missing signal while
+// touching triggers one re-read so a lost release cannot leave a stuck
+// contact. Without INT, polls the status byte at the report period.
+static void touch_task(void *arg)
+{
+    bool touching = false;
+    while (1) {
+        if (s_int_gpio >= 0) {
+            TickType_t wait = touching ? pdMS_TO_TICKS(TOUCH_RELEASE_TIMEOUT_MS) : portMAX_DELAY;
+            ulTaskNotifyTake(pdTRUE, wait);
+        } else {
+            vTaskDelay(pdMS_TO_TICKS(s_period_ms));
+        }
+
+        board_touch_point_t pts[GT911_MAX_POINTS];
+        int n = gt911_read_points(pts);
+        if (n < 0) {
+            continue;
+        }
+        board_touch_ring_report(&s_touch_ring, pts, n, esp_timer_get_time());
+        touching = n > 0;
+    }
+}
+
+// Match the GPIO edge to the trigger mode in the controller's config.
+// Level modes are treated as the edge that starts the level.
+static gpio_int_type_t int_type_from_config(void)
+{
+    uint8_t sw = 0;
+    if (gt911_read(GT911_REG_MODULE_SW, &sw, 1) != ESP_OK) {
+        return GPIO_INTR_NEGEDGE;
+    }
+    switch (sw & 0x03) {
+    case 0:  return GPIO_INTR_POSEDGE;
+    case 3:  return GPIO_INTR_POSEDGE;
+    default: return GPIO_INTR_NEGEDGE;
+    }
+}
+
+static void start_touch_task(void)
+{
+    if (xTaskCreate(touch_task, "TouchGT911", 3072, NULL, 5, &s_touch_task) != pdPASS) {
+        ESP_LOGW(TAG, "Failed to start touch task");
+        return;
+    }
+    if (s_int_gpio < 0) {
+        ESP_LOGI(TAG, "INT not wired, polling every %d ms", s_period_ms);
+        return;
+    }
+
+    gpio_config_t int_cfg = {
+        .pin_bit_mask = 1ULL << s_int_gpio,
+        .mode         = GPIO_MODE_INPUT,
+        .pull_up_en   = GPIO_PULLUP_DISABLE,
+        .pull_down_en = GPIO_PULLDOWN_DISABLE,
+        .intr_type    = int_type_from_config(),
+    };
+    ESP_ERROR_CHECK(gpio_config(&int_cfg));
+
+    esp_err_t err = gpio_install_isr_service(0);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+        ESP_LOGW(TAG, "GPIO ISR service: %s", esp_err_to_name(err));
+        return;
+    }
+    gpio_isr_handler_add(s_int_gpio, touch_int_isr, NULL);
+}
+
+esp_err_t gt911_set_report_period(int period_ms)
+{
+    if (!s_dev) return ESP_ERR_INVALID_STATE;
+    if (period_ms < GT911_PERIOD_MIN_MS || period_ms > GT911_PERIOD_MAX_MS) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // The whole block plus checksum and the "config fresh" flag are written
+    // back together; the controller rejects a block with a bad checksum.
+    uint8_t cfg[GT911_CONFIG_LEN + 2];
+    esp_err_t err = gt911_read(GT911_REG_CONFIG, cfg, GT911_CONFIG_LEN);
+    if (err != ESP_OK) return err;
+
+    uint8_t *refresh = &cfg[GT911_REG_REFRESH - GT911_REG_CONFIG];
+    uint8_t want = (*refresh & 0xF0) | (uint8_t)(period_ms - GT911_PERIOD_MIN_MS);
+    if (*refresh == want) {
+        s_period_ms = period_ms;
+        return ESP_OK;
+    }
+    *refresh = want;
+
+    uint8_t sum = 0;
+    for (int i = 0; i < GT911_CONFIG_LEN; i++) {
+        sum += cfg[i];
+    }
+    cfg[GT911_CONFIG_LEN]     = (uint8_t)(~sum + 1);
+    cfg[GT911_CONFIG_LEN + 1] = 1;
+    err = gt911_write(GT911_REG_CONFIG, cfg, sizeof(cfg));
+    if (err != ESP_OK) return err;
+
+    s_period_ms = period_ms;
+    ESP_LOGI(TAG, "Report period set to %d ms", period_ms);
+    return ESP_OK;
+}
+
+int board_touch_read(board_touch_point_t *points, int max_points)
+{
+    return board_touch_ring_snapshot(&s_touch_ring, points, max_points);
+}
+
+int board_touch_get_events(board_touch_event_t *events, int max_events)
+{
+    int n = board_touch_ring_pop(&s_touch_ring, events, max_events);
+    if (n > 0) {
+        board_latency_mark(BOARD_LATENCY_TOUCH, events[0].timestamp_us);
+        board_latency_mark(BOARD_LATENCY_DEQUEUE, esp_timer_get_time());
+    }
+    return n;
+}
+
+bool gt911_init(i2c_master_bus_handle_t bus, int int_gpio)
+{
+    uint16_t addr = GT911_ADDR;
+    if (i2c_master_probe(bus, addr, 100) != ESP_OK) {
+        addr = GT911_ADDR_ALT;
+        if (i2c_master_probe(bus, addr, 100) != ESP_OK) {
+            ESP_LOGW(TAG, "No GT911 at 0x%02X or 0x%02X", GT911_ADDR, GT911_ADDR_ALT);
+            return false;
+        }
+    }
+
+    i2c_device_config_t dev_cfg = {
+        .dev_addr_length = I2C_ADDR_BIT_LEN_7,
+        .device_address  = addr,
+        .scl_speed_hz    = GT911_I2C_HZ,
+    };
+    ESP_ERROR_CHECK(i2c_master_bus_add_device(bus, &dev_cfg, &s_dev));
+
+    uint8_t id[4] = {0};
+    uint8_t refresh = 0;
+    gt911_read(GT911_REG_PRODUCT, id, sizeof(id));
+    if (gt911_read(GT911_REG_REFRESH, &refresh, 1) == ESP_OK) {
+        s_period_ms = GT911_PERIOD_MIN_MS + (refresh & 0x0F);
+    }
+    ESP_LOGI(TAG, "GT%.4s at 0x%02X, report period %d ms", (const char *)id, addr, s_period_ms);
+
+    // Drop any report latched before we were listening.
+    uint8_t zero = 0;
+    gt911_write(GT911_REG_STATUS, &zero, 1);
+
+    s_int_gpio = int_gpio;
+    start_touch_task();
+    return true;
+}
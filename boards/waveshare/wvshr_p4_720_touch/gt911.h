@@ -0,0 +1,34 @@
+// Copyright 2026 David M. King
+// SPDX-License-Identifier: Apache-2.0
+
+// GT911 capacitive touch driver on the i2c_master bus.
+//
+// A background task waits for the INT data-ready edge (or polls at the
+// report period when INT is not wired), reads the status byte and, once a
+// report is ready, the point records it announces, clears the status
+// register, and feeds the board touch event ring behind
+// board_touch_read()/board_touch_get_events().
+
+#pragma once
+
+#include <stdbool.h>
+#include "driver/i2c_master.h"
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Probe the GT911 (0x5D, then 0x14) on bus and start the touch task.
+// int_gpio is the data-ready line, or -1 to poll. Returns false if no
+// controller answered.
+bool gt911_init(i2c_master_bus_handle_t bus, int int_gpio);
+
+// Request a coordinate report period of period_ms (5..20; the GT911 reports
+// every 5 + N ms). Rewrites the config block with a fresh checksum only if
+// the period differs from the current one.
+esp_err_t gt911_set_report_period(int period_ms);
+
+#ifdef __cplusplus
+}
+#endif
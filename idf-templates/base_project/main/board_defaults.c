@@ -16,3 +16,10 @@ __attribute__((weak)) void board_lcd_set_pixel_rgb(int x, int y, uint8_t r, uint
 __attribute__((weak)) uint16_t board_lcd_pack_rgb(uint8_t r, uint8_t g, uint8_t b) { (void)r; (void)g; (void)b; return 0; }
 __attribute__((weak)) uint16_t board_lcd_get_pixel_raw(int x, int y) { (void)x; (void)y; return 0; }
 __attribute__((weak)) void board_lcd_unpack_rgb(uint16_t color, uint8_t *r, uint8_t *g, uint8_t *b) { (void)color; if (r) *r = 0; if (g) *g = 0; if (b) *b = 0; }
+
+// Default touch API for boards without a touch controller.
+__attribute__((weak)) int board_touch_read(board_touch_point_t *points, int max_points) { (void)points; (void)max_points; return 0; }
+__attribute__((weak)) int board_touch_get_events(board_touch_event_t *events, int max_events) { (void)events; (void)max_events; return 0; }
+
+// Latency instrumentation is off unless the --latency module is linked in.
+__attribute__((weak)) void board_latency_mark(board_latency_stage_t stage, int64_t timestamp_us) { (void)stage; (void)timestamp_us; }
@@ -46,3 +46,51 @@ uint16_t board_lcd_get_pixel_raw(int x, int y);
 
 // Extract RGB888 components from a raw pixel value.
 void board_lcd_unpack_rgb(uint16_t color, uint8_t *r, uint8_t *g, uint8_t *b);
+
+// ---------------------------------------------------------------------------
+// Touch API — boards with a touch controller implement these, fed by their
+// touch task/ISR through board_touch_ring.h. Weak defaults in
+// board_defaults.c report no touch for other boards.
+// ---------------------------------------------------------------------------
+
+#define BOARD_TOUCH_MAX_POINTS 5
+
+typedef enum {
+    BOARD_TOUCH_PRESS,
+    BOARD_TOUCH_MOVE,
+    BOARD_TOUCH_RELEASE,
+} board_touch_event_type_t;
+
+typedef struct {
+    uint8_t id;             // contact id (always 0 on single-touch controllers)
+    int16_t x;              // display coordinates
+    int16_t y;
+} board_touch_point_t;
+
+typedef struct {
+    board_touch_event_type_t type;
+    board_touch_point_t point;
+    int64_t timestamp_us;   // esp_timer time the sample was taken
+} board_touch_event_t;
+
+// Current contacts. Returns the number written to points (0 = not touched).
+int board_touch_read(board_touch_point_t *points, int max_points);
+
+// Drain up to max_events queued events, oldest first. Returns the number
+// copied. Lock-free; call from a single consumer task (e.g. the UI loop).
+int board_touch_get_events(board_touch_event_t *events, int max_events);
+
+// ---------------------------------------------------------------------------
+// Latency instrumentation — touch boards mark each stage of the
+// touch-to-photon path. The weak default is a no-op; the --latency module
+// overrides it to collect histograms (see latency.h).
+// ---------------------------------------------------------------------------
+
+typedef enum {
+    BOARD_LATENCY_TOUCH,        // touch IRQ/poll sample (event timestamp)
+    BOARD_LATENCY_DEQUEUE,      // events drained by board_touch_get_events()
+    BOARD_LATENCY_RENDER,       // render complete: board_lcd_flush() entered
+    BOARD_LATENCY_FLUSH_DONE,   // flush DMA complete, pixels on glass
+} board_latency_stage_t;
+
+void board_latency_mark(board_latency_stage_t stage, int64_t timestamp_us);
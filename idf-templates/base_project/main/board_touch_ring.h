@@ -0,0 +1,160 @@
+// Copyright 2026 David M. King
+// SPDX-License-Identifier: Apache-2.0
+
+// Lock-free single-producer/single-consumer touch event ring used by board
+// implementations to back board_touch_read() / board_touch_get_events().
+//
+// Producer: the board's touch task (or ISR) calls board_touch_ring_report()
+// with every controller sample; contacts are diffed against the previous
+// sample to emit PRESS / MOVE / RELEASE events. Consumer: the app drains
+// events with board_touch_get_events(). When the ring is full new events are
+// dropped and counted, so a stalled consumer never blocks the producer.
+//
+// A board typically needs only:
+//
+//   static board_touch_ring_t s_touch_ring;
+//
+//   int board_touch_read(board_touch_point_t *points, int max_points)
+//   {
+//       return board_touch_ring_snapshot(&s_touch_ring, points, max_points);
+//   }
+//
+//   int board_touch_get_events(board_touch_event_t *events, int max_events)
+//   {
+//       return board_touch_ring_pop(&s_touch_ring, events, max_events);
+//   }
+
+#pragma once
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "board_interface.h"
+
+#define BOARD_TOUCH_RING_SIZE 64    // events; must be a power of two
+#define BOARD_TOUCH_SNAP_SPINS 4    // retries before falling back to the last good copy
+
+typedef struct {
+    board_touch_event_t events[BOARD_TOUCH_RING_SIZE];
+    atomic_uint head;               // next slot written by the producer
+    atomic_uint tail;               // next slot read by the consumer
+    atomic_uint dropped;            // events lost to a full ring
+
+    // Producer-side contact state, used to derive press/move/release.
+    board_touch_point_t down[BOARD_TOUCH_MAX_POINTS];
+    int down_count;
+
+    // Latest contacts for board_touch_read(), published seqlock-style.
+    atomic_uint snap_seq;
+    board_touch_point_t snap[BOARD_TOUCH_MAX_POINTS];
+    int snap_count;
+
+    // Consumer-side copy of the last consistent snapshot.
+    board_touch_point_t last[BOARD_TOUCH_MAX_POINTS];
+    int last_count;
+} board_touch_ring_t;
+
+static inline bool board_touch_ring_push(board_touch_ring_t *r, const board_touch_event_t *ev)
+{
+    unsigned head = atomic_load_explicit(&r->head, memory_order_relaxed);
+    unsigned tail = atomic_load_explicit(&r->tail, memory_order_acquire);
+    if (head - tail >= BOARD_TOUCH_RING_SIZE) {
+        atomic_fetch_add_explicit(&r->dropped, 1, memory_order_relaxed);
+        return false;
+    }
+    r->events[head & (BOARD_TOUCH_RING_SIZE - 1)] = *ev;
+    atomic_store_explicit(&r->head, head + 1, memory_order_release);
+    return true;
+}
+
+static inline int board_touch_ring_pop(board_touch_ring_t *r, board_touch_event_t *out, int max)
+{
+    unsigned tail = atomic_load_explicit(&r->tail, memory_order_relaxed);
+    unsigned head = atomic_load_explicit(&r->head, memory_order_acquire);
+    int n = 0;
+    while (n < max && tail != head) {
+        out[n++] = r->events[tail & (BOARD_TOUCH_RING_SIZE - 1)];
+        tail++;
+    }
+    atomic_store_explicit(&r->tail, tail, memory_order_release);
+    return n;
+}
+
+static inline void board_touch_ring_emit(board_touch_ring_t *r, board_touch_event_type_t type,
+                                         const board_touch_point_t *pt, int64_t ts_us)
+{
+    board_touch_event_t ev = { .type = type, .point = *pt, .timestamp_us = ts_us };
+    board_touch_ring_push(r, &ev);
+}
+
+// Feed one controller sample: the `n` contacts currently down (n = 0 when
+// the panel reports no touch). Producer side only.
+static inline void board_touch_ring_report(board_touch_ring_t *r, const board_touch_point_t *pts,
+                                           int n, int64_t ts_us)
+{
+    if (n > BOARD_TOUCH_MAX_POINTS) n = BOARD_TOUCH_MAX_POINTS;
+
+    // Releases: contacts that were down and are no longer reported.
+    for (int i = 0; i < r->down_count; i++) {
+        bool still = false;
+        for (int j = 0; j < n; j++) {
+            if (pts[j].id == r->down[i].id) { still = true; break; }
+        }
+        if (!still) board_touch_ring_emit(r, BOARD_TOUCH_RELEASE, &r->down[i], ts_us);
+    }
+
+    // Presses for new contacts, moves for contacts whose position changed.
+    for (int j = 0; j < n; j++) {
+        const board_touch_point_t *prev = NULL;
+        for (int i = 0; i < r->down_count; i++) {
+            if (r->down[i].id == pts[j].id) { prev = &r->down[i]; break; }
+        }
+        if (!prev) {
+            board_touch_ring_emit(r, BOARD_TOUCH_PRESS, &pts[j], ts_us);
+        } else if (prev->x != pts[j].x || prev->y != pts[j].y) {
+            board_touch_ring_emit(r, BOARD_TOUCH_MOVE, &pts[j], ts_us);
+        }
+    }
+
+    for (int j = 0; j < n; j++) r->down[j] = pts[j];
+    r->down_count = n;
+
+    unsigned seq = atomic_load_explicit(&r->snap_seq, memory_order_relaxed);
+    atomic_store_explicit(&r->snap_seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    for (int j = 0; j < n; j++) r->snap[j] = pts[j];
+    r->snap_count = n;
+    atomic_store_explicit(&r->snap_seq, seq + 2, memory_order_release);
+}
+
+// Copy the latest contacts (consumer side). Retries if the producer was
+// mid-update, so the result is always one consistent sample. A consumer of
+// higher priority on the producer's core would starve it by spinning, so
+// after a few tries it returns the last consistent sample instead; it
+// never sleeps, and never reports a release the panel did not.
+static inline int board_touch_ring_snapshot(board_touch_ring_t *r, board_touch_point_t *out, int max)
+{
+    for (int attempt = 0; attempt < BOARD_TOUCH_SNAP_SPINS; attempt++) {
+        unsigned seq = atomic_load_explicit(&r->snap_seq, memory_order_acquire);
+        if (seq & 1) continue;
+        int n = r->snap_count;
+        if (n < 0 || n > BOARD_TOUCH_MAX_POINTS) continue;
+        board_touch_point_t pts[BOARD_TOUCH_MAX_POINTS];
+        for (int j = 0; j < n; j++) pts[j] = r->snap[j];
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&r->snap_seq, memory_order_relaxed) != seq) continue;
+        for (int j = 0; j < n; j++) r->last[j] = pts[j];
+        r->last_count = n;
+        break;
+    }
+    int n = r->last_count < max ? r->last_count : max;
+    for (int j = 0; j < n; j++) out[j] = r->last[j];
+    return n;
+}
+
+static inline unsigned board_touch_ring_dropped(board_touch_ring_t *r)
+{
+    return atomic_load_explicit(&r->dropped, memory_order_relaxed);
+}
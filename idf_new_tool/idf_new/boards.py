@@ -25,6 +25,17 @@ class BoardScreen:
     height: int | None = None
 
 
+@dataclass(slots=True)
+class BoardBus:
+    """Display bus parameters used by the sim's bandwidth model."""
+    type: str                       # spi, qspi, i80, mipi-dsi
+    clock_hz: int                   # SCLK / PCLK, or per-lane bit rate for DSI
+    data_lines: int = 1             # bits moved per clock (1 SPI, 4 QSPI, 8 i80, DSI lanes)
+    bits_per_pixel: int = 16
+    overhead_us: float = 0.0        # fixed cost per transaction (window setup, queueing)
+    max_transfer_bytes: int = 0     # driver chunk size; 0 = one transaction per window
+
+
 @dataclass(slots=True)
 class BoardInfo:
     board_id: str
@@ -35,6 +46,7 @@ class BoardInfo:
     has_touch: bool
     screen: BoardScreen | None
     panel: str | None = None
+    bus: BoardBus | None = None
 
 
 def _board_dirs() -> list[Path]:
@@ -74,6 +86,21 @@ def _load_board_info(board_id: str, directory: Path) -> BoardInfo:
             height=h,
         )
 
+    bus = None
+    bus_data = data.get("bus")
+    if isinstance(bus_data, dict):
+        try:
+            bus = BoardBus(
+                type=str(bus_data["type"]),
+                clock_hz=int(bus_data["clock_hz"]),
+                data_lines=int(bus_data.get("data_lines", 1)),
+                bits_per_pixel=int(bus_data.get("bits_per_pixel", 16)),
+                overhead_us=float(bus_data.get("overhead_us", 0.0)),
+                max_transfer_bytes=int(bus_data.get("max_transfer_bytes", 0)),
+            )
+        except (KeyError, TypeError, ValueError):
+            bus = None
+
     def _str_list(raw: Any) -> list[str]:
         if not isinstance(raw, list):
             return []
@@ -94,6 +121,7 @@ def _load_board_info(board_id: str, directory: Path) -> BoardInfo:
         has_touch=has_touch,
         screen=screen,
         panel=panel,
+        bus=bus,
     )
 
 
@@ -0,0 +1,46 @@
+# Copyright 2026 David M. King
+# SPDX-License-Identifier: Apache-2.0
+
+"""Framebuffer capture module (--fbrec).
+
+Copies fbrec.c/fbrec.h into main/: a recorder that writes every flushed
+window to a compact XOR/RLE delta stream (normally on the TF card), plus the
+reader used by the sim's replay tool. When combined with --sim, the sim can
+record with --record <file> and builds <project>_replay, which plays a
+capture back and prints per-frame changed-pixel statistics.
+"""
+
+from __future__ import annotations
+
+from .base import ModuleContext, register
+from ..paths import MODULES_DIR
+
+_COMMON = MODULES_DIR / "fbrec" / "_common"
+
+
+class FbrecModule:
+    name = "Framebuffer capture/replay (delta-compressed flush recorder)"
+    flag = "fbrec"
+    category = "Sim"
+
+    def apply(self, ctx: ModuleContext) -> None:
+        for fname in ("fbrec.c", "fbrec.h"):
+            (ctx.main_dir / fname).write_bytes((_COMMON / fname).read_bytes())
+
+        cmake = ctx.cmake_extra_path
+        existing = cmake.read_text(encoding="utf-8") if cmake.exists() else ""
+        cmake.write_text(
+            existing.rstrip() + '\nlist(APPEND EXTRA_SRCS "fbrec.c")\n',
+            encoding="utf-8",
+        )
+
+        kconfig_dst = ctx.main_dir / "Kconfig.projbuild"
+        snippet = (_COMMON / "Kconfig").read_text(encoding="utf-8").rstrip()
+        if kconfig_dst.exists():
+            existing = kconfig_dst.read_text(encoding="utf-8").rstrip()
+            kconfig_dst.write_text(existing + "\n\n" + snippet + "\n", encoding="utf-8")
+        else:
+            kconfig_dst.write_text(snippet + "\n", encoding="utf-8")
+
+
+register(FbrecModule())
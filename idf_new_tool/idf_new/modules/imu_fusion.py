@@ -0,0 +1,36 @@
+# Copyright 2026 David M. King
+# SPDX-License-Identifier: Apache-2.0
+
+"""IMU sensor-fusion module (--imu-fusion).
+
+Copies imu_fusion.c/imu_fusion.h into main/: Madgwick and Mahony
+orientation filters over gyro + accelerometer samples, each in float and in
+libm-free fixed point, with quaternion and Euler-angle output.
+"""
+
+from __future__ import annotations
+
+from .base import ModuleContext, register
+from ..paths import MODULES_DIR
+
+_COMMON = MODULES_DIR / "imu_fusion" / "_common"
+
+
+class ImuFusionModule:
+    name = "IMU orientation fusion (Madgwick/Mahony, float and fixed point)"
+    flag = "imu_fusion"
+    category = "IMU"
+
+    def apply(self, ctx: ModuleContext) -> None:
+        for fname in ("imu_fusion.c", "imu_fusion.h"):
+            (ctx.main_dir / fname).write_bytes((_COMMON / fname).read_bytes())
+
+        cmake = ctx.cmake_extra_path
+        existing = cmake.read_text(encoding="utf-8") if cmake.exists() else ""
+        cmake.write_text(
+            existing.rstrip() + '\nlist(APPEND EXTRA_SRCS "imu_fusion.c")\n',
+            encoding="utf-8",
+        )
+
+
+register(ImuFusionModule())
@@ -0,0 +1,45 @@
+# Copyright 2026 David M. King
+# SPDX-License-Identifier: Apache-2.0
+
+"""Touch-to-photon latency module (--latency).
+
+Copies latency.c/latency.h into main/. latency.c overrides the weak
+board_latency_mark() hook that touch boards call at each stage (touch
+sample, event dequeue, render complete, flush DMA done) and keeps
+p50/p95/p99 histograms, reported on the console and via latency_get_stats().
+"""
+
+from __future__ import annotations
+
+from .base import ModuleContext, register
+from ..paths import MODULES_DIR
+
+_COMMON = MODULES_DIR / "latency" / "_common"
+
+
+class LatencyModule:
+    name = "Touch-to-photon latency histograms (p50/p95/p99)"
+    flag = "latency"
+    category = "Debug"
+
+    def apply(self, ctx: ModuleContext) -> None:
+        for fname in ("latency.c", "latency.h"):
+            (ctx.main_dir / fname).write_bytes((_COMMON / fname).read_bytes())
+
+        cmake = ctx.cmake_extra_path
+        existing = cmake.read_text(encoding="utf-8") if cmake.exists() else ""
+        cmake.write_text(
+            existing.rstrip() + '\nlist(APPEND EXTRA_SRCS "latency.c")\n',
+            encoding="utf-8",
+        )
+
+        kconfig_dst = ctx.main_dir / "Kconfig.projbuild"
+        snippet = (_COMMON / "Kconfig").read_text(encoding="utf-8").rstrip()
+        if kconfig_dst.exists():
+            existing = kconfig_dst.read_text(encoding="utf-8").rstrip()
+            kconfig_dst.write_text(existing + "\n\n" + snippet + "\n", encoding="utf-8")
+        else:
+            kconfig_dst.write_text(snippet + "\n", encoding="utf-8")
+
+
+register(LatencyModule())
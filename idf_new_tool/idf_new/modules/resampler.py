@@ -0,0 +1,48 @@
+# Copyright 2026 David M. King
+# SPDX-License-Identifier: Apache-2.0
+
+"""Sample-rate converter module (--resampler).
+
+Copies resampler.c/resampler.h into main/: a streaming polyphase FIR
+resampler for 16-bit PCM between any two rates (8/16/22.05/44.1/48 kHz),
+with Q15 coefficients. Merges esp-dsp into the manifest and a Kconfig
+fragment that routes the dot products through it on the ESP32-S3.
+"""
+
+from __future__ import annotations
+
+from .base import ModuleContext, register
+from ..manifest import merge_manifests
+from ..paths import MODULES_DIR
+
+_COMMON = MODULES_DIR / "resampler" / "_common"
+
+
+class ResamplerModule:
+    name = "Polyphase sample-rate converter (Q15, esp-dsp on S3)"
+    flag = "resampler"
+    category = "Audio"
+
+    def apply(self, ctx: ModuleContext) -> None:
+        for fname in ("resampler.c", "resampler.h"):
+            (ctx.main_dir / fname).write_bytes((_COMMON / fname).read_bytes())
+
+        cmake = ctx.cmake_extra_path
+        existing = cmake.read_text(encoding="utf-8") if cmake.exists() else ""
+        cmake.write_text(
+            existing.rstrip() + '\nlist(APPEND EXTRA_SRCS "resampler.c")\n',
+            encoding="utf-8",
+        )
+
+        merge_manifests(ctx.main_dir / "idf_component.yml", _COMMON / "idf_component.yml")
+
+        kconfig_dst = ctx.main_dir / "Kconfig.projbuild"
+        snippet = (_COMMON / "Kconfig").read_text(encoding="utf-8").rstrip()
+        if kconfig_dst.exists():
+            existing = kconfig_dst.read_text(encoding="utf-8").rstrip()
+            kconfig_dst.write_text(existing + "\n\n" + snippet + "\n", encoding="utf-8")
+        else:
+            kconfig_dst.write_text(snippet + "\n", encoding="utf-8")
+
+
+register(ResamplerModule())
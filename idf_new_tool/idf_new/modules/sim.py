@@ -6,6 +6,9 @@
 Adds a sim/ directory to the project with:
   - CMakeLists.txt wired to esp32-screencap via git submodule
   - main_sim.c starter (gradient smoke-test + screencap loop)
+  - sim_bus.c bus bandwidth model, parameterised from the board.json "bus"
+    section, that reports predicted per-frame bus time and FPS
+  - fbrec_replay.c capture player, built when the --fbrec module is present
   - screencap added as sim/screencap git submodule
 
 Only meaningful for boards that have an LCD with known dimensions.
@@ -19,6 +22,7 @@ import subprocess
 from pathlib import Path
 
 from .base import ModuleContext, register
+from ..boards import BoardBus
 from ..paths import MODULES_DIR
 
 _COMMON = MODULES_DIR / "sim" / "_common"
@@ -41,6 +45,8 @@ class SimModule:
         w = board.screen.width
         h = board.screen.height
 
+        bus = board.bus or BoardBus(type="none", clock_hz=0)
+
         sim_dir = ctx.project_dir / "sim"
         shutil.copytree(_COMMON, sim_dir)
 
@@ -50,14 +56,20 @@ class SimModule:
         text = (text
                 .replace("__PROJECT_NAME__", ctx.project_dir.name)
                 .replace("__BOARD_WIDTH__",  str(w))
-                .replace("__BOARD_HEIGHT__", str(h)))
+                .replace("__BOARD_HEIGHT__", str(h))
+                .replace("__BUS_TYPE__", bus.type)
+                .replace("__BUS_CLOCK_HZ__", str(bus.clock_hz))
+                .replace("__BUS_DATA_LINES__", str(bus.data_lines))
+                .replace("__BUS_BITS_PER_PIXEL__", str(bus.bits_per_pixel))
+                .replace("__BUS_OVERHEAD_US__", f"{bus.overhead_us:g}")
+                .replace("__BUS_MAX_TRANSFER_BYTES__", str(bus.max_transfer_bytes)))
         cmake.write_text(text, encoding="utf-8")
 
-        # Replace placeholder in main_sim.c
-        main_sim = sim_dir / "main_sim.c"
-        text = main_sim.read_text(encoding="utf-8")
-        text = text.replace("__PROJECT_NAME__", ctx.project_dir.name)
-        main_sim.write_text(text, encoding="utf-8")
+        # Replace the project name placeholder in the C sources
+        for src in sorted(sim_dir.glob("*.c")):
+            text = src.read_text(encoding="utf-8")
+            text = text.replace("__PROJECT_NAME__", ctx.project_dir.name)
+            src.write_text(text, encoding="utf-8")
 
         # git init the project (idempotent), then add screencap submodule
         subprocess.run(["git", "init"], cwd=ctx.project_dir, capture_output=True)
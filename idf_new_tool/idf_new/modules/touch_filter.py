@@ -0,0 +1,36 @@
+# Copyright 2026 David M. King
+# SPDX-License-Identifier: Apache-2.0
+
+"""Predictive touch filter module (--touch-filter).
+
+Copies touch_filter.c/touch_filter.h into main/: a fixed-point one-euro
+filter over the board touch event stream plus velocity extrapolation to the
+expected flush-complete time, so dragged content keeps up with the finger.
+"""
+
+from __future__ import annotations
+
+from .base import ModuleContext, register
+from ..paths import MODULES_DIR
+
+_COMMON = MODULES_DIR / "touch_filter" / "_common"
+
+
+class TouchFilterModule:
+    name = "Predictive touch smoothing (one-euro filter + extrapolation)"
+    flag = "touch_filter"
+    category = "Touch"
+
+    def apply(self, ctx: ModuleContext) -> None:
+        for fname in ("touch_filter.c", "touch_filter.h"):
+            (ctx.main_dir / fname).write_bytes((_COMMON / fname).read_bytes())
+
+        cmake = ctx.cmake_extra_path
+        existing = cmake.read_text(encoding="utf-8") if cmake.exists() else ""
+        cmake.write_text(
+            existing.rstrip() + '\nlist(APPEND EXTRA_SRCS "touch_filter.c")\n',
+            encoding="utf-8",
+        )
+
+
+register(TouchFilterModule())
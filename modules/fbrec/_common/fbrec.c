@@ -0,0 +1,411 @@
+// Copyright 2026 David M. King
+// SPDX-License-Identifier: Apache-2.0
+//
+// fbrec — framebuffer capture/replay stream. See fbrec.h for the format.
+//
+// Portable C: builds into the ESP-IDF app (stdio over VFS, e.g. /sdcard) and
+// into the desktop sim and replay tool unchanged.
+
+#if !defined(ESP_PLATFORM) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L     // clock_gettime() under -std=c11
+#endif
+
+#include "fbrec.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "board_interface.h"
+
+#ifdef ESP_PLATFORM
+#include "esp_log.h"
+#include "esp_timer.h"
+static const char *TAG = "FBREC";
+#define FBREC_LOGE(...) ESP_LOGE(TAG, __VA_ARGS__)
+#define FBREC_LOGI(...) ESP_LOGI(TAG, __VA_ARGS__)
+static uint64_t now_us(void) { return (uint64_t)esp_timer_get_time(); }
+#else
+#include <time.h>
+#define FBREC_LOGE(...) (fprintf(stderr, "fbrec: " __VA_ARGS__), fputc('\n', stderr))
+#define FBREC_LOGI(...) (printf("fbrec: " __VA_ARGS__), putchar('\n'))
+static uint64_t now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u;
+}
+#endif
+
+#define FBREC_WRITE_BUF_BYTES  (16 * 1024)
+
+// ---------------------------------------------------------------------------
+// Little-endian helpers
+// ---------------------------------------------------------------------------
+
+static void put_u16(uint8_t *p, uint16_t v) { p[0] = v & 0xFF; p[1] = v >> 8; }
+static void put_u32(uint8_t *p, uint32_t v)
+{
+    p[0] = v & 0xFF; p[1] = (v >> 8) & 0xFF; p[2] = (v >> 16) & 0xFF; p[3] = v >> 24;
+}
+static uint16_t get_u16(const uint8_t *p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+static uint32_t get_u32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint16_t rgb565(uint8_t r, uint8_t g, uint8_t b)
+{
+    return (uint16_t)(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3));
+}
+
+// ---------------------------------------------------------------------------
+// Writer
+//
+// The encoder streams straight to the file: a sizing pass picks raw vs delta,
+// then a second pass emits the payload through a small staging buffer. Only
+// the shadow frame (what the capture believes is on screen) is kept in RAM.
+// ---------------------------------------------------------------------------
+
+typedef struct {
+    int x, y, w;
+    const uint16_t *pixels;     // NULL = read the board framebuffer
+} window_src_t;
+
+static FILE     *s_fp;
+static char     *s_fp_buf;
+static int       s_w, s_h;
+static uint16_t *s_shadow;
+static uint8_t   s_stage[512];
+static size_t    s_stage_len;
+static uint64_t  s_t0;
+static uint32_t  s_records;
+static uint64_t  s_raw_bytes;
+static uint64_t  s_file_bytes;
+static bool      s_failed;      // a write failed; latched until the next open
+
+// Append to the capture file. The first short write (card full or pulled)
+// latches s_failed; the caller stops recording once its record is done.
+static void put_bytes(const void *p, size_t n)
+{
+    if (s_failed || n == 0) return;
+    if (fwrite(p, 1, n, s_fp) != n) {
+        FBREC_LOGE("write failed after %llu bytes, recording stopped",
+                   (unsigned long long)s_file_bytes);
+        s_failed = true;
+    }
+}
+
+// Close the file and drop the buffers. False if the final flush failed.
+static bool release(void)
+{
+    bool ok = fclose(s_fp) == 0;
+    s_fp = NULL;
+    free(s_shadow); s_shadow = NULL;
+    free(s_fp_buf); s_fp_buf = NULL;
+    return ok;
+}
+
+static uint16_t src_pixel(const window_src_t *src, size_t i)
+{
+    int col = (int)(i % (size_t)src->w), row = (int)(i / (size_t)src->w);
+    if (src->pixels) return src->pixels[i];
+    uint8_t r, g, b;
+    board_lcd_unpack_rgb(board_lcd_get_pixel_raw(src->x + col, src->y + row), &r, &g, &b);
+    return rgb565(r, g, b);
+}
+
+static uint16_t *shadow_at(const window_src_t *src, size_t i)
+{
+    int col = (int)(i % (size_t)src->w), row = (int)(i / (size_t)src->w);
+    return &s_shadow[(size_t)(src->y + row) * s_w + src->x + col];
+}
+
+static void stage_u16(uint16_t v)
+{
+    if (s_stage_len + 2 > sizeof(s_stage)) {
+        put_bytes(s_stage, s_stage_len);
+        s_stage_len = 0;
+    }
+    put_u16(s_stage + s_stage_len, v);
+    s_stage_len += 2;
+}
+
+// Walk the window as XOR/RLE groups. With emit=false only the encoded size
+// is computed; with emit=true the groups are written and the shadow updated.
+static size_t xor_rle_pass(const window_src_t *src, size_t n, bool emit)
+{
+    size_t bytes = 0, i = 0;
+    while (i < n) {
+        size_t skip = 0;
+        while (i + skip < n && skip < 0xFFFF && src_pixel(src, i + skip) == *shadow_at(src, i + skip)) skip++;
+        i += skip;
+
+        size_t count = 0;
+        while (i + count < n && count < 0xFFFF && src_pixel(src, i + count) != *shadow_at(src, i + count)) count++;
+
+        bytes += 4 + count * 2;
+        if (emit) {
+            stage_u16((uint16_t)skip);
+            stage_u16((uint16_t)count);
+            for (size_t k = 0; k < count; k++) {
+                uint16_t *prev = shadow_at(src, i + k);
+                uint16_t cur = src_pixel(src, i + k);
+                stage_u16(cur ^ *prev);
+                *prev = cur;
+            }
+        }
+        i += count;
+    }
+    return bytes;
+}
+
+static bool write_window(const window_src_t *src, int h)
+{
+    size_t n = (size_t)src->w * h;
+    size_t raw_len = n * sizeof(uint16_t);
+    size_t len = xor_rle_pass(src, n, false);
+    uint8_t enc = FBREC_ENC_XOR_RLE;
+    if (len >= raw_len) {
+        enc = FBREC_ENC_RAW;
+        len = raw_len;
+    }
+
+    uint8_t rec[FBREC_RECORD_BYTES] = {0};
+    put_u32(rec + 0, (uint32_t)(now_us() - s_t0));
+    put_u16(rec + 4, (uint16_t)src->x);
+    put_u16(rec + 6, (uint16_t)src->y);
+    put_u16(rec + 8, (uint16_t)src->w);
+    put_u16(rec + 10, (uint16_t)h);
+    rec[12] = enc;
+    put_u32(rec + 16, (uint32_t)len);
+    put_bytes(rec, sizeof(rec));
+
+    s_stage_len = 0;
+    if (enc == FBREC_ENC_RAW) {
+        for (size_t i = 0; i < n; i++) {
+            uint16_t cur = src_pixel(src, i);
+            stage_u16(cur);
+            *shadow_at(src, i) = cur;
+        }
+    } else {
+        xor_rle_pass(src, n, true);
+    }
+    put_bytes(s_stage, s_stage_len);
+    if (s_failed) {
+        release();
+        return false;
+    }
+
+    s_records++;
+    s_raw_bytes += raw_len;
+    s_file_bytes += sizeof(rec) + len;
+    return true;
+}
+
+bool fbrec_open(const char *path)
+{
+    if (s_fp) fbrec_close();
+    s_failed = false;
+
+    s_w = board_lcd_width();
+    s_h = board_lcd_height();
+    if (s_w <= 0 || s_h <= 0) {
+        FBREC_LOGE("no display to capture");
+        return false;
+    }
+
+    s_shadow = calloc((size_t)s_w * s_h, sizeof(uint16_t));
+    s_fp_buf = malloc(FBREC_WRITE_BUF_BYTES);
+    if (!s_shadow || !s_fp_buf) {
+        FBREC_LOGE("out of memory for %dx%d capture", s_w, s_h);
+        free(s_shadow); s_shadow = NULL;
+        free(s_fp_buf); s_fp_buf = NULL;
+        return false;
+    }
+
+    s_fp = fopen(path, "wb");
+    if (!s_fp) {
+        FBREC_LOGE("cannot open %s", path);
+        free(s_shadow); s_shadow = NULL;
+        free(s_fp_buf); s_fp_buf = NULL;
+        return false;
+    }
+    setvbuf(s_fp, s_fp_buf, _IOFBF, FBREC_WRITE_BUF_BYTES);
+
+    uint8_t hdr[FBREC_HEADER_BYTES] = {0};
+    memcpy(hdr, FBREC_MAGIC, 4);
+    put_u16(hdr + 4, (uint16_t)s_w);
+    put_u16(hdr + 6, (uint16_t)s_h);
+    hdr[8] = 16;
+    hdr[9] = FBREC_VERSION;
+    put_bytes(hdr, sizeof(hdr));
+    if (s_failed) {
+        release();
+        return false;
+    }
+
+    s_t0 = now_us();
+    s_records = 0;
+    s_raw_bytes = 0;
+    s_file_bytes = sizeof(hdr);
+    FBREC_LOGI("recording %dx%d to %s", s_w, s_h, path);
+    return true;
+}
+
+bool fbrec_is_open(void)
+{
+    return s_fp != NULL;
+}
+
+bool fbrec_write_window(int x, int y, int w, int h, const uint16_t *pixels)
+{
+    if (!s_fp || !pixels || w <= 0 || h <= 0 || x < 0 || y < 0 || x + w > s_w || y + h > s_h) return false;
+    window_src_t src = { .x = x, .y = y, .w = w, .pixels = pixels };
+    return write_window(&src, h);
+}
+
+bool fbrec_capture_frame(void)
+{
+    if (!s_fp) return false;
+    window_src_t src = { .x = 0, .y = 0, .w = s_w, .pixels = NULL };
+    return write_window(&src, s_h);
+}
+
+bool fbrec_close(void)
+{
+    if (!s_fp) return !s_failed;
+    if (!release() && !s_failed) {
+        FBREC_LOGE("flush failed on close, capture is truncated");
+        s_failed = true;
+    }
+    FBREC_LOGI("closed: %u records, %llu raw bytes -> %llu file bytes",
+               (unsigned)s_records, (unsigned long long)s_raw_bytes,
+               (unsigned long long)s_file_bytes);
+    return !s_failed;
+}
+
+void fbrec_get_totals(uint32_t *records, uint64_t *raw_bytes, uint64_t *file_bytes)
+{
+    if (records)    *records = s_records;
+    if (raw_bytes)  *raw_bytes = s_raw_bytes;
+    if (file_bytes) *file_bytes = s_file_bytes;
+}
+
+// ---------------------------------------------------------------------------
+// Reader
+// ---------------------------------------------------------------------------
+
+// Apply an encoded delta in place over `px` (n pixels). False if malformed.
+static bool xor_rle_decode(uint16_t *px, size_t n, const uint8_t *in, size_t len)
+{
+    size_t i = 0, o = 0;
+    while (o + 4 <= len) {
+        size_t skip = get_u16(in + o);
+        size_t count = get_u16(in + o + 2);
+        o += 4;
+        if (i + skip + count > n || o + count * 2 > len) return false;
+        i += skip;
+        for (size_t k = 0; k < count; k++, o += 2) px[i++] ^= get_u16(in + o);
+    }
+    return o == len;
+}
+
+struct fbrec_reader {
+    FILE     *fp;
+    int       w, h;
+    uint16_t *frame;      // full-screen RGB565
+    uint16_t *window;     // scratch: one window
+    uint8_t  *payload;    // scratch: one payload
+};
+
+fbrec_reader_t *fbrec_reader_open(const char *path, int *width, int *height)
+{
+    FILE *fp = fopen(path, "rb");
+    if (!fp) return NULL;
+
+    uint8_t hdr[FBREC_HEADER_BYTES];
+    if (fread(hdr, 1, sizeof(hdr), fp) != sizeof(hdr) || memcmp(hdr, FBREC_MAGIC, 4) != 0 ||
+        hdr[8] != 16 || hdr[9] != FBREC_VERSION) {
+        fclose(fp);
+        return NULL;
+    }
+
+    fbrec_reader_t *r = calloc(1, sizeof(*r));
+    if (!r) {
+        fclose(fp);
+        return NULL;
+    }
+    r->fp = fp;
+    r->w = get_u16(hdr + 4);
+    r->h = get_u16(hdr + 6);
+    size_t px = (size_t)r->w * r->h;
+    r->frame   = calloc(px, sizeof(uint16_t));
+    r->window  = malloc(px * sizeof(uint16_t));
+    r->payload = malloc(px * sizeof(uint16_t));
+    if (!r->frame || !r->window || !r->payload) {
+        fbrec_reader_close(r);
+        return NULL;
+    }
+
+    if (width)  *width = r->w;
+    if (height) *height = r->h;
+    return r;
+}
+
+bool fbrec_reader_next(fbrec_reader_t *r, fbrec_record_t *rec)
+{
+    uint8_t b[FBREC_RECORD_BYTES];
+    if (fread(b, 1, sizeof(b), r->fp) != sizeof(b)) return false;
+
+    rec->timestamp_us  = get_u32(b + 0);
+    rec->x             = get_u16(b + 4);
+    rec->y             = get_u16(b + 6);
+    rec->w             = get_u16(b + 8);
+    rec->h             = get_u16(b + 10);
+    rec->encoding      = b[12];
+    rec->payload_bytes = get_u32(b + 16);
+
+    size_t n = (size_t)rec->w * rec->h;
+    if (rec->x + rec->w > r->w || rec->y + rec->h > r->h ||
+        rec->payload_bytes > n * sizeof(uint16_t)) {
+        return false;
+    }
+    if (fread(r->payload, 1, rec->payload_bytes, r->fp) != rec->payload_bytes) return false;
+
+    uint16_t *win = r->window;
+    for (int row = 0; row < rec->h; row++) {
+        memcpy(win + (size_t)row * rec->w, r->frame + (size_t)(rec->y + row) * r->w + rec->x,
+               (size_t)rec->w * sizeof(uint16_t));
+    }
+
+    if (rec->encoding == FBREC_ENC_RAW) {
+        if (rec->payload_bytes != n * sizeof(uint16_t)) return false;
+        for (size_t i = 0; i < n; i++) win[i] = get_u16(r->payload + i * 2);
+    } else if (rec->encoding == FBREC_ENC_XOR_RLE) {
+        if (!xor_rle_decode(win, n, r->payload, rec->payload_bytes)) return false;
+    } else {
+        return false;
+    }
+
+    for (int row = 0; row < rec->h; row++) {
+        memcpy(r->frame + (size_t)(rec->y + row) * r->w + rec->x, win + (size_t)row * rec->w,
+               (size_t)rec->w * sizeof(uint16_t));
+    }
+    return true;
+}
+
+const uint16_t *fbrec_reader_frame(const fbrec_reader_t *r)
+{
+    return r->frame;
+}
+
+void fbrec_reader_close(fbrec_reader_t *r)
+{
+    if (!r) return;
+    if (r->fp) fclose(r->fp);
+    free(r->frame);
+    free(r->window);
+    free(r->payload);
+    free(r);
+}
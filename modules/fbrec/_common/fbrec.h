@@ -0,0 +1,101 @@
+// Copyright 2026 David M. King
+// SPDX-License-Identifier: Apache-2.0
+
+// fbrec — framebuffer capture/replay stream.
+//
+// Records every flushed window (position, size, pixels, timestamp) into a
+// compact file so a session can be replayed in the desktop sim and analysed
+// frame by frame. On device the file normally lives on the TF card; in the
+// sim it is an ordinary file on disk.
+//
+// Usage on device:
+//   fbrec_open(CONFIG_FBREC_PATH);   // after the SD card is mounted
+//   ...render...
+//   fbrec_capture_frame();           // right before board_lcd_flush()
+//   board_lcd_flush();
+//   ...
+//   fbrec_close();
+//
+// In the sim, pass --record <file> to the sim binary; every flush is captured
+// automatically. Play a capture back with the <project>_replay binary.
+//
+// File format (all integers little-endian):
+//
+//   header   "FBR1" | u16 width | u16 height | u8 bpp (16) | u8 version (1)
+//            | u16 reserved | u32 reserved                       (16 bytes)
+//   record   u32 timestamp_us | u16 x | u16 y | u16 w | u16 h
+//            | u8 encoding | u8 reserved | u16 reserved
+//            | u32 payload_bytes                                 (20 bytes)
+//            followed by payload_bytes of payload
+//
+// Pixels are canonical RGB565 regardless of the board's native format.
+// Encoding FBREC_ENC_RAW stores w*h pixels. FBREC_ENC_XOR_RLE stores the
+// window XORed against the previous contents of the same area as a series
+// of  u16 skip | u16 count | count x u16 xor  groups, row-major, where
+// `skip` pixels are unchanged. The encoder falls back to raw whenever the
+// delta would be larger.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define FBREC_MAGIC         "FBR1"
+#define FBREC_VERSION       1
+#define FBREC_HEADER_BYTES  16
+#define FBREC_RECORD_BYTES  20
+
+typedef enum {
+    FBREC_ENC_RAW     = 0,
+    FBREC_ENC_XOR_RLE = 1,
+} fbrec_encoding_t;
+
+typedef struct {
+    uint32_t timestamp_us;
+    uint16_t x, y, w, h;
+    uint8_t  encoding;
+    uint32_t payload_bytes;
+} fbrec_record_t;
+
+// ---- Writer ----------------------------------------------------------------
+
+// Open a capture file sized to the current display. Returns false on error.
+bool fbrec_open(const char *path);
+bool fbrec_is_open(void);
+
+// A failed write (e.g. the card is full) stops the recording: the file is
+// closed, fbrec_is_open() turns false and fbrec_close() reports the error.
+// Records written before the failure still replay; the reader stops at the
+// truncated one.
+
+// Capture the whole framebuffer as one window (reads it back through
+// board_lcd_get_pixel_raw, so call it before board_lcd_flush()).
+// Returns true if the frame was recorded.
+bool fbrec_capture_frame(void);
+
+// Record one window of canonical RGB565 pixels (w*h, row-major).
+// Returns true if the window was recorded.
+bool fbrec_write_window(int x, int y, int w, int h, const uint16_t *pixels);
+
+// Close the capture. Returns false if any write failed since fbrec_open().
+bool fbrec_close(void);
+
+// Totals for the open (or last closed) capture.
+void fbrec_get_totals(uint32_t *records, uint64_t *raw_bytes, uint64_t *file_bytes);
+
+// ---- Reader ----------------------------------------------------------------
+
+typedef struct fbrec_reader fbrec_reader_t;
+
+// Open a capture for playback. Returns NULL if the file is missing or invalid.
+fbrec_reader_t *fbrec_reader_open(const char *path, int *width, int *height);
+
+// Decode the next record into the reader's frame. Returns false at end of
+// file or on a corrupt record.
+bool fbrec_reader_next(fbrec_reader_t *r, fbrec_record_t *rec);
+
+// Full-screen RGB565 frame after the last decoded record (width*height).
+const uint16_t *fbrec_reader_frame(const fbrec_reader_t *r);
+
+void fbrec_reader_close(fbrec_reader_t *r);
@@ -0,0 +1,329 @@
+// Copyright 2026 David M. King
+// SPDX-License-Identifier: Apache-2.0
+//
+// Madgwick / Mahony orientation filters — see imu_fusion.h.
+//
+// Both filters integrate qdot = 1/2 q (x) (0, w) with a corrected rate w.
+// Madgwick subtracts beta times the normalised gradient of the gravity
+// error from qdot; Mahony adds kp * e (+ the ki integral) to w, with
+// e = a x v the cross product of the measured and estimated gravity.
+//
+// The Madgwick gradient is used in the reduced form valid for a unit
+// quaternion (t = q1^2 + q2^2), which is what keeps every fixed-point
+// intermediate under 8.0 in Q30:
+//   s0 = 2 q0 t        + q2 ax - q1 ay
+//   s1 = 2 q1 (t + az) - q3 ax - q0 ay
+//   s2 = 2 q2 (t + az) + q0 ax - q3 ay
+//   s3 = 2 q3 t        - q1 ax - q2 ay
+
+#include "imu_fusion.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#define DEG_TO_RAD  0.017453292519943f
+#define RAD_TO_DEG  57.29577951308232f
+
+// ---------------------------------------------------------------------------
+// Float
+// ---------------------------------------------------------------------------
+
+static void normalize(float *v, int n)
+{
+    float s = 0.0f;
+    for (int i = 0; i < n; i++) s += v[i] * v[i];
+    if (s <= 0.0f) return;
+    float inv = 1.0f / sqrtf(s);
+    for (int i = 0; i < n; i++) v[i] *= inv;
+}
+
+void imu_fusion_init(imu_fusion_t *f, const imu_fusion_config_t *cfg)
+{
+    const imu_fusion_config_t def = IMU_FUSION_DEFAULT_CONFIG(IMU_FUSION_MADGWICK);
+    f->cfg = cfg ? *cfg : def;
+    f->q[0] = 1.0f;
+    f->q[1] = f->q[2] = f->q[3] = 0.0f;
+    f->bias[0] = f->bias[1] = f->bias[2] = 0.0f;
+}
+
+void imu_fusion_update(imu_fusion_t *f, const float gyro_dps[3], const float accel[3], float dt_s)
+{
+    float *q = f->q;
+    float g[3] = { gyro_dps[0] * DEG_TO_RAD, gyro_dps[1] * DEG_TO_RAD, gyro_dps[2] * DEG_TO_RAD };
+    float a[3] = { accel[0], accel[1], accel[2] };
+    bool have_accel = a[0] != 0.0f || a[1] != 0.0f || a[2] != 0.0f;
+    if (have_accel) normalize(a, 3);
+
+    float s[4] = {0};
+    if (have_accel && f->cfg.algo == IMU_FUSION_MAHONY) {
+        float v[3] = {
+            2.0f * (q[1] * q[3] - q[0] * q[2]),
+            2.0f * (q[0] * q[1] + q[2] * q[3]),
+            q[0] * q[0] - q[1] * q[1] - q[2] * q[2] + q[3] * q[3],
+        };
+        float e[3] = {
+            a[1] * v[2] - a[2] * v[1],
+            a[2] * v[0] - a[0] * v[2],
+            a[0] * v[1] - a[1] * v[0],
+        };
+        for (int i = 0; i < 3; i++) {
+            if (f->cfg.ki > 0.0f) f->bias[i] += f->cfg.ki * e[i] * dt_s;
+            g[i] += f->cfg.kp * e[i] + f->bias[i];
+        }
+    } else if (have_accel) {
+        float t = q[1] * q[1] + q[2] * q[2];
+        s[0] = 2.0f * q[0] * t + q[2] * a[0] - q[1] * a[1];
+        s[1] = 2.0f * q[1] * (t + a[2]) - q[3] * a[0] - q[0] * a[1];
+        s[2] = 2.0f * q[2] * (t + a[2]) + q[0] * a[0] - q[3] * a[1];
+        s[3] = 2.0f * q[3] * t - q[1] * a[0] - q[2] * a[1];
+        normalize(s, 4);
+    }
+
+    float qd[4] = {
+        0.5f * (-q[1] * g[0] - q[2] * g[1] - q[3] * g[2]) - f->cfg.beta * s[0],
+        0.5f * ( q[0] * g[0] + q[2] * g[2] - q[3] * g[1]) - f->cfg.beta * s[1],
+        0.5f * ( q[0] * g[1] - q[1] * g[2] + q[3] * g[0]) - f->cfg.beta * s[2],
+        0.5f * ( q[0] * g[2] + q[1] * g[1] - q[2] * g[0]) - f->cfg.beta * s[3],
+    };
+    for (int i = 0; i < 4; i++) q[i] += qd[i] * dt_s;
+    normalize(q, 4);
+}
+
+void imu_fusion_get_quat(const imu_fusion_t *f, imu_quat_t *out)
+{
+    out->w = f->q[0];
+    out->x = f->q[1];
+    out->y = f->q[2];
+    out->z = f->q[3];
+}
+
+void imu_fusion_get_euler(const imu_fusion_t *f, imu_euler_t *out)
+{
+    const float *q = f->q;
+    float sp = 2.0f * (q[0] * q[2] - q[3] * q[1]);
+    if (sp > 1.0f) sp = 1.0f;
+    if (sp < -1.0f) sp = -1.0f;
+    out->roll  = atan2f(2.0f * (q[0] * q[1] + q[2] * q[3]),
+                        1.0f - 2.0f * (q[1] * q[1] + q[2] * q[2])) * RAD_TO_DEG;
+    out->pitch = asinf(sp) * RAD_TO_DEG;
+    out->yaw   = atan2f(2.0f * (q[0] * q[3] + q[1] * q[2]),
+                        1.0f - 2.0f * (q[2] * q[2] + q[3] * q[3])) * RAD_TO_DEG;
+}
+
+// ---------------------------------------------------------------------------
+// Fixed point (Q30 quaternion, Q16 rates)
+// ---------------------------------------------------------------------------
+
+#define Q30 30
+#define BIAS_MAX_Q30  (1L << 30)    // 1 rad/s
+#define NEWTON_MAX_DEV (1L << 20)   // |q|^2 within 1e-3 of 1
+
+static inline int64_t mul30(int64_t a, int64_t b) { return (a * b) >> Q30; }
+
+static uint32_t isqrt64(uint64_t v)
+{
+    uint64_t res = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+    while (bit > v) bit >>= 2;
+    while (bit) {
+        if (v >= res + bit) {
+            v -= res + bit;
+            res = (res >> 1) + bit;
+        } else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)res;
+}
+
+// 1/sqrt(1 + (k + 0.5) / 4) in Q30: starting points for inv_sqrt().
+static const int32_t s_rsqrt_seed_q30[12] = {
+    1012333500, 915690104, 842312387, 784150157, 736580814, 696735698,
+    662727842, 633258380, 607400100, 584471019, 563956835, 545461392,
+};
+
+// 1/sqrt(x) in Q30 for x in [1, 16) given in Q28. Table seed plus three
+// Newton steps (y = y (3 - x y^2) / 2): multiplies only, no division.
+static int64_t inv_sqrt_q30(uint32_t x_q28)
+{
+    int half = x_q28 >= (4u << 28);
+    int64_t u = half ? x_q28 >> 2 : x_q28;          // [1, 4) Q28
+    int64_t y = s_rsqrt_seed_q30[(u - (1 << 28)) >> 26];
+    for (int i = 0; i < 3; i++) {
+        int64_t xy2 = (u * mul30(y, y)) >> 28;      // Q30
+        y = (y * (3 * (int64_t)IMU_FUSION_Q30_ONE - xy2)) >> 31;
+    }
+    return half ? y >> 1 : y;
+}
+
+// Scale v[0..n) (n <= 4, each |v| < 2^62) to a Q30 unit vector in out.
+// Returns 0 for a zero vector.
+static int normalize_q30(const int64_t *v, int32_t *out, int n)
+{
+    // Bring the largest component into [2^28, 2^29): the squares then sum
+    // to [2^56, 2^60), i.e. x = sum / 2^56 in [1, 16).
+    int64_t big = 0;
+    for (int i = 0; i < n; i++) {
+        int64_t m = v[i] < 0 ? -v[i] : v[i];
+        if (m > big) big = m;
+    }
+    if (big == 0) return 0;
+    int shift = 0;
+    while ((big >> shift) >= ((int64_t)1 << 29)) shift++;
+    while ((big << -shift) < ((int64_t)1 << 28)) shift--;
+
+    int64_t s[4];
+    uint64_t sum = 0;
+    for (int i = 0; i < n; i++) {
+        s[i] = shift >= 0 ? v[i] >> shift : v[i] * ((int64_t)1 << -shift);
+        sum += (uint64_t)(s[i] * s[i]);
+    }
+    // s / sqrt(sum) in Q30 = s * (2^34 / sqrt(x)) >> 32
+    int64_t inv = inv_sqrt_q30((uint32_t)(sum >> 28)) << 4;
+    for (int i = 0; i < n; i++) {
+        out[i] = (int32_t)((s[i] * inv) >> 32);
+    }
+    return 1;
+}
+
+void imu_fusion_q_init(imu_fusion_q_t *f, const imu_fusion_config_t *cfg)
+{
+    const imu_fusion_config_t def = IMU_FUSION_DEFAULT_CONFIG(IMU_FUSION_MADGWICK);
+    if (!cfg) cfg = &def;
+    f->algo     = cfg->algo;
+    f->beta_q30 = (int32_t)(cfg->beta * (float)IMU_FUSION_Q30_ONE);
+    f->kp_q16   = (int32_t)(cfg->kp * 65536.0f);
+    f->ki_q16   = (int32_t)(cfg->ki * 65536.0f);
+    f->q[0] = IMU_FUSION_Q30_ONE;
+    f->q[1] = f->q[2] = f->q[3] = 0;
+    f->bias_q30[0] = f->bias_q30[1] = f->bias_q30[2] = 0;
+}
+
+void imu_fusion_q_update(imu_fusion_q_t *f, const int32_t gyro_q16[3], const int32_t accel[3],
+                         int32_t dt_us)
+{
+    const int64_t q0 = f->q[0], q1 = f->q[1], q2 = f->q[2], q3 = f->q[3];
+    int64_t g[3] = { gyro_q16[0], gyro_q16[1], gyro_q16[2] };
+    int64_t a_raw[3] = { accel[0], accel[1], accel[2] };
+    int32_t a[3];
+    int have_accel = normalize_q30(a_raw, a, 3);
+
+    int32_t s[4] = {0};
+    if (have_accel && f->algo == IMU_FUSION_MAHONY) {
+        int64_t v[3] = {
+            2 * (mul30(q1, q3) - mul30(q0, q2)),
+            2 * (mul30(q0, q1) + mul30(q2, q3)),
+            mul30(q0, q0) - mul30(q1, q1) - mul30(q2, q2) + mul30(q3, q3),
+        };
+        int64_t e[3] = {
+            mul30(a[1], v[2]) - mul30(a[2], v[1]),
+            mul30(a[2], v[0]) - mul30(a[0], v[2]),
+            mul30(a[0], v[1]) - mul30(a[1], v[0]),
+        };
+        for (int i = 0; i < 3; i++) {
+            if (f->ki_q16 > 0) {
+                // Accumulate in Q30: per-sample increments are far below 1 LSB of Q16.
+                int64_t b = f->bias_q30[i] + ((f->ki_q16 * e[i]) >> 16) * dt_us / 1000000;
+                if (b > BIAS_MAX_Q30) b = BIAS_MAX_Q30;
+                if (b < -BIAS_MAX_Q30) b = -BIAS_MAX_Q30;
+                f->bias_q30[i] = (int32_t)b;
+            }
+            g[i] += mul30(f->kp_q16, e[i]) + (f->bias_q30[i] >> 14);
+        }
+    } else if (have_accel) {
+        int64_t t = mul30(q1, q1) + mul30(q2, q2);
+        int64_t grad[4] = {
+            2 * mul30(q0, t)            + mul30(q2, a[0]) - mul30(q1, a[1]),
+            2 * mul30(q1, t + a[2])     - mul30(q3, a[0]) - mul30(q0, a[1]),
+            2 * mul30(q2, t + a[2])     + mul30(q0, a[0]) - mul30(q3, a[1]),
+            2 * mul30(q3, t)            - mul30(q1, a[0]) - mul30(q2, a[1]),
+        };
+        normalize_q30(grad, s, 4);
+    }
+
+    // qdot in Q30 per second: (Q30 * Q16) >> 17 is the 1/2 q (x) w product.
+    int64_t qd[4] = {
+        ((-q1 * g[0] - q2 * g[1] - q3 * g[2]) >> 17) - mul30(f->beta_q30, s[0]),
+        (( q0 * g[0] + q2 * g[2] - q3 * g[1]) >> 17) - mul30(f->beta_q30, s[1]),
+        (( q0 * g[1] - q1 * g[2] + q3 * g[0]) >> 17) - mul30(f->beta_q30, s[2]),
+        (( q0 * g[2] + q1 * g[1] - q2 * g[0]) >> 17) - mul30(f->beta_q30, s[3]),
+    };
+    // dt in seconds, Q24 (one division instead of four).
+    int64_t dt_q24 = ((int64_t)dt_us << 24) / 1000000;
+    int64_t qn[4] = {
+        q0 + ((qd[0] * dt_q24) >> 24),
+        q1 + ((qd[1] * dt_q24) >> 24),
+        q2 + ((qd[2] * dt_q24) >> 24),
+        q3 + ((qd[3] * dt_q24) >> 24),
+    };
+
+    // A small step leaves |q| within a hair of 1, where one Newton step of
+    // 1/sqrt (x * (3 - n2) / 2) renormalises without a square root.
+    int64_t n2 = mul30(qn[0], qn[0]) + mul30(qn[1], qn[1]) + mul30(qn[2], qn[2]) + mul30(qn[3], qn[3]);
+    int64_t dev = n2 - IMU_FUSION_Q30_ONE;
+    if (dev > -NEWTON_MAX_DEV && dev < NEWTON_MAX_DEV) {
+        int64_t inv = (3 * (int64_t)IMU_FUSION_Q30_ONE - n2) >> 1;
+        for (int i = 0; i < 4; i++) f->q[i] = (int32_t)mul30(qn[i], inv);
+    } else {
+        normalize_q30(qn, f->q, 4);
+    }
+}
+
+void imu_fusion_q_get_quat(const imu_fusion_q_t *f, imu_quat_t *out)
+{
+    const float k = 1.0f / (float)IMU_FUSION_Q30_ONE;
+    out->w = f->q[0] * k;
+    out->x = f->q[1] * k;
+    out->y = f->q[2] * k;
+    out->z = f->q[3] * k;
+}
+
+// atan(2^-i) in degrees, Q16.
+static const int32_t s_cordic_atan_q16[] = {
+    2949120, 1740967, 919879, 466945, 234379, 117304, 58666, 29335,
+    14668, 7334, 3667, 1833, 917, 458, 229, 115,
+};
+
+// CORDIC vectoring-mode atan2, in 0.01 degrees.
+static int32_t atan2_cdeg(int64_t y, int64_t x)
+{
+    if (x == 0 && y == 0) return 0;
+    int32_t z = 0;     // degrees Q16
+    if (x < 0) {
+        z = y >= 0 ? 180 * 65536 : -180 * 65536;
+        x = -x;
+        y = -y;
+    }
+    for (size_t i = 0; i < sizeof(s_cordic_atan_q16) / sizeof(s_cordic_atan_q16[0]); i++) {
+        int64_t xs = x >> i, ys = y >> i;
+        if (y > 0) {
+            x += ys; y -= xs; z += s_cordic_atan_q16[i];
+        } else {
+            x -= ys; y += xs; z -= s_cordic_atan_q16[i];
+        }
+    }
+    int64_t cdeg = ((int64_t)z * 100 + (z >= 0 ? 32768 : -32768)) / 65536;
+    if (cdeg > 18000) cdeg -= 36000;
+    if (cdeg <= -18000) cdeg += 36000;
+    return (int32_t)cdeg;
+}
+
+void imu_fusion_q_get_euler(const imu_fusion_q_t *f, imu_euler_cdeg_t *out)
+{
+    const int64_t q0 = f->q[0], q1 = f->q[1], q2 = f->q[2], q3 = f->q[3];
+    const int64_t one = IMU_FUSION_Q30_ONE;
+
+    int64_t sp = 2 * (mul30(q0, q2) - mul30(q3, q1));
+    if (sp > one) sp = one;
+    if (sp < -one) sp = -one;
+    // asin(sp) = atan2(sp, sqrt(1 - sp^2))
+    int64_t cp = isqrt64((uint64_t)((one - sp) * (one + sp)));
+
+    out->roll  = atan2_cdeg(2 * (mul30(q0, q1) + mul30(q2, q3)),
+                            one - 2 * (mul30(q1, q1) + mul30(q2, q2)));
+    out->pitch = atan2_cdeg(sp, cp);
+    out->yaw   = atan2_cdeg(2 * (mul30(q0, q3) + mul30(q1, q2)),
+                            one - 2 * (mul30(q2, q2) + mul30(q3, q3)));
+}
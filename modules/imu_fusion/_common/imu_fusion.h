@@ -0,0 +1,114 @@
+// Copyright 2026 David M. King
+// SPDX-License-Identifier: Apache-2.0
+
+// Orientation estimation from a 6-axis IMU (gyro + accelerometer).
+//
+// Two filters, each in float and in fixed point:
+//   Madgwick  gradient-descent correction towards gravity, one gain (beta)
+//   Mahony    PI correction on the gravity cross-product error (kp, ki);
+//             ki > 0 also learns the gyro bias
+//
+// Without a magnetometer roll and pitch are absolute, while yaw is
+// integrated gyro and drifts with the gyro bias.
+//
+// The fixed-point filter keeps the quaternion in Q30 and needs no float,
+// trig or sqrt from libm: normalisation uses an integer Newton inverse
+// square root and Euler angles come from a CORDIC atan2. Use it where the
+// FPU is absent or busy; the float filter is simpler to read and tune.
+//
+// Usage (with the wvshr185 IMU feature's sample stream):
+//   static imu_fusion_q_t fus;
+//   static int64_t last_us;               // 0 until the first sample
+//   imu_fusion_config_t cfg = IMU_FUSION_DEFAULT_CONFIG(IMU_FUSION_MADGWICK);
+//   imu_fusion_q_init(&fus, &cfg);
+//   ...
+//   imu_sample_t s[32];
+//   int n = imu_stream_read(s, 32);
+//   for (int i = 0; i < n; i++) {
+//       const imu_data_t *d = &s[i].data;
+//       int32_t g[3] = { IMU_FUSION_DPS_TO_Q16(d->gyro_x),
+//                        IMU_FUSION_DPS_TO_Q16(d->gyro_y),
+//                        IMU_FUSION_DPS_TO_Q16(d->gyro_z) };
+//       int32_t a[3] = { d->accel_x * 1000, d->accel_y * 1000, d->accel_z * 1000 };
+//       if (last_us == 0) last_us = s[i].timestamp_us;   // first sample: dt = 0
+//       imu_fusion_q_update(&fus, g, a, (int32_t)(s[i].timestamp_us - last_us));
+//       last_us = s[i].timestamp_us;
+//   }
+//   imu_euler_cdeg_t e;
+//   imu_fusion_q_get_euler(&fus, &e);     // e.roll / e.pitch in 0.01 deg
+//
+// Portable C with no ESP-IDF dependencies (host-tested in tests/host/).
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    IMU_FUSION_MADGWICK,
+    IMU_FUSION_MAHONY,
+} imu_fusion_algo_t;
+
+typedef struct {
+    imu_fusion_algo_t algo;
+    float beta;     // Madgwick: correction gain (rad/s of gyro error trusted)
+    float kp;       // Mahony: proportional gain on the gravity error
+    float ki;       // Mahony: integral gain (gyro bias learning); 0 = off
+} imu_fusion_config_t;
+
+#define IMU_FUSION_DEFAULT_CONFIG(a) { .algo = (a), .beta = 0.1f, .kp = 1.0f, .ki = 0.0f }
+
+typedef struct { float w, x, y, z; } imu_quat_t;
+typedef struct { float roll, pitch, yaw; } imu_euler_t;             // degrees
+typedef struct { int32_t roll, pitch, yaw; } imu_euler_cdeg_t;      // 0.01 degrees
+
+// Aerospace (Z-Y-X) convention throughout: roll about x, pitch about y,
+// yaw about z; the accelerometer reads +1 g on z when level.
+
+// --- Float filter ---
+
+typedef struct {
+    imu_fusion_config_t cfg;
+    float q[4];             // w, x, y, z
+    float bias[3];          // Mahony integral term, rad/s
+} imu_fusion_t;
+
+// cfg may be NULL for IMU_FUSION_DEFAULT_CONFIG(IMU_FUSION_MADGWICK).
+void imu_fusion_init(imu_fusion_t *f, const imu_fusion_config_t *cfg);
+
+// gyro in deg/s (as in imu_data_t), accel in any unit (only its direction
+// is used; an all-zero vector skips the correction step).
+void imu_fusion_update(imu_fusion_t *f, const float gyro_dps[3], const float accel[3], float dt_s);
+
+void imu_fusion_get_quat(const imu_fusion_t *f, imu_quat_t *out);
+void imu_fusion_get_euler(const imu_fusion_t *f, imu_euler_t *out);
+
+// --- Fixed-point filter ---
+
+#define IMU_FUSION_Q30_ONE        (1L << 30)
+#define IMU_FUSION_DPS_TO_Q16(d)  ((int32_t)((d) * 1143.8190f))   // deg/s -> rad/s Q16
+
+typedef struct {
+    imu_fusion_algo_t algo;
+    int32_t beta_q30;
+    int32_t kp_q16;
+    int32_t ki_q16;
+    int32_t q[4];           // Q30
+    int32_t bias_q30[3];    // Mahony integral term, rad/s Q30
+} imu_fusion_q_t;
+
+void imu_fusion_q_init(imu_fusion_q_t *f, const imu_fusion_config_t *cfg);
+
+// gyro in rad/s Q16, accel in any integer unit (e.g. raw counts or mg).
+void imu_fusion_q_update(imu_fusion_q_t *f, const int32_t gyro_q16[3], const int32_t accel[3],
+                         int32_t dt_us);
+
+void imu_fusion_q_get_quat(const imu_fusion_q_t *f, imu_quat_t *out);
+void imu_fusion_q_get_euler(const imu_fusion_q_t *f, imu_euler_cdeg_t *out);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,233 @@
+// Copyright 2026 David M. King
+// SPDX-License-Identifier: Apache-2.0
+//
+// Touch-to-photon latency histograms — see latency.h.
+//
+// Configure via menuconfig:
+//   Touch Latency → Console report interval
+
+#include "latency.h"
+
+#include <string.h>
+
+#include "board_interface.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+// Log-linear bins: values 0..7 us get one bin each, then 8 bins per power
+// of two up to 2^32 us.
+#define SUB_BITS   3
+#define SUB_BINS   (1 << SUB_BITS)
+#define NUM_BINS   ((32 - SUB_BITS + 1) * SUB_BINS)
+
+#define BAR_WIDTH  40
+
+static const char *TAG = "LATENCY";
+
+static const char *const s_metric_names[LATENCY_METRIC_COUNT] = {
+    "touch->glass",
+    "touch->dequeue",
+    "dequeue->render",
+    "render->flushed",
+};
+
+typedef struct {
+    uint32_t bins[NUM_BINS];
+    uint32_t count;
+    uint32_t max_us;
+} histogram_t;
+
+static histogram_t s_hist[LATENCY_METRIC_COUNT];
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// In-flight sample: the oldest dequeued touch not yet on glass.
+static bool s_pending;
+static bool s_rendered;
+static int64_t s_touch_us;
+static int64_t s_dequeue_us;
+static int64_t s_render_us;
+
+// ---------------------------------------------------------------------------
+// Histogram helpers
+// ---------------------------------------------------------------------------
+
+static int bin_index(uint32_t v)
+{
+    if (v < SUB_BINS) {
+        return v;
+    }
+    int octave = 31 - __builtin_clz(v);
+    int sub = (v >> (octave - SUB_BITS)) & (SUB_BINS - 1);
+    return (octave - SUB_BITS + 1) * SUB_BINS + sub;
+}
+
+// Largest value that falls in bin b.
+static uint32_t bin_upper(int b)
+{
+    if (b < SUB_BINS) {
+        return b;
+    }
+    int octave = b / SUB_BINS + SUB_BITS - 1;
+    int sub = b % SUB_BINS;
+    uint64_t lower = (uint64_t)(SUB_BINS + sub) << (octave - SUB_BITS);
+    uint64_t upper = lower + ((uint64_t)1 << (octave - SUB_BITS)) - 1;
+    return upper > UINT32_MAX ? UINT32_MAX : (uint32_t)upper;
+}
+
+static void hist_add(histogram_t *h, int64_t us)
+{
+    uint32_t v = us <= 0 ? 0 : (us > UINT32_MAX ? UINT32_MAX : (uint32_t)us);
+    h->bins[bin_index(v)]++;
+    h->count++;
+    if (v > h->max_us) {
+        h->max_us = v;
+    }
+}
+
+static uint32_t hist_percentile(const histogram_t *h, uint32_t pct)
+{
+    if (h->count == 0) {
+        return 0;
+    }
+    uint64_t rank = ((uint64_t)h->count * pct + 99) / 100;   // 1-based
+    uint64_t seen = 0;
+    for (int b = 0; b < NUM_BINS; b++) {
+        seen += h->bins[b];
+        if (seen >= rank) {
+            uint32_t up = bin_upper(b);
+            return up < h->max_us ? up : h->max_us;
+        }
+    }
+    return h->max_us;
+}
+
+// ---------------------------------------------------------------------------
+// board_latency_mark() — overrides the weak no-op in board_defaults.c
+// ---------------------------------------------------------------------------
+
+void board_latency_mark(board_latency_stage_t stage, int64_t timestamp_us)
+{
+    portENTER_CRITICAL(&s_lock);
+    switch (stage) {
+    case BOARD_LATENCY_TOUCH:
+        if (!s_pending) {
+            s_touch_us = timestamp_us;
+        }
+        break;
+    case BOARD_LATENCY_DEQUEUE:
+        if (!s_pending) {
+            s_dequeue_us = timestamp_us;
+            s_pending = true;
+            s_rendered = false;
+        }
+        break;
+    case BOARD_LATENCY_RENDER:
+        if (s_pending && !s_rendered) {
+            s_render_us = timestamp_us;
+            s_rendered = true;
+        }
+        break;
+    case BOARD_LATENCY_FLUSH_DONE:
+        if (s_pending && s_rendered) {
+            hist_add(&s_hist[LATENCY_TOTAL], timestamp_us - s_touch_us);
+            hist_add(&s_hist[LATENCY_QUEUE], s_dequeue_us - s_touch_us);
+            hist_add(&s_hist[LATENCY_RENDER], s_render_us - s_dequeue_us);
+            hist_add(&s_hist[LATENCY_FLUSH], timestamp_us - s_render_us);
+            s_pending = false;
+        }
+        break;
+    }
+    portEXIT_CRITICAL(&s_lock);
+}
+
+// ---------------------------------------------------------------------------
+// Public API
+// ---------------------------------------------------------------------------
+
+void latency_get_stats(latency_metric_t metric, latency_stats_t *out)
+{
+    if (!out || metric >= LATENCY_METRIC_COUNT) {
+        return;
+    }
+    // Copy under the lock (which masks interrupts on this core and is also
+    // taken from the flush-done path); scan the bins after releasing it.
+    histogram_t h;
+    portENTER_CRITICAL(&s_lock);
+    memcpy(&h, &s_hist[metric], sizeof(h));
+    portEXIT_CRITICAL(&s_lock);
+
+    out->count  = h.count;
+    out->p50_us = hist_percentile(&h, 50);
+    out->p95_us = hist_percentile(&h, 95);
+    out->p99_us = hist_percentile(&h, 99);
+    out->max_us = h.max_us;
+}
+
+void latency_reset(void)
+{
+    portENTER_CRITICAL(&s_lock);
+    memset(s_hist, 0, sizeof(s_hist));
+    s_pending = false;
+    portEXIT_CRITICAL(&s_lock);
+}
+
+void latency_report(void)
+{
+    latency_stats_t st[LATENCY_METRIC_COUNT];
+    for (int m = 0; m < LATENCY_METRIC_COUNT; m++) {
+        latency_get_stats(m, &st[m]);
+    }
+    if (st[LATENCY_TOTAL].count == 0) {
+        ESP_LOGI(TAG, "no touch-to-photon samples yet");
+        return;
+    }
+
+    for (int m = 0; m < LATENCY_METRIC_COUNT; m++) {
+        ESP_LOGI(TAG, "%-16s n=%-6lu p50=%6.2f ms  p95=%6.2f ms  p99=%6.2f ms  max=%6.2f ms",
+                 s_metric_names[m], (unsigned long)st[m].count,
+                 st[m].p50_us / 1000.0, st[m].p95_us / 1000.0,
+                 st[m].p99_us / 1000.0, st[m].max_us / 1000.0);
+    }
+
+    // Histogram of the total, bins merged to one line per half octave.
+    static histogram_t snap;
+    portENTER_CRITICAL(&s_lock);
+    snap = s_hist[LATENCY_TOTAL];
+    portEXIT_CRITICAL(&s_lock);
+
+    uint32_t rows[NUM_BINS / 4] = {0};
+    uint32_t peak = 0;
+    for (int b = 0; b < NUM_BINS; b++) {
+        rows[b / 4] += snap.bins[b];
+        if (rows[b / 4] > peak) peak = rows[b / 4];
+    }
+    for (int r = 0; r < NUM_BINS / 4; r++) {
+        if (rows[r] == 0) continue;
+        char bar[BAR_WIDTH + 1];
+        int len = (int)((uint64_t)rows[r] * BAR_WIDTH / peak);
+        if (len == 0) len = 1;
+        memset(bar, '#', len);
+        bar[len] = '\0';
+        ESP_LOGI(TAG, "  <=%8.2f ms %6lu %s",
+                 bin_upper(r * 4 + 3) / 1000.0, (unsigned long)rows[r], bar);
+    }
+}
+
+static void report_task(void *arg)
+{
+    while (1) {
+        vTaskDelay(pdMS_TO_TICKS(CONFIG_LATENCY_REPORT_INTERVAL_S * 1000));
+        latency_report();
+    }
+}
+
+void latency_init(void)
+{
+    if (CONFIG_LATENCY_REPORT_INTERVAL_S <= 0) {
+        return;
+    }
+    if (xTaskCreate(report_task, "latency_rpt", 4096, NULL, 2, NULL) != pdPASS) {
+        ESP_LOGW(TAG, "Failed to start report task");
+    }
+}
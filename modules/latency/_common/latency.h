@@ -0,0 +1,64 @@
+// Copyright 2026 David M. King
+// SPDX-License-Identifier: Apache-2.0
+
+// Touch-to-photon latency instrumentation.
+//
+// Linking latency.c overrides the weak board_latency_mark() hook, so every
+// touch board that marks its stages starts collecting without code changes:
+//
+//   TOUCH       touch IRQ/poll sample (the event's timestamp)
+//   DEQUEUE     app drained the event with board_touch_get_events()
+//   RENDER      app finished drawing and entered board_lcd_flush()
+//   FLUSH_DONE  flush DMA completed — the pixels are on glass
+//
+// One sample is taken per touch-driven frame: the oldest event dequeued
+// since the last completed flush, through the first flush that follows it.
+// Intervals are binned into log-linear histograms (8 bins per octave, so
+// percentiles are accurate to ~9%).
+//
+// Usage:
+//   latency_init();            // optional: periodic console report
+//   ...
+//   latency_stats_t st;
+//   latency_get_stats(LATENCY_TOTAL, &st);
+
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    LATENCY_TOTAL,      // touch → on glass
+    LATENCY_QUEUE,      // touch → dequeue
+    LATENCY_RENDER,     // dequeue → flush entered
+    LATENCY_FLUSH,      // flush entered → DMA done
+    LATENCY_METRIC_COUNT,
+} latency_metric_t;
+
+typedef struct {
+    uint32_t count;
+    uint32_t p50_us;
+    uint32_t p95_us;
+    uint32_t p99_us;
+    uint32_t max_us;
+} latency_stats_t;
+
+// Start the periodic console report (CONFIG_LATENCY_REPORT_INTERVAL_S;
+// 0 disables it). Collection itself needs no init.
+void latency_init(void);
+
+// Percentiles for one metric since boot or the last latency_reset().
+// Copies the ~1 KB histogram onto the caller's stack.
+void latency_get_stats(latency_metric_t metric, latency_stats_t *out);
+
+// Log p50/p95/p99/max for every metric plus the total-latency histogram.
+void latency_report(void);
+
+void latency_reset(void);
+
+#ifdef __cplusplus
+}
+#endif
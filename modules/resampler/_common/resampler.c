@@ -0,0 +1,228 @@
+// Copyright 2026 David M. King
+// SPDX-License-Identifier: Apache-2.0
+
+#include "resampler.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#if CONFIG_RESAMPLER_ESP_DSP
+#include "dsps_dotprod.h"
+#include "esp_heap_caps.h"
+// dsps_dotprod_s16() truncates its result to int16 without saturating, so
+// coefficients are stored at half scale and the result doubled afterwards.
+#define COEF_ONE    16384
+// The S3 vector kernel only runs with both operands 16-byte aligned (and a
+// multiple of 8 long); otherwise esp-dsp falls back to the scalar one. The
+// input window advances a sample at a time, so the input is kept in eight
+// copies ("lanes"), lane a shifted by a samples: a window starting at any
+// index then starts on a 16-byte boundary in one of them.
+#define LANES       8
+#define ALLOC(n)    heap_caps_aligned_alloc(16, (n), MALLOC_CAP_DEFAULT)
+#define FREE(p)     heap_caps_free(p)
+#else
+#define COEF_ONE    32768
+#define LANES       1
+#define ALLOC(n)    malloc(n)
+#define FREE(p)     free(p)
+#endif
+
+#define KAISER_BETA 7.857   // ~80 dB stopband
+#define TAP_ALIGN   8       // vector dot product works on 8 samples at a time
+
+// Samples per lane: taps-1 history + RESAMPLER_CHUNK, rounded up to keep
+// every lane 16-byte aligned.
+#define LANE_LEN(rs) ((rs)->taps + RESAMPLER_CHUNK)
+
+static inline int16_t sat16(int32_t v)
+{
+    if (v > INT16_MAX) return INT16_MAX;
+    if (v < INT16_MIN) return INT16_MIN;
+    return (int16_t)v;
+}
+
+static uint32_t gcd(uint32_t a, uint32_t b)
+{
+    while (b) {
+        uint32_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+// Zeroth-order modified Bessel function, by its power series.
+static double bessel_i0(double x)
+{
+    double sum = 1.0, term = 1.0, q = x * x / 4.0;
+    for (int k = 1; k < 50 && term > sum * 1e-12; k++) {
+        term *= q / ((double)k * k);
+        sum += term;
+    }
+    return sum;
+}
+
+// Prototype low-pass at up x in_rate, N = up * taps long, split into
+// phases. Each phase is normalised to COEF_ONE on its own so every output
+// sample has exactly unity DC gain, and stored reversed so the dot product
+// runs forward over the input. Returns false if the scratch buffer cannot
+// be allocated.
+static bool design(resampler_t *rs)
+{
+    uint32_t up = rs->up, taps = rs->taps;
+    uint32_t hi = up > rs->down ? up : rs->down;
+    double n_total = (double)up * taps;
+    double centre = (n_total - 1.0) / 2.0;
+    // Cutoff in cycles per prototype sample: the lower rate's Nyquist less
+    // half the transition band, which is 5 / taps of the lower rate
+    // (lower_taps undoes the down/up scaling applied when decimating).
+    uint32_t lower_taps = taps * up / hi;
+    double fc = (0.5 - 2.5 / lower_taps) / hi;
+    double i0_beta = bessel_i0(KAISER_BETA);
+    double *h = malloc(taps * sizeof(double));
+    if (!h) return false;
+
+    for (uint32_t p = 0; p < up; p++) {
+        double sum = 0.0;
+        for (uint32_t j = 0; j < taps; j++) {
+            double n = (double)p + (double)j * up;
+            double t = n - centre;
+            double sinc = t == 0.0 ? 2.0 * fc : sin(2.0 * M_PI * fc * t) / (M_PI * t);
+            double r = 2.0 * n / (n_total - 1.0) - 1.0;
+            double w = bessel_i0(KAISER_BETA * sqrt(fmax(0.0, 1.0 - r * r))) / i0_beta;
+            h[j] = sinc * w;
+            sum += h[j];
+        }
+        int16_t *c = &rs->coefs[p * taps];
+        int32_t qsum = 0;
+        uint32_t peak = 0;
+        for (uint32_t j = 0; j < taps; j++) {
+            int16_t q = sat16((int32_t)lround(h[j] / sum * COEF_ONE));
+            c[taps - 1 - j] = q;
+            qsum += q;
+            if (fabs(h[j]) > fabs(h[peak])) peak = j;
+        }
+        // Rounding residue goes on the largest tap.
+        c[taps - 1 - peak] = sat16(c[taps - 1 - peak] + COEF_ONE - qsum);
+    }
+    free(h);
+    return true;
+}
+
+bool resampler_init(resampler_t *rs, uint32_t in_rate, uint32_t out_rate, int taps)
+{
+    memset(rs, 0, sizeof(*rs));
+    if (in_rate == 0 || out_rate == 0 || taps < 8) return false;
+    uint32_t g = gcd(in_rate, out_rate);
+    rs->up = out_rate / g;
+    rs->down = in_rate / g;
+    rs->step_int = rs->down / rs->up;
+    rs->step_frac = rs->down % rs->up;
+    if (rs->up == 1 && rs->down == 1) return true;   // pass-through
+
+    // Decimating needs proportionally more taps per phase for the same
+    // transition band relative to the (lower) output rate.
+    uint32_t n = (uint32_t)taps;
+    if (rs->down > rs->up) n = (uint32_t)(((uint64_t)n * rs->down + rs->up - 1) / rs->up);
+    rs->taps = (n + TAP_ALIGN - 1) / TAP_ALIGN * TAP_ALIGN;
+
+    rs->coefs = ALLOC((size_t)rs->up * rs->taps * sizeof(int16_t));
+    rs->buf = ALLOC((size_t)LANES * LANE_LEN(rs) * sizeof(int16_t));
+    if (!rs->coefs || !rs->buf || !design(rs)) {
+        resampler_free(rs);
+        return false;
+    }
+    resampler_reset(rs);
+    return true;
+}
+
+void resampler_free(resampler_t *rs)
+{
+    FREE(rs->coefs);
+    FREE(rs->buf);
+    rs->coefs = NULL;
+    rs->buf = NULL;
+}
+
+void resampler_reset(resampler_t *rs)
+{
+    rs->phase = 0;
+    if (!rs->buf) return;
+    memset(rs->buf, 0, (size_t)LANES * LANE_LEN(rs) * sizeof(int16_t));
+    rs->fill = rs->taps - 1;
+    rs->pos = rs->taps - 1;
+}
+
+uint32_t resampler_delay(const resampler_t *rs)
+{
+    if (!rs->coefs) return 0;
+    return (rs->up * rs->taps - 1) / (2 * rs->down);
+}
+
+static inline int16_t dot(const int16_t *c, const int16_t *x, uint32_t n)
+{
+#if CONFIG_RESAMPLER_ESP_DSP
+    int16_t half;
+    dsps_dotprod_s16(c, x, &half, (int)n, 0);
+    return sat16(half * 2);
+#else
+    // |sum| <= sum|c| * 32767 < 2^31 for a windowed sinc normalised to 2^15.
+    int32_t a0 = 0, a1 = 0;
+    for (uint32_t i = 0; i < n; i += 4) {
+        a0 += c[i] * x[i] + c[i + 2] * x[i + 2];
+        a1 += c[i + 1] * x[i + 1] + c[i + 3] * x[i + 3];
+    }
+    return sat16((a0 + a1 + (1 << 14)) >> 15);
+#endif
+}
+
+size_t resampler_process(resampler_t *rs, const int16_t *in, size_t in_n, int16_t *out)
+{
+    if (!rs->coefs) {
+        memcpy(out, in, in_n * sizeof(int16_t));
+        return in_n;
+    }
+    const uint32_t hist = rs->taps - 1;
+    const uint32_t cap = hist + RESAMPLER_CHUNK;
+    size_t produced = 0;
+
+    while (in_n > 0) {
+        size_t take = cap - rs->fill;
+        if (take > in_n) take = in_n;
+        // Lane a holds input sample j at index j - a (fill >= hist >= 7).
+        for (uint32_t a = 0; a < LANES; a++) {
+            memcpy(&rs->buf[a * LANE_LEN(rs) + rs->fill - a], in, take * sizeof(int16_t));
+        }
+        rs->fill += take;
+        in += take;
+        in_n -= take;
+
+        while (rs->pos < rs->fill) {
+            uint32_t start = rs->pos - hist;
+            uint32_t a = start & (LANES - 1);
+            out[produced++] = dot(&rs->coefs[rs->phase * rs->taps],
+                                  &rs->buf[a * LANE_LEN(rs) + start - a], rs->taps);
+            rs->pos += rs->step_int;
+            rs->phase += rs->step_frac;
+            if (rs->phase >= rs->up) {
+                rs->phase -= rs->up;
+                rs->pos++;
+            }
+        }
+
+        // Keep the last taps-1 samples as history for the next pass.
+        uint32_t drop = rs->fill - hist;
+        for (uint32_t a = 0; a < LANES; a++) {
+            int16_t *lane = &rs->buf[a * LANE_LEN(rs)];
+            memmove(lane, &lane[drop], (hist - a) * sizeof(int16_t));
+        }
+        rs->fill = hist;
+        rs->pos -= drop;
+    }
+    return produced;
+}
@@ -0,0 +1,79 @@
+// Copyright 2026 David M. King
+// SPDX-License-Identifier: Apache-2.0
+
+// Streaming sample-rate converter for 16-bit mono PCM.
+//
+// Converts by the reduced ratio up/down of the two rates (e.g. 44100 ->
+// 48000 is 160/147) with a polyphase FIR: a Kaiser-windowed sinc
+// (about 80 dB stopband) split into `up` phases of Q15 coefficients, each
+// normalised to unity DC gain. Every output sample is one dot product of
+// a phase against the most recent input, so the cost is taps per output
+// sample whatever the ratio.
+//
+// `taps` is the filter length in samples of the lower of the two rates;
+// the transition band is about 5/taps of that rate, centred 2.5/taps below
+// its Nyquist. 32 taps passes up to 0.34 x rate (5.4 kHz at 16 kHz) and
+// rejects from 0.5 x rate. Memory is up x taps coefficients (10 kB for
+// 44.1 <-> 48 kHz at 32 taps), allocated by resampler_init().
+//
+// Input can be pushed in blocks of any size; output does not depend on
+// how the stream is split.
+//
+//   resampler_t rs;
+//   resampler_init(&rs, 16000, 48000, RESAMPLER_DEFAULT_TAPS);
+//   int16_t out[RESAMPLER_OUT_MAX(256, 16000, 48000)];
+//   size_t n = resampler_process(&rs, in, 256, out);
+//
+// With CONFIG_RESAMPLER_ESP_DSP the dot products go through esp-dsp's
+// dsps_dotprod_s16(). Its ESP32-S3 vector kernel needs 16-byte aligned
+// operands, so coefficients and input are allocated aligned and the input
+// is kept in eight shifted copies (8 x (taps + 256) samples, about 4.5 kB
+// at 32 taps) so every window is aligned. Otherwise (and on the host, where
+// tests/host/ checks the frequency response) it is portable C.
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RESAMPLER_DEFAULT_TAPS  32
+#define RESAMPLER_CHUNK         256     // input samples buffered per pass
+
+// Upper bound on the output of one resampler_process() call.
+#define RESAMPLER_OUT_MAX(in_n, in_rate, out_rate) \
+    ((size_t)(((uint64_t)(in_n) * (out_rate) + (in_rate) - 1) / (in_rate)) + 1)
+
+typedef struct {
+    uint32_t up, down;          // reduced out_rate / in_rate
+    uint32_t taps;              // per phase, multiple of 8
+    uint32_t step_int;          // down / up
+    uint32_t step_frac;         // down % up
+    uint32_t phase;             // 0 .. up-1 of the next output
+    uint32_t pos;               // buf index of the next output's newest input
+    uint32_t fill;              // valid samples in buf
+    int16_t *coefs;             // up x taps, each phase in reverse order
+    int16_t *buf;               // taps-1 history + RESAMPLER_CHUNK (x 8 lanes with esp-dsp)
+} resampler_t;
+
+// Returns false for a zero rate, taps < 8, or out of memory.
+bool resampler_init(resampler_t *rs, uint32_t in_rate, uint32_t out_rate, int taps);
+void resampler_free(resampler_t *rs);
+
+// Forget the stream history (e.g. after a gap).
+void resampler_reset(resampler_t *rs);
+
+// Input to output delay, in output samples.
+uint32_t resampler_delay(const resampler_t *rs);
+
+// Consume all in_n samples; returns the number written to out, at most
+// RESAMPLER_OUT_MAX(in_n, in_rate, out_rate).
+size_t resampler_process(resampler_t *rs, const int16_t *in, size_t in_n, int16_t *out);
+
+#ifdef __cplusplus
+}
+#endif
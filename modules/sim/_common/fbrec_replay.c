@@ -0,0 +1,148 @@
+// fbrec_replay.c — play an fbrec capture back in the desktop sim and report
+// per-frame changed-pixel statistics for __PROJECT_NAME__.
+//
+//   ./__PROJECT_NAME___replay capture.fbr [--fast]
+//
+// Prints one CSV line per record:
+//   frame,t_ms,changed_px,changed_pct,bbox_px,tiles,tile_px
+// where bbox_px is the area of the bounding box of changed pixels (what a
+// single dirty rect would push) and tiles/tile_px count the 16x16 tiles that
+// changed (what a tile scheme would push). A summary compares both against
+// full-frame flushes. The bus model (sim_bus.c) is charged with the dirty
+// bounding box, so its FPS report reflects a dirty-rect strategy.
+//
+// --fast ignores capture timestamps and replays as quickly as possible.
+
+#include <SDL2/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "board_interface.h"
+#include "fbrec.h"
+#include "screencap.h"
+#include "sim_bus.h"
+
+#define TILE 16
+
+int   sim_argc;
+char **sim_argv;
+
+int main(int argc, char **argv)
+{
+    sim_argc = argc;
+    sim_argv = argv;
+
+    const char *path = NULL;
+    int fast = 0;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--fast") == 0) fast = 1;
+        else if (argv[i][0] != '-' && !path) path = argv[i];
+    }
+    if (!path) {
+        fprintf(stderr, "usage: %s capture.fbr [--fast]\n", argv[0]);
+        return 1;
+    }
+
+    int w, h;
+    fbrec_reader_t *r = fbrec_reader_open(path, &w, &h);
+    if (!r) {
+        fprintf(stderr, "%s: not an fbrec capture\n", path);
+        return 1;
+    }
+
+    board_init();
+    if (board_lcd_width() != w || board_lcd_height() != h) {
+        fprintf(stderr, "warning: capture is %dx%d, sim is %dx%d\n",
+                w, h, board_lcd_width(), board_lcd_height());
+    }
+
+    size_t px = (size_t)w * h;
+    int tiles_x = (w + TILE - 1) / TILE, tiles_y = (h + TILE - 1) / TILE;
+    uint16_t *prev = calloc(px, sizeof(uint16_t));
+    uint8_t *tile_dirty = malloc((size_t)tiles_x * tiles_y);
+    if (!prev || !tile_dirty) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+
+    uint64_t sum_changed = 0, sum_bbox = 0, sum_tile_px = 0, frames = 0;
+    uint32_t last_ts = 0;
+    fbrec_record_t rec;
+
+    printf("frame,t_ms,changed_px,changed_pct,bbox_px,tiles,tile_px\n");
+    while (fbrec_reader_next(r, &rec)) {
+        const uint16_t *cur = fbrec_reader_frame(r);
+
+        int x0 = w, y0 = h, x1 = -1, y1 = -1;
+        uint64_t changed = 0;
+        memset(tile_dirty, 0, (size_t)tiles_x * tiles_y);
+        for (int y = 0; y < h; y++) {
+            for (int x = 0; x < w; x++) {
+                size_t i = (size_t)y * w + x;
+                if (cur[i] == prev[i]) continue;
+                changed++;
+                if (x < x0) x0 = x;
+                if (x > x1) x1 = x;
+                if (y < y0) y0 = y;
+                if (y > y1) y1 = y;
+                tile_dirty[(y / TILE) * tiles_x + x / TILE] = 1;
+
+                uint16_t c = cur[i];
+                board_lcd_set_pixel_rgb(x, y, (c >> 8) & 0xF8, (c >> 3) & 0xFC, (c << 3) & 0xF8);
+            }
+        }
+
+        uint64_t bbox = 0, tiles = 0, tile_px = 0;
+        if (changed) {
+            bbox = (uint64_t)(x1 - x0 + 1) * (y1 - y0 + 1);
+            for (int ty = 0; ty < tiles_y; ty++) {
+                for (int tx = 0; tx < tiles_x; tx++) {
+                    if (!tile_dirty[ty * tiles_x + tx]) continue;
+                    int tw = (tx + 1) * TILE > w ? w - tx * TILE : TILE;
+                    int th = (ty + 1) * TILE > h ? h - ty * TILE : TILE;
+                    tiles++;
+                    tile_px += (uint64_t)tw * th;
+                }
+            }
+            sim_bus_account_window(x0, y0, x1 - x0 + 1, y1 - y0 + 1);
+        }
+
+        printf("%llu,%.1f,%llu,%.2f,%llu,%llu,%llu\n",
+               (unsigned long long)frames, rec.timestamp_us / 1000.0,
+               (unsigned long long)changed, 100.0 * changed / px,
+               (unsigned long long)bbox, (unsigned long long)tiles,
+               (unsigned long long)tile_px);
+
+        if (!fast && frames > 0 && rec.timestamp_us > last_ts) {
+            SDL_Delay((rec.timestamp_us - last_ts) / 1000);
+        }
+        last_ts = rec.timestamp_us;
+
+        // With nothing changed there is no window to charge; skip the flush
+        // so the bus model is not billed a full frame.
+        if (changed) sim_bus_flush();
+        if (!screencap_poll()) break;
+
+        memcpy(prev, cur, px * sizeof(uint16_t));
+        sum_changed += changed;
+        sum_bbox += bbox;
+        sum_tile_px += tile_px;
+        frames++;
+    }
+
+    if (frames) {
+        double full = (double)frames * px;
+        fprintf(stderr,
+                "%llu frames: changed %.1f%% of pixels; dirty rect pushes %.1f%%, "
+                "%dx%d tiles push %.1f%% of full-frame bytes\n",
+                (unsigned long long)frames, 100.0 * sum_changed / full,
+                100.0 * sum_bbox / full, TILE, TILE, 100.0 * sum_tile_px / full);
+    }
+
+    fbrec_reader_close(r);
+    free(prev);
+    free(tile_dirty);
+    screencap_destroy();
+    return 0;
+}
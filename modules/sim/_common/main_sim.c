@@ -5,10 +5,19 @@
 //
 // Headless:     ./__PROJECT_NAME___sim --screenshot out.png [--frames N]
 //   --frames 1 = first frame, --frames 2 = second frame, etc.
+//
+// Capture:      ./__PROJECT_NAME___sim --record capture.fbr
+//   (needs the --fbrec module) records every flush for __PROJECT_NAME___replay.
 
 #include <SDL2/SDL.h>
 #include "board_interface.h"
 #include "screencap.h"
+#include "sim_bus.h"
+
+#ifdef SIM_HAS_FBREC
+#include <string.h>
+#include "fbrec.h"
+#endif
 
 int   sim_argc;
 char **sim_argv;
@@ -20,6 +29,12 @@ int main(int argc, char **argv)
 
     board_init();
 
+#ifdef SIM_HAS_FBREC
+    for (int i = 1; i + 1 < argc; i++) {
+        if (strcmp(argv[i], "--record") == 0) fbrec_open(argv[i + 1]);
+    }
+#endif
+
     // Draw a gradient across the full display as a basic smoke test.
     // Replace this with your actual app rendering once you have it.
     int w = board_lcd_width(), h = board_lcd_height();
@@ -31,11 +46,14 @@ int main(int argc, char **argv)
                 0x40);
         }
     }
-    board_lcd_flush();
+    sim_bus_flush();            // board_lcd_flush() plus the bus/fbrec hook
 
     while (screencap_poll())
         SDL_Delay(16);
 
+#ifdef SIM_HAS_FBREC
+    fbrec_close();
+#endif
     screencap_destroy();
     return 0;
 }
@@ -0,0 +1,145 @@
+// sim_bus.c — display bus bandwidth model for the desktop sim.
+// See sim_bus.h. Parameters come from board.json via CMake definitions.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "board_interface.h"
+#include "sim_bus.h"
+
+#ifdef SIM_HAS_FBREC
+#include "fbrec.h"
+#endif
+
+#ifndef SIM_BUS_TYPE
+#define SIM_BUS_TYPE               "none"
+#endif
+#ifndef SIM_BUS_CLOCK_HZ
+#define SIM_BUS_CLOCK_HZ           0
+#endif
+#ifndef SIM_BUS_DATA_LINES
+#define SIM_BUS_DATA_LINES         1
+#endif
+#ifndef SIM_BUS_BITS_PER_PIXEL
+#define SIM_BUS_BITS_PER_PIXEL     16
+#endif
+#ifndef SIM_BUS_OVERHEAD_US
+#define SIM_BUS_OVERHEAD_US        0.0
+#endif
+#ifndef SIM_BUS_MAX_TRANSFER_BYTES
+#define SIM_BUS_MAX_TRANSFER_BYTES 0
+#endif
+#ifndef SIM_BUS_REPORT_EVERY
+#define SIM_BUS_REPORT_EVERY       120   // frames between periodic reports
+#endif
+
+static sim_bus_stats_t s_stats;
+static double s_frame_us;       // accumulated for the frame being built
+static int    s_frame_windows;
+static int    s_atexit_done;
+
+static double bits_per_us(void)
+{
+    return (double)SIM_BUS_CLOCK_HZ * SIM_BUS_DATA_LINES / 1e6;
+}
+
+void sim_bus_account_window(int x, int y, int w, int h)
+{
+    (void)x;
+    (void)y;
+    if (w <= 0 || h <= 0) return;
+
+    uint64_t bytes = (uint64_t)w * h * SIM_BUS_BITS_PER_PIXEL / 8;
+    uint64_t txns = 1;
+#if SIM_BUS_MAX_TRANSFER_BYTES > 0
+    txns = (bytes + SIM_BUS_MAX_TRANSFER_BYTES - 1) / SIM_BUS_MAX_TRANSFER_BYTES;
+#endif
+
+    double us = txns * SIM_BUS_OVERHEAD_US;
+    if (bits_per_us() > 0) {
+        us += bytes * 8.0 / bits_per_us();
+    }
+
+    s_stats.windows++;
+    s_stats.transactions += txns;
+    s_stats.bytes += bytes;
+    s_frame_us += us;
+    s_frame_windows++;
+}
+
+void sim_bus_end_frame(void)
+{
+    s_stats.frames++;
+    s_stats.last_frame_us = s_frame_us;
+    s_stats.total_us += s_frame_us;
+    if (s_frame_us > s_stats.max_frame_us) s_stats.max_frame_us = s_frame_us;
+    s_frame_us = 0;
+    s_frame_windows = 0;
+
+    if (s_stats.frames == 1 || s_stats.frames % SIM_BUS_REPORT_EVERY == 0) {
+        sim_bus_report();
+    }
+}
+
+void sim_bus_get_stats(sim_bus_stats_t *out)
+{
+    *out = s_stats;
+}
+
+void sim_bus_report(void)
+{
+    if (s_stats.frames == 0) return;
+
+    double avg_us = s_stats.total_us / s_stats.frames;
+    printf("[bus] %s %.1f MHz x%d: %llu frames, %.0f B/frame, %.2f ms avg, "
+           "%.2f ms worst",
+           SIM_BUS_TYPE, SIM_BUS_CLOCK_HZ / 1e6, SIM_BUS_DATA_LINES,
+           (unsigned long long)s_stats.frames,
+           (double)s_stats.bytes / s_stats.frames,
+           avg_us / 1000.0, s_stats.max_frame_us / 1000.0);
+    if (avg_us > 0) {
+        printf(" -> %.1f fps max (bus-bound)\n", 1e6 / avg_us);
+    } else {
+        printf(" (no bus timing for this board)\n");
+    }
+    fflush(stdout);
+}
+
+// Charge the frame being flushed and, with --record, capture it.
+static void flush_hook(void)
+{
+    if (!s_atexit_done) {
+        atexit(sim_bus_report);
+        s_atexit_done = 1;
+    }
+    if (s_frame_windows == 0) {
+        sim_bus_account_window(0, 0, board_lcd_width(), board_lcd_height());
+    }
+    sim_bus_end_frame();
+#ifdef SIM_HAS_FBREC
+    fbrec_capture_frame();      // no-op unless --record is active
+#endif
+}
+
+#ifdef SIM_BUS_WRAP
+// Linked in place of board_lcd_flush via -Wl,--wrap=board_lcd_flush, so every
+// flush the app makes goes through the hook.
+void __real_board_lcd_flush(void);
+
+void __wrap_board_lcd_flush(void)
+{
+    flush_hook();
+    __real_board_lcd_flush();
+}
+
+void sim_bus_flush(void)
+{
+    board_lcd_flush();          // the wrapper runs the hook
+}
+#else
+void sim_bus_flush(void)
+{
+    flush_hook();
+    board_lcd_flush();
+}
+#endif
@@ -0,0 +1,43 @@
+// sim_bus.h — display bus bandwidth model for the desktop sim.
+//
+// The sim presents frames instantly; on hardware the cost of a flush is the
+// time spent pushing pixels over SPI/QSPI/i80/DSI. This model charges every
+// flush with the bytes and transactions the real board would send, using the
+// bus parameters from board.json (compiled in as SIM_BUS_* definitions).
+//
+// Where the linker supports it (GNU ld/lld; CMake then defines SIM_BUS_WRAP),
+// board_lcd_flush() is wrapped at link time (-Wl,--wrap=board_lcd_flush), so
+// app code is accounted without changes. Apple's ld64 has no --wrap: there only
+// flushes made through sim_bus_flush() are charged and recorded, so call that
+// instead of board_lcd_flush() in sim code you want measured. A flush is charged as one full-screen
+// window unless the app reports the windows it would push with
+// sim_bus_account_window() first — use that to try partial/dirty-rect schemes.
+
+#pragma once
+
+#include <stdint.h>
+
+typedef struct {
+    uint64_t frames;          // flushes accounted
+    uint64_t windows;         // windows sent across all frames
+    uint64_t transactions;    // bus transactions (windows split into chunks)
+    uint64_t bytes;           // pixel payload bytes
+    double   total_us;        // predicted bus time, all frames
+    double   last_frame_us;   // predicted bus time of the most recent frame
+    double   max_frame_us;    // worst frame seen
+} sim_bus_stats_t;
+
+// Charge one window (x, y, w, h in pixels) to the frame being built.
+void sim_bus_account_window(int x, int y, int w, int h);
+
+// Close the current frame. Called by the flush hook.
+void sim_bus_end_frame(void);
+
+// Charge (and, with --record, capture) the frame, then board_lcd_flush().
+// Equivalent to board_lcd_flush() when SIM_BUS_WRAP is in effect.
+void sim_bus_flush(void);
+
+void sim_bus_get_stats(sim_bus_stats_t *out);
+
+// Print a one-line summary (bus, average/worst frame time, predicted FPS).
+void sim_bus_report(void);
@@ -0,0 +1,133 @@
+// Copyright 2026 David M. King
+// SPDX-License-Identifier: Apache-2.0
+//
+// One-euro touch filter with velocity extrapolation — see touch_filter.h.
+//
+// Positions are px in Q8, velocities px/s in Q8, cutoffs and smoothing
+// factors Q16. Intermediates use int64 so sample gaps up to MAX_DT_US and
+// speeds of several thousand px/s cannot overflow.
+
+#include "touch_filter.h"
+
+#include <stddef.h>
+
+#define MAX_DT_US      100000   // longer gaps are treated as this long
+#define MAX_SPEED_Q8   (100000 << 8)   // px/s; bounds bursts of near-simultaneous samples
+#define TWO_PI_MILLI   6283     // 2*pi * 1000
+
+// Smoothing factor for a first-order low-pass: alpha = r / (r + 1) with
+// r = 2*pi * cutoff * dt  (the one-euro filter's tau = 1 / (2*pi*fc)).
+static int32_t alpha_q16(int64_t cutoff_q16, int64_t dt_us)
+{
+    int64_t r_q16 = cutoff_q16 * dt_us * TWO_PI_MILLI / 1000000000LL;
+    return (int32_t)((r_q16 << 16) / (r_q16 + 65536));
+}
+
+static int32_t lowpass(int32_t prev, int32_t x, int32_t alpha)
+{
+    return prev + (int32_t)(((int64_t)(x - prev) * alpha) >> 16);
+}
+
+static void axis_update(const touch_filter_config_t *cfg, touch_filter_axis_t *a,
+                        int raw, int64_t dt_us)
+{
+    int32_t x_q8 = (int32_t)raw << 8;
+
+    // Velocity from consecutive raw samples (as in the original one-euro
+    // filter); differencing against the lagging filtered position would
+    // overstate it by lag / dt.
+    int64_t dx = (int64_t)(x_q8 - a->raw_q8) * 1000000 / dt_us;
+    if (dx > MAX_SPEED_Q8) dx = MAX_SPEED_Q8;
+    if (dx < -MAX_SPEED_Q8) dx = -MAX_SPEED_Q8;
+    int32_t dx_q8 = (int32_t)dx;
+    a->vel_q8 = lowpass(a->vel_q8, dx_q8, alpha_q16(cfg->d_cutoff_q16, dt_us));
+
+    int64_t speed_q8 = a->vel_q8 < 0 ? -(int64_t)a->vel_q8 : a->vel_q8;
+    int64_t cutoff_q16 = cfg->min_cutoff_q16 + ((cfg->beta_q16 * speed_q8) >> 8);
+    a->pos_q8 = lowpass(a->pos_q8, x_q8, alpha_q16(cutoff_q16, dt_us));
+    a->raw_q8 = x_q8;
+}
+
+static int axis_predict(const touch_filter_config_t *cfg, const touch_filter_axis_t *a,
+                        int64_t horizon_us)
+{
+    int64_t off_q8 = (int64_t)a->vel_q8 * horizon_us / 1000000;
+    int64_t cap_q8 = (int64_t)cfg->max_predict_px << 8;
+    if (off_q8 > cap_q8) off_q8 = cap_q8;
+    if (off_q8 < -cap_q8) off_q8 = -cap_q8;
+    return (int)((a->pos_q8 + off_q8 + 128) >> 8);
+}
+
+void touch_filter_init(touch_filter_t *f, const touch_filter_config_t *cfg)
+{
+    const touch_filter_config_t def = TOUCH_FILTER_DEFAULT_CONFIG();
+    f->cfg = cfg ? *cfg : def;
+    touch_filter_reset(f);
+}
+
+void touch_filter_reset(touch_filter_t *f)
+{
+    f->active = false;
+    f->last_us = 0;
+    f->x = (touch_filter_axis_t){0};
+    f->y = (touch_filter_axis_t){0};
+}
+
+void touch_filter_update(touch_filter_t *f, int x, int y, int64_t t_us)
+{
+    if (!f->active) {
+        f->x = (touch_filter_axis_t){ .pos_q8 = (int32_t)x << 8, .raw_q8 = (int32_t)x << 8 };
+        f->y = (touch_filter_axis_t){ .pos_q8 = (int32_t)y << 8, .raw_q8 = (int32_t)y << 8 };
+        f->last_us = t_us;
+        f->active = true;
+        return;
+    }
+
+    int64_t dt_us = t_us - f->last_us;
+    if (dt_us <= 0) {
+        return;     // duplicate or out-of-order sample
+    }
+    if (dt_us > MAX_DT_US) {
+        dt_us = MAX_DT_US;
+    }
+    axis_update(&f->cfg, &f->x, x, dt_us);
+    axis_update(&f->cfg, &f->y, y, dt_us);
+    f->last_us = t_us;
+}
+
+void touch_filter_feed(touch_filter_t *f, const board_touch_event_t *ev)
+{
+    // Other fingers on a multi-touch panel must not reset or steer the
+    // contact being followed.
+    if (f->active && ev->point.id != f->id) {
+        return;
+    }
+    f->id = ev->point.id;
+    switch (ev->type) {
+    case BOARD_TOUCH_PRESS:
+        touch_filter_reset(f);
+        touch_filter_update(f, ev->point.x, ev->point.y, ev->timestamp_us);
+        break;
+    case BOARD_TOUCH_MOVE:
+        touch_filter_update(f, ev->point.x, ev->point.y, ev->timestamp_us);
+        break;
+    case BOARD_TOUCH_RELEASE:
+        touch_filter_reset(f);
+        break;
+    }
+}
+
+void touch_filter_position(const touch_filter_t *f, int *x, int *y)
+{
+    if (x) *x = (f->x.pos_q8 + 128) >> 8;
+    if (y) *y = (f->y.pos_q8 + 128) >> 8;
+}
+
+void touch_filter_predict(const touch_filter_t *f, int64_t target_us, int *x, int *y)
+{
+    int64_t horizon_us = target_us - f->last_us;
+    if (horizon_us < 0) horizon_us = 0;
+    if (horizon_us > f->cfg.max_predict_us) horizon_us = f->cfg.max_predict_us;
+    if (x) *x = axis_predict(&f->cfg, &f->x, horizon_us);
+    if (y) *y = axis_predict(&f->cfg, &f->y, horizon_us);
+}
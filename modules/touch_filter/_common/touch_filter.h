@@ -0,0 +1,105 @@
+// Copyright 2026 David M. King
+// SPDX-License-Identifier: Apache-2.0
+
+// Predictive touch smoothing — one-euro filter plus velocity extrapolation,
+// in fixed point.
+//
+// The one-euro filter is a low-pass whose cutoff rises with speed: at rest
+// it suppresses sample jitter heavily, while a fast drag passes through
+// with little lag. The filtered velocity is then used to extrapolate the
+// position to a target time — normally when the frame being rendered will
+// be on glass — so a dragged object tracks the finger instead of trailing
+// it by the sampling + render + flush latency.
+//
+// Usage (UI loop):
+//   static touch_filter_t tf;
+//   touch_filter_init(&tf, NULL);                   // defaults
+//   ...
+//   board_touch_event_t ev[8];
+//   int n = board_touch_get_events(ev, 8);
+//   for (int i = 0; i < n; i++) touch_filter_feed(&tf, &ev[i]);
+//   if (touch_filter_active(&tf)) {
+//       int x, y;
+//       touch_filter_predict(&tf, esp_timer_get_time() + flush_us, &x, &y);
+//       ...draw at (x, y), then board_lcd_flush()...
+//   }
+//
+// flush_us is the expected render + flush time; the --latency module's
+// dequeue->render and render->flushed p50s are a good estimate.
+//
+// One filter follows one contact. On multi-touch panels (CST226, GT911,
+// ST7123) the event stream interleaves every finger, so touch_filter_feed()
+// latches the id of the contact that pressed first and ignores other ids
+// until that one is released; use one touch_filter_t per id to follow more.
+//
+// Portable C with no ESP-IDF dependencies (host-tested in tests/host/).
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "board_interface.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TOUCH_FILTER_Q16(x) ((int32_t)((x) * 65536.0))
+
+typedef struct {
+    int32_t min_cutoff_q16;     // Hz, Q16 — cutoff at rest (jitter vs. lag)
+    int32_t beta_q16;           // Hz per px/s, Q16 — cutoff increase with speed
+    int32_t d_cutoff_q16;       // Hz, Q16 — velocity smoothing cutoff
+    int32_t max_predict_us;     // extrapolation horizon cap
+    int32_t max_predict_px;     // extrapolation distance cap per axis
+} touch_filter_config_t;
+
+#define TOUCH_FILTER_DEFAULT_CONFIG() {             \
+    .min_cutoff_q16 = TOUCH_FILTER_Q16(1.0),        \
+    .beta_q16       = TOUCH_FILTER_Q16(0.05),       \
+    .d_cutoff_q16   = TOUCH_FILTER_Q16(4.0),        \
+    .max_predict_us = 80000,                        \
+    .max_predict_px = 64,                           \
+}
+
+typedef struct {
+    int32_t pos_q8;             // filtered position, px Q8
+    int32_t raw_q8;             // last raw sample, px Q8
+    int32_t vel_q8;             // filtered velocity, px/s Q8
+} touch_filter_axis_t;
+
+typedef struct {
+    touch_filter_config_t cfg;
+    bool active;                // a contact is down and has been sampled
+    uint8_t id;                 // contact id being followed (while active)
+    int64_t last_us;            // timestamp of the last sample
+    touch_filter_axis_t x, y;
+} touch_filter_t;
+
+// cfg may be NULL for TOUCH_FILTER_DEFAULT_CONFIG().
+void touch_filter_init(touch_filter_t *f, const touch_filter_config_t *cfg);
+
+// Forget the current contact (call on release).
+void touch_filter_reset(touch_filter_t *f);
+
+// Add one raw sample taken at t_us. The first sample after a reset
+// initialises the filter without smoothing.
+void touch_filter_update(touch_filter_t *f, int x, int y, int64_t t_us);
+
+// Convenience: PRESS resets then updates, MOVE updates, RELEASE resets.
+// While active only events for the latched contact id are used.
+void touch_filter_feed(touch_filter_t *f, const board_touch_event_t *ev);
+
+static inline bool touch_filter_active(const touch_filter_t *f) { return f->active; }
+
+// Smoothed position at the last sample.
+void touch_filter_position(const touch_filter_t *f, int *x, int *y);
+
+// Smoothed position extrapolated to target_us (e.g. expected flush-complete
+// time), capped by max_predict_us / max_predict_px.
+void touch_filter_predict(const touch_filter_t *f, int64_t target_us, int *x, int *y);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,116 @@
+# Copyright 2026 David M. King
+# SPDX-License-Identifier: Apache-2.0
+
+"""Host-compiled C and C++ tests.
+
+Portable modules (no ESP-IDF dependencies) are compiled with the host C
+compiler together with a small harness from tests/host/harness/ and driven
+from Python.  Vendored C++ components that build off-target (XPowersLib with
+register callbacks) use the host C++ compiler the same way.  A test is
+skipped if its compiler is not found; set CC / CXX to choose one.
+"""
+
+from __future__ import annotations
+
+import os
+import shutil
+import subprocess
+from pathlib import Path
+from typing import Callable
+
+import pytest
+
+from tests.conftest import REPO_ROOT
+
+
+HARNESS_DIR = Path(__file__).resolve().parent / "harness"
+TEMPLATE_MAIN = REPO_ROOT / "idf-templates" / "base_project" / "main"
+
+
+def _find_cc() -> str | None:
+    for cc in (os.environ.get("CC"), "cc", "gcc", "clang"):
+        if cc and shutil.which(cc):
+            return cc
+    return None
+
+
+def _find_cxx() -> str | None:
+    for cxx in (os.environ.get("CXX"), "c++", "g++", "clang++"):
+        if cxx and shutil.which(cxx):
+            return cxx
+    return None
+
+
+def _compile(cmd: list[str]) -> None:
+    result = subprocess.run(cmd, capture_output=True, text=True)
+    assert result.returncode == 0, f"compile failed:\n{result.stderr}"
+
+
+@pytest.fixture(scope="session")
+def host_cc() -> str:
+    cc = _find_cc()
+    if cc is None:
+        pytest.skip("no host C compiler available")
+    return cc
+
+
+@pytest.fixture(scope="session")
+def build_host_binary(host_cc: str, tmp_path_factory) -> Callable[..., Path]:
+    """Compile sources into an executable and return its path.
+
+    Usage: build_host_binary("name", [src, ...], include_dirs=[...], defines=[...])
+    board_interface.h from the base template is always on the include path.
+    """
+    out_dir = tmp_path_factory.mktemp("host_bin")
+
+    def _build(
+        name: str,
+        sources: list[Path],
+        include_dirs: list[Path] = (),
+        defines: list[str] = (),
+    ) -> Path:
+        exe = out_dir / name
+        cmd = [host_cc, "-std=c11", "-O2", "-Wall", "-Werror", "-o", str(exe)]
+        for inc in [TEMPLATE_MAIN, *include_dirs]:
+            cmd += ["-I", str(inc)]
+        cmd += [f"-D{d}" for d in defines]
+        cmd += [str(s) for s in sources]
+        cmd += ["-lm"]
+        _compile(cmd)
+        return exe
+
+    return _build
+
+
+@pytest.fixture(scope="session")
+def host_cxx() -> str:
+    cxx = _find_cxx()
+    if cxx is None:
+        pytest.skip("no host C++ compiler available")
+    return cxx
+
+
+@pytest.fixture(scope="session")
+def build_host_cxx_binary(host_cxx: str, tmp_path_factory) -> Callable[..., Path]:
+    """C++ counterpart of build_host_binary (C++17, no template include path).
+
+    Usage: build_host_cxx_binary("name", [src, ...], include_dirs=[...], defines=[...])
+    """
+    out_dir = tmp_path_factory.mktemp("host_cxx_bin")
+
+    def _build(
+        name: str,
+        sources: list[Path],
+        include_dirs: list[Path] = (),
+        defines: list[str] = (),
+    ) -> Path:
+        exe = out_dir / name
+        cmd = [host_cxx, "-std=c++17", "-O2", "-Wall", "-Werror", "-o", str(exe)]
+        for inc in include_dirs:
+            cmd += ["-I", str(inc)]
+        cmd += [f"-D{d}" for d in defines]
+        cmd += [str(s) for s in sources]
+        _compile(cmd)
+        return exe
+
+    return _build
@@ -0,0 +1,30 @@
+// Copyright 2026 David M. King
+// SPDX-License-Identifier: Apache-2.0
+
+// Host stand-in for esp-dsp's dsps_dotprod_s16(), for building modules with
+// CONFIG_RESAMPLER_ESP_DSP in tests/host/. It computes what the ANSI
+// reference does, and aborts where the ESP32-S3 (aes3) kernel would fall
+// back to the scalar one: an operand not 16-byte aligned, or a length that
+// is not a multiple of 8.
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+static inline int dsps_dotprod_s16(const int16_t *a, const int16_t *b, int16_t *d, int len,
+                                   int8_t shift)
+{
+    if (((uintptr_t)a | (uintptr_t)b) & 15 || len % 8 != 0) {
+        fprintf(stderr, "dsps_dotprod_s16: unaligned call (%p %p %d)\n",
+                (const void *)a, (const void *)b, len);
+        abort();
+    }
+    int32_t acc = 0x7fff >> shift;
+    for (int i = 0; i < len; i++) {
+        acc += (int32_t)a[i] * b[i];
+    }
+    *d = (int16_t)(acc >> (15 - shift));
+    return 0;
+}
@@ -0,0 +1,21 @@
+// Copyright 2026 David M. King
+// SPDX-License-Identifier: Apache-2.0
+
+// Host stand-in for the ESP-IDF aligned allocator (see dsps_dotprod.h).
+
+#pragma once
+
+#include <stdlib.h>
+
+#define MALLOC_CAP_DEFAULT 0
+
+static inline void *heap_caps_aligned_alloc(size_t alignment, size_t size, unsigned caps)
+{
+    (void)caps;
+    return aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+
+static inline void heap_caps_free(void *p)
+{
+    free(p);
+}
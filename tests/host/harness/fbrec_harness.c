@@ -0,0 +1,118 @@
+// Copyright 2026 David M. King
+// SPDX-License-Identifier: Apache-2.0
+
+// Records a few synthetic frames with fbrec and replays them with the
+// reader, comparing every decoded record with what was on screen.
+//
+//   fbrec_harness <file>
+//
+// Output: "<records> <raw_records> <delta_records> <raw_bytes> <file_bytes> <mismatches>"
+// where mismatches counts records whose replayed frame differs from the
+// framebuffer at the time it was captured.
+//
+//   fbrec_harness --fill <file>
+//
+// Records FRAMES noise frames (raw, W*H*2 bytes each) and reports how the
+// writer copes with the device: "<frames_recorded> <still_open> <close_ok>".
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "board_interface.h"
+#include "fbrec.h"
+
+#define W 64
+#define H 48
+#define FRAMES 8
+
+// Fake panel: native format is canonical RGB565.
+static uint16_t s_fb[W * H];
+
+int board_lcd_width(void) { return W; }
+int board_lcd_height(void) { return H; }
+uint16_t board_lcd_get_pixel_raw(int x, int y) { return s_fb[y * W + x]; }
+void board_lcd_unpack_rgb(uint16_t c, uint8_t *r, uint8_t *g, uint8_t *b)
+{
+    *r = (uint8_t)((c >> 11) << 3);
+    *g = (uint8_t)(((c >> 5) & 0x3F) << 2);
+    *b = (uint8_t)((c & 0x1F) << 3);
+}
+
+static uint32_t s_rng = 12345;
+static uint16_t rnd16(void)
+{
+    s_rng = s_rng * 1664525u + 1013904223u;
+    return (uint16_t)(s_rng >> 16);
+}
+
+static int fill(const char *path)
+{
+    if (!fbrec_open(path)) return 1;
+    int recorded = 0;
+    for (int f = 0; f < FRAMES; f++) {
+        for (int i = 0; i < W * H; i++) s_fb[i] = rnd16();
+        if (fbrec_capture_frame()) recorded++;
+    }
+    int still_open = fbrec_is_open();
+    int close_ok = fbrec_close();
+    printf("%d %d %d\n", recorded, still_open, close_ok);
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc == 3 && strcmp(argv[1], "--fill") == 0) return fill(argv[2]);
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s [--fill] <file>\n", argv[0]);
+        return 2;
+    }
+    // Expected screen after each record, in write order.
+    static uint16_t expect[FRAMES * 2][W * H];
+    int n_expect = 0;
+
+    if (!fbrec_open(argv[1])) return 1;
+    for (int f = 0; f < FRAMES; f++) {
+        if (f == 0) {
+            for (int i = 0; i < W * H; i++) s_fb[i] = rnd16();      // noise: stays raw
+        } else {
+            int x0 = (f * 7) % (W - 8), y0 = (f * 5) % (H - 8);    // small moving square
+            for (int y = y0; y < y0 + 8; y++) {
+                for (int x = x0; x < x0 + 8; x++) s_fb[y * W + x] = (uint16_t)(0xF800 >> f);
+            }
+        }
+        fbrec_capture_frame();
+        memcpy(expect[n_expect++], s_fb, sizeof(s_fb));
+
+        // An explicit window of fresh pixels, as the sim's flush hook passes.
+        uint16_t win[16 * 4];
+        for (int i = 0; i < 16 * 4; i++) win[i] = f & 1 ? rnd16() : (uint16_t)(0x07E0 + f);
+        int wx = 40 - f, wy = 30 + f;
+        fbrec_write_window(wx, wy, 16, 4, win);
+        for (int y = 0; y < 4; y++) memcpy(&s_fb[(wy + y) * W + wx], &win[y * 16], 16 * 2);
+        memcpy(expect[n_expect++], s_fb, sizeof(s_fb));
+    }
+    uint32_t records;
+    uint64_t raw_bytes, file_bytes;
+    if (!fbrec_close()) return 1;
+    fbrec_get_totals(&records, &raw_bytes, &file_bytes);
+
+    int w, h;
+    fbrec_reader_t *r = fbrec_reader_open(argv[1], &w, &h);
+    if (!r || w != W || h != H) return 1;
+    fbrec_record_t rec;
+    int n = 0, raw = 0, delta = 0, mismatches = 0;
+    while (fbrec_reader_next(r, &rec)) {
+        if (rec.encoding == FBREC_ENC_RAW) raw++; else delta++;
+        if (n >= n_expect || memcmp(fbrec_reader_frame(r), expect[n], sizeof(s_fb)) != 0) {
+            mismatches++;
+        }
+        n++;
+    }
+    fbrec_reader_close(r);
+    if (n != n_expect) mismatches += abs(n_expect - n);
+
+    printf("%u %d %d %llu %llu %d\n", (unsigned)records, raw, delta,
+           (unsigned long long)raw_bytes, (unsigned long long)file_bytes, mismatches);
+    return 0;
+}
@@ -0,0 +1,127 @@
+// Copyright 2026 David M. King
+// SPDX-License-Identifier: Apache-2.0
+
+// Replays an IMU trace through imu_fusion and prints the estimated
+// orientation after every sample, or times the filters.
+//
+//   imu_fusion_harness <madgwick|mahony> <float|fixed> [beta|kp] [ki] < trace
+//   imu_fusion_harness bench <iterations>
+//
+// Input lines:  <t_us> <gx> <gy> <gz> <ax> <ay> <az>   (deg/s, g)
+// Output lines: <t_us> <roll> <pitch> <yaw> <qw> <qx> <qy> <qz>   (degrees)
+// Bench lines:  <algo> <float|fixed> <ns_per_update>
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "imu_fusion.h"
+
+static int replay(imu_fusion_algo_t algo, int fixed, float gain, float ki)
+{
+    imu_fusion_config_t cfg = IMU_FUSION_DEFAULT_CONFIG(algo);
+    if (gain > 0) {
+        if (algo == IMU_FUSION_MADGWICK) cfg.beta = gain; else cfg.kp = gain;
+    }
+    cfg.ki = ki;
+
+    imu_fusion_t ff;
+    imu_fusion_q_t fq;
+    imu_fusion_init(&ff, &cfg);
+    imu_fusion_q_init(&fq, &cfg);
+
+    long long t, last = -1;
+    float g[3], a[3];
+    while (scanf("%lld %f %f %f %f %f %f", &t, &g[0], &g[1], &g[2], &a[0], &a[1], &a[2]) == 7) {
+        long long dt = last < 0 ? 0 : t - last;
+        last = t;
+        imu_quat_t q;
+        float roll, pitch, yaw;
+        if (fixed) {
+            int32_t gq[3], aq[3];
+            for (int i = 0; i < 3; i++) {
+                gq[i] = IMU_FUSION_DPS_TO_Q16(g[i]);
+                aq[i] = (int32_t)(a[i] * 8192.0f);     // +/-4 g raw counts
+            }
+            imu_fusion_q_update(&fq, gq, aq, (int32_t)dt);
+            imu_euler_cdeg_t e;
+            imu_fusion_q_get_euler(&fq, &e);
+            imu_fusion_q_get_quat(&fq, &q);
+            roll = e.roll / 100.0f;
+            pitch = e.pitch / 100.0f;
+            yaw = e.yaw / 100.0f;
+        } else {
+            imu_fusion_update(&ff, g, a, dt / 1e6f);
+            imu_euler_t e;
+            imu_fusion_get_euler(&ff, &e);
+            imu_fusion_get_quat(&ff, &q);
+            roll = e.roll;
+            pitch = e.pitch;
+            yaw = e.yaw;
+        }
+        printf("%lld %.3f %.3f %.3f %.6f %.6f %.6f %.6f\n",
+               t, roll, pitch, yaw, q.w, q.x, q.y, q.z);
+    }
+    return 0;
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static int bench(long iters)
+{
+    static const char *names[] = { "madgwick", "mahony" };
+    for (int algo = 0; algo < 2; algo++) {
+        imu_fusion_config_t cfg = IMU_FUSION_DEFAULT_CONFIG((imu_fusion_algo_t)algo);
+        cfg.ki = 0.1f;
+        imu_fusion_t ff;
+        imu_fusion_q_t fq;
+        imu_fusion_init(&ff, &cfg);
+        imu_fusion_q_init(&fq, &cfg);
+
+        volatile float sink = 0;
+        double t0 = now_ns();
+        for (long i = 0; i < iters; i++) {
+            float g[3] = { 10.0f + (i & 7), -5.0f, 2.0f };
+            float a[3] = { 0.1f, 0.05f * (i & 3), 0.99f };
+            imu_fusion_update(&ff, g, a, 0.001f);
+        }
+        sink += ff.q[0];
+        double t1 = now_ns();
+        for (long i = 0; i < iters; i++) {
+            int32_t g[3] = { IMU_FUSION_DPS_TO_Q16(10.0f + (i & 7)),
+                             IMU_FUSION_DPS_TO_Q16(-5.0f), IMU_FUSION_DPS_TO_Q16(2.0f) };
+            int32_t a[3] = { 819, (int32_t)(410 * (i & 3)), 8110 };
+            imu_fusion_q_update(&fq, g, a, 1000);
+        }
+        sink += fq.q[0];
+        double t2 = now_ns();
+        (void)sink;
+        printf("%s float %.1f\n", names[algo], (t1 - t0) / iters);
+        printf("%s fixed %.1f\n", names[algo], (t2 - t1) / iters);
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc >= 3 && strcmp(argv[1], "bench") == 0) {
+        return bench(atol(argv[2]));
+    }
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s <madgwick|mahony> <float|fixed> [gain] [ki]\n", argv[0]);
+        return 2;
+    }
+    imu_fusion_algo_t algo = strcmp(argv[1], "mahony") == 0 ? IMU_FUSION_MAHONY : IMU_FUSION_MADGWICK;
+    int fixed = strcmp(argv[2], "fixed") == 0;
+    float gain = argc > 3 ? (float)atof(argv[3]) : 0.0f;
+    float ki = argc > 4 ? (float)atof(argv[4]) : 0.0f;
+    return replay(algo, fixed, gain, ki);
+}
@@ -0,0 +1,156 @@
+// Copyright 2026 David M. King
+// SPDX-License-Identifier: Apache-2.0
+
+// Drives the resampler module from the host tests.
+//
+//   resampler_harness tone <in_rate> <out_rate> <freq_hz> [taps]
+//   resampler_harness stream <in_rate> <out_rate> <block> [taps] < samples
+//   resampler_harness bench <iterations>
+//
+// tone:   resamples 1 s of a sine at 16000 amplitude in 37-sample blocks,
+//         least-squares fits a sine at freq_hz to the settled output and
+//         prints "<count> <delay> <gain_db> <residual_db>"; residual is
+//         everything but the fitted tone, relative to the input amplitude.
+// stream: one sample per input line, pushed in <block>-sample pieces;
+//         prints one output sample per line.
+// bench:  "<in_rate> <out_rate> <ns_per_output_sample>" per rate pair.
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "resampler.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define AMPLITUDE 16000.0
+
+static int tone(uint32_t in_rate, uint32_t out_rate, double freq, int taps)
+{
+    resampler_t rs;
+    if (!resampler_init(&rs, in_rate, out_rate, taps)) return 1;
+
+    size_t out_cap = RESAMPLER_OUT_MAX(in_rate, in_rate, out_rate) + 64;
+    int16_t *out = malloc(out_cap * sizeof(int16_t));
+    int16_t block[37];
+    size_t n_out = 0;
+    for (uint32_t i = 0; i < in_rate; ) {
+        size_t n = 0;
+        for (; n < 37 && i < in_rate; n++, i++) {
+            block[n] = (int16_t)lrint(AMPLITUDE * sin(2.0 * M_PI * freq * i / in_rate));
+        }
+        n_out += resampler_process(&rs, block, n, &out[n_out]);
+    }
+
+    // Fit a*cos + b*sin + c over the settled part (normal equations).
+    size_t start = resampler_delay(&rs) * 2 + 16;
+    double s[3][4] = { { 0 } };
+    for (size_t k = start; k < n_out; k++) {
+        double w = 2.0 * M_PI * freq * k / out_rate;
+        double v[3] = { cos(w), sin(w), 1.0 };
+        for (int r = 0; r < 3; r++) {
+            for (int c = 0; c < 3; c++) s[r][c] += v[r] * v[c];
+            s[r][3] += v[r] * out[k];
+        }
+    }
+    for (int p = 0; p < 3; p++) {                   // Gauss-Jordan
+        for (int r = 0; r < 3; r++) {
+            if (r == p) continue;
+            double f = s[r][p] / s[p][p];
+            for (int c = p; c < 4; c++) s[r][c] -= f * s[p][c];
+        }
+    }
+    double a = s[0][3] / s[0][0], b = s[1][3] / s[1][1], dc = s[2][3] / s[2][2];
+    double err = 0.0;
+    for (size_t k = start; k < n_out; k++) {
+        double w = 2.0 * M_PI * freq * k / out_rate;
+        double e = out[k] - (a * cos(w) + b * sin(w) + dc);
+        err += e * e;
+    }
+    double amp = sqrt(a * a + b * b);
+    double rms = sqrt(err / (double)(n_out - start));
+    printf("%zu %u %.4f %.2f\n", n_out, (unsigned)resampler_delay(&rs),
+           20.0 * log10(fmax(amp, 1e-9) / AMPLITUDE),
+           20.0 * log10(fmax(rms * sqrt(2.0), 1e-9) / AMPLITUDE));
+    free(out);
+    resampler_free(&rs);
+    return 0;
+}
+
+static int stream(uint32_t in_rate, uint32_t out_rate, size_t block, int taps)
+{
+    resampler_t rs;
+    if (!resampler_init(&rs, in_rate, out_rate, taps) || block == 0) return 1;
+    int16_t *in = malloc(block * sizeof(int16_t));
+    int16_t *out = malloc(RESAMPLER_OUT_MAX(block, in_rate, out_rate) * sizeof(int16_t));
+    int v;
+    size_t n = 0;
+    for (;;) {
+        int got = scanf("%d", &v);
+        if (got == 1) in[n++] = (int16_t)v;
+        if (n == block || (got != 1 && n > 0)) {
+            size_t m = resampler_process(&rs, in, n, out);
+            for (size_t i = 0; i < m; i++) printf("%d\n", out[i]);
+            n = 0;
+        }
+        if (got != 1) break;
+    }
+    free(in);
+    free(out);
+    resampler_free(&rs);
+    return 0;
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static int bench(long iters)
+{
+    static const uint32_t pairs[][2] = {
+        { 16000, 48000 }, { 48000, 16000 }, { 44100, 48000 }, { 48000, 44100 },
+        { 8000, 44100 }, { 22050, 16000 },
+    };
+    int16_t in[256], out[RESAMPLER_OUT_MAX(256, 8000, 48000)];
+    for (int i = 0; i < 256; i++) in[i] = (int16_t)((i * 2654435761u) >> 17);
+    for (size_t p = 0; p < sizeof(pairs) / sizeof(pairs[0]); p++) {
+        resampler_t rs;
+        if (!resampler_init(&rs, pairs[p][0], pairs[p][1], RESAMPLER_DEFAULT_TAPS)) return 1;
+        size_t total = 0;
+        double t0 = now_ns();
+        for (long i = 0; i < iters; i++) {
+            total += resampler_process(&rs, in, 256, out);
+        }
+        double t1 = now_ns();
+        printf("%u %u %.1f\n", (unsigned)pairs[p][0], (unsigned)pairs[p][1],
+               total ? (t1 - t0) / total : 0.0);
+        resampler_free(&rs);
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc >= 3 && strcmp(argv[1], "bench") == 0) {
+        return bench(atol(argv[2]));
+    }
+    if (argc >= 5 && strcmp(argv[1], "tone") == 0) {
+        return tone((uint32_t)atol(argv[2]), (uint32_t)atol(argv[3]), atof(argv[4]),
+                    argc > 5 ? atoi(argv[5]) : RESAMPLER_DEFAULT_TAPS);
+    }
+    if (argc >= 5 && strcmp(argv[1], "stream") == 0) {
+        return stream((uint32_t)atol(argv[2]), (uint32_t)atol(argv[3]), (size_t)atol(argv[4]),
+                      argc > 5 ? atoi(argv[5]) : RESAMPLER_DEFAULT_TAPS);
+    }
+    fprintf(stderr, "usage: %s tone|stream|bench ...\n", argv[0]);
+    return 2;
+}
@@ -0,0 +1,50 @@
+// Copyright 2026 David M. King
+// SPDX-License-Identifier: Apache-2.0
+
+// Replays a touch trace through touch_filter and prints, for every input
+// line, the filtered position and the prediction horizon_us ahead.
+//
+//   touch_filter_harness <horizon_us> < trace
+//
+// Input lines:  <t_us> <P|M|R> <x> <y> [id]   (id defaults to 0)
+// Output lines: <t_us> <filtered_x> <filtered_y> <predicted_x> <predicted_y>
+//               (or "<t_us> -" after a release)
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "touch_filter.h"
+
+int main(int argc, char **argv)
+{
+    long long horizon_us = argc > 1 ? atoll(argv[1]) : 0;
+
+    touch_filter_t tf;
+    touch_filter_init(&tf, NULL);
+
+    char line[128];
+    while (fgets(line, sizeof(line), stdin)) {
+        long long t;
+        char type;
+        int x, y, id = 0;
+        if (sscanf(line, "%lld %c %d %d %d", &t, &type, &x, &y, &id) < 4) {
+            break;
+        }
+        board_touch_event_t ev = {
+            .type = type == 'P' ? BOARD_TOUCH_PRESS
+                  : type == 'M' ? BOARD_TOUCH_MOVE : BOARD_TOUCH_RELEASE,
+            .point = { .id = (uint8_t)id, .x = (int16_t)x, .y = (int16_t)y },
+            .timestamp_us = t,
+        };
+        touch_filter_feed(&tf, &ev);
+        if (!touch_filter_active(&tf)) {
+            printf("%lld -\n", t);
+            continue;
+        }
+        int fx, fy, px, py;
+        touch_filter_position(&tf, &fx, &fy);
+        touch_filter_predict(&tf, t + horizon_us, &px, &py);
+        printf("%lld %d %d %d %d\n", t, fx, fy, px, py);
+    }
+    return 0;
+}
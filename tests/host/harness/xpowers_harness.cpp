@@ -0,0 +1,363 @@
+// Copyright 2026 David M. King
+// SPDX-License-Identifier: Apache-2.0
+
+// Drives an XPowersLib PMU (t4s3_amoled_touch/components/XPowersLib) against
+// a fake I2C register file and reports bus traffic, to test the
+// XPowersCommon register shadow cache, the readSnapshot() burst reads and
+// the get<F>()/set<F>() field wrappers.
+// Built for XPowersAXP2101 by default, XPowersAXP192 with -DHARNESS_AXP192,
+// XPowersAXP202 with -DHARNESS_AXP202.
+//
+//   xpowers_harness < script
+//
+// Script lines (one command each, numbers in decimal or 0x hex):
+//   cache <on|burst|off>  enable (burst_ranges) / disable the shadow cache
+//   begin | end           beginRegisterBatch() / endRegisterBatch()
+//   set|clr <reg> <bit>   setRegisterBit() / clrRegisterBit()
+//   get <reg> <bit>       getRegisterBit()            -> "bit <0|1>"
+//   write <reg> <val>     writeRegister()
+//   read <reg>            readRegister()              -> "read <val>"
+//   boot                  power_driver.cpp's AXP2101 sequence + status log
+//   setv <rail> <mV>      set<RAIL>Voltage(), e.g. "setv ALDO1 1800"
+//   getv <rail>           get<RAIL>Voltage()          -> "mv <val>"
+//   on|off <rail>         enable<RAIL>() / disable<RAIL>()
+//   ison <rail>           isEnable<RAIL>()            -> "bit <0|1>"
+//                         (rails per chip in s_rails below; VOFF is
+//                         set/getSysPowerDownVoltage(), BTN the AXP2101
+//                         button cell charge voltage, neither has on/off)
+//   lowbat <warn> <off>   AXP2101 setLowBat{Warn,Shutdown}Threshold()
+//   getlowbat             -> "pct <warn>" and "pct <off>"
+//   telemetry             status/ADC/IRQ via the single-value getters
+//   snapshot              the same fields via readSnapshot()
+//                         -> both print "field <name> <value>" lines
+//                         (not on AXP202, which has no readSnapshot())
+//   poke <reg> <val>      change the fake chip behind the driver's back
+//   fill <seed>           fill the fake chip with pseudo-random bytes
+//   fail <0|1>            make bus writes fail
+//   trace <0|1>           print each bus write    -> "bus <reg> <len>"
+//   invalidate            invalidateRegisterCache()
+//   stats                 -> "stats <read xfers> <write xfers> <write bytes>"
+//   reg <reg>             fake chip register         -> "reg <val>"
+//   reset                 zero the traffic counters
+//
+// Commands that return bool print "ok <0|1>".
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(HARNESS_AXP192)
+#include "XPowersAXP192.tpp"
+typedef XPowersAXP192 Pmu;
+#elif defined(HARNESS_AXP202)
+#include "XPowersAXP202.tpp"
+typedef XPowersAXP202 Pmu;
+#else
+#define HARNESS_AXP2101
+#include "XPowersAXP2101.tpp"
+typedef XPowersAXP2101 Pmu;
+#endif
+
+static uint8_t s_regs[256];
+static int s_read_xfers, s_write_xfers, s_write_bytes;
+static bool s_fail_writes;
+static bool s_trace;
+
+static int fake_read(uint8_t addr, uint8_t reg, uint8_t *data, uint8_t len)
+{
+    (void)addr;
+    s_read_xfers++;
+    for (int i = 0; i < len; i++) {
+        data[i] = s_regs[(reg + i) & 0xFF];
+    }
+    return 0;
+}
+
+static int fake_write(uint8_t addr, uint8_t reg, uint8_t *data, uint8_t len)
+{
+    (void)addr;
+    s_write_xfers++;
+    if (s_trace) {
+        printf("bus %d %d\n", reg, len);
+    }
+    if (s_fail_writes) {
+        return -1;
+    }
+    s_write_bytes += len;
+    for (int i = 0; i < len; i++) {
+        s_regs[(reg + i) & 0xFF] = data[i];
+    }
+    return 0;
+}
+
+#ifndef HARNESS_AXP202
+static void field(const char *name, double value)
+{
+    printf("field %s %.3f\n", name, value);
+}
+#endif
+
+#ifdef HARNESS_AXP192
+
+static void telemetry(Pmu &pmu)
+{
+    field("acin_in", pmu.isAcinIn());
+    field("vbus_in", pmu.isVbusIn());
+    field("battery_connected", pmu.isBatteryConnect());
+    field("charging", pmu.isCharging());
+    field("acin_mv", pmu.getAcinVoltage());
+    field("acin_ma", pmu.getAcinCurrent());
+    field("vbus_mv", pmu.getVbusVoltage());
+    field("vbus_ma", pmu.getVbusCurrent());
+    field("batt_mv", pmu.getBattVoltage());
+    field("batt_charge_ma", pmu.getBatteryChargeCurrent());
+    field("batt_discharge_ma", pmu.getBattDischargeCurrent());
+    field("sys_mv", pmu.getSystemVoltage());
+    field("temperature", pmu.getTemperature());
+    field("irq_status", (double)pmu.getIrqStatus());
+}
+
+static void snapshot(Pmu &pmu)
+{
+    xpowers_axp192_snapshot_t s;
+    if (!pmu.readSnapshot(s)) {
+        printf("ok 0\n");
+        return;
+    }
+    field("acin_in", s.acin_in);
+    field("vbus_in", s.vbus_in);
+    field("battery_connected", s.battery_connected);
+    field("charging", s.charging);
+    field("acin_mv", s.acin_mv);
+    field("acin_ma", s.acin_ma);
+    field("vbus_mv", s.vbus_mv);
+    field("vbus_ma", s.vbus_ma);
+    field("batt_mv", s.batt_mv);
+    field("batt_charge_ma", s.batt_charge_ma);
+    field("batt_discharge_ma", s.batt_discharge_ma);
+    field("sys_mv", s.sys_mv);
+    field("temperature", s.temperature);
+    field("irq_status", (double)s.irq_status);
+}
+
+#elif defined(HARNESS_AXP2101)
+
+static void telemetry(Pmu &pmu)
+{
+    field("vbus_in", pmu.isVbusIn());
+    field("battery_connected", pmu.isBatteryConnect());
+    field("charging", pmu.isCharging());
+    field("charger_status", pmu.getChargerStatus());
+    field("batt_mv", pmu.getBattVoltage());
+    field("vbus_mv", pmu.getVbusVoltage());
+    field("sys_mv", pmu.getSystemVoltage());
+    field("ts_raw", pmu.getTsTemperature());
+    field("temperature", pmu.getTemperature());
+    field("irq_status", (double)pmu.getIrqStatus());
+}
+
+static void snapshot(Pmu &pmu)
+{
+    xpowers_axp2101_snapshot_t s;
+    if (!pmu.readSnapshot(s)) {
+        printf("ok 0\n");
+        return;
+    }
+    field("vbus_in", s.vbus_in);
+    field("battery_connected", s.battery_connected);
+    field("charging", s.charging);
+    field("charger_status", s.charger_status);
+    field("batt_mv", s.batt_mv);
+    field("vbus_mv", s.vbus_mv);
+    field("sys_mv", s.sys_mv);
+    field("ts_raw", s.ts_raw);
+    field("temperature", s.temperature);
+    field("irq_status", (double)s.irq_status);
+}
+
+// Same calls, in the same order, as the non-T-Watch AXP2101 branch of
+// power_driver_init(), including the rail status log.
+static void boot(Pmu &pmu)
+{
+    pmu.clearIrqStatus();
+
+    pmu.beginRegisterBatch();
+    pmu.setChargingLedMode(XPOWERS_CHG_LED_BLINK_4HZ);
+    pmu.setALDO1Voltage(1800);
+    pmu.enableALDO1();
+    pmu.setALDO3Voltage(3300);
+    pmu.enableALDO3();
+    pmu.setBLDO1Voltage(1800);
+    pmu.enableBLDO1();
+    pmu.disableDC2();
+    pmu.disableDC3();
+    pmu.disableDC4();
+    pmu.disableDC5();
+    pmu.disableCPUSLDO();
+    pmu.enableBattDetection();
+    pmu.enableVbusVoltageMeasure();
+    pmu.enableBattVoltageMeasure();
+    pmu.endRegisterBatch();
+
+    unsigned sum = 0;
+    sum += pmu.isEnableDC1() + pmu.getDC1Voltage();
+    sum += pmu.isEnableDC2() + pmu.getDC2Voltage();
+    sum += pmu.isEnableDC3() + pmu.getDC3Voltage();
+    sum += pmu.isEnableDC4() + pmu.getDC4Voltage();
+    sum += pmu.isEnableDC5() + pmu.getDC5Voltage();
+    sum += pmu.isEnableALDO1() + pmu.getALDO1Voltage();
+    sum += pmu.isEnableALDO2() + pmu.getALDO2Voltage();
+    sum += pmu.isEnableALDO3() + pmu.getALDO3Voltage();
+    sum += pmu.isEnableALDO4() + pmu.getALDO4Voltage();
+    sum += pmu.isEnableBLDO1() + pmu.getBLDO1Voltage();
+    sum += pmu.isEnableBLDO2() + pmu.getBLDO2Voltage();
+    sum += pmu.isEnableCPUSLDO() + pmu.getCPUSLDOVoltage();
+    sum += pmu.isEnableDLDO1() + pmu.getDLDO1Voltage();
+    sum += pmu.isEnableDLDO2() + pmu.getDLDO2Voltage();
+    printf("rails %u\n", sum);
+}
+
+#endif
+
+struct Rail {
+    const char *name;
+    bool (Pmu::*set_mv)(uint16_t);
+    uint16_t (Pmu::*get_mv)(void);
+    bool (Pmu::*enable)(void);
+    bool (Pmu::*disable)(void);
+    bool (Pmu::*is_enabled)(void);
+};
+
+#define RAIL(n) { #n, &Pmu::set##n##Voltage, &Pmu::get##n##Voltage, \
+                  &Pmu::enable##n, &Pmu::disable##n, &Pmu::isEnable##n }
+#define LEVEL(n, set, get) { #n, &Pmu::set, &Pmu::get, NULL, NULL, NULL }
+
+static const Rail s_rails[] = {
+#if defined(HARNESS_AXP192)
+    RAIL(DC1), RAIL(DC2), RAIL(DC3), RAIL(LDO2), RAIL(LDO3), RAIL(LDOio),
+#elif defined(HARNESS_AXP202)
+    RAIL(DC2), RAIL(DC3), RAIL(LDO2), RAIL(LDO3), RAIL(LDO4), RAIL(LDOio),
+#else
+    RAIL(DC1), RAIL(DC2), RAIL(DC3), RAIL(DC4), RAIL(DC5),
+    RAIL(ALDO1), RAIL(ALDO2), RAIL(ALDO3), RAIL(ALDO4),
+    RAIL(BLDO1), RAIL(BLDO2), RAIL(CPUSLDO), RAIL(DLDO1), RAIL(DLDO2),
+    LEVEL(BTN, setButtonBatteryChargeVoltage, getButtonBatteryVoltage),
+#endif
+    LEVEL(VOFF, setSysPowerDownVoltage, getSysPowerDownVoltage),
+};
+
+static const Rail *rail(const char *name)
+{
+    for (const Rail &r : s_rails) {
+        if (!strcmp(r.name, name)) {
+            return &r;
+        }
+    }
+    return NULL;
+}
+
+static const Rail *switched_rail(const char *name)
+{
+    const Rail *r = rail(name);
+    return r && r->enable ? r : NULL;
+}
+
+int main(void)
+{
+#if defined(HARNESS_AXP192)
+    const uint8_t id_reg = XPOWERS_AXP192_IC_TYPE, id = XPOWERS_AXP192_CHIP_ID;
+    const uint8_t addr = AXP192_SLAVE_ADDRESS;
+#elif defined(HARNESS_AXP202)
+    const uint8_t id_reg = XPOWERS_AXP202_IC_TYPE, id = XPOWERS_AXP202_CHIP_ID;
+    const uint8_t addr = AXP202_SLAVE_ADDRESS;
+#else
+    const uint8_t id_reg = XPOWERS_AXP2101_IC_TYPE, id = XPOWERS_AXP2101_CHIP_ID;
+    const uint8_t addr = AXP2101_SLAVE_ADDRESS;
+    // Power-on defaults for the rails touched by boot().
+    s_regs[XPOWERS_AXP2101_DC_ONOFF_DVM_CTRL] = 0x1F;
+    s_regs[XPOWERS_AXP2101_LDO_ONOFF_CTRL0]   = 0xFF;
+    s_regs[XPOWERS_AXP2101_ADC_CHANNEL_CTRL]  = 0x01;
+#endif
+    s_regs[id_reg] = id;
+
+    Pmu pmu;
+    if (!pmu.begin(addr, fake_read, fake_write)) {
+        fprintf(stderr, "begin failed\n");
+        return 1;
+    }
+
+    char cmd[32], arg[32];
+    while (scanf("%31s", cmd) == 1) {
+        int a = 0, b = 0;
+        if (!strcmp(cmd, "cache") && scanf("%31s", arg) == 1) {
+            if (!strcmp(arg, "off")) {
+                printf("ok %d\n", pmu.disableRegisterCache());
+            } else {
+                pmu.enableRegisterCache(!strcmp(arg, "burst"));
+            }
+        } else if (!strcmp(cmd, "begin")) {
+            pmu.beginRegisterBatch();
+        } else if (!strcmp(cmd, "end")) {
+            printf("ok %d\n", pmu.endRegisterBatch());
+        } else if (!strcmp(cmd, "set") && scanf("%i %i", &a, &b) == 2) {
+            printf("ok %d\n", pmu.setRegisterBit(a, b));
+        } else if (!strcmp(cmd, "clr") && scanf("%i %i", &a, &b) == 2) {
+            printf("ok %d\n", pmu.clrRegisterBit(a, b));
+        } else if (!strcmp(cmd, "get") && scanf("%i %i", &a, &b) == 2) {
+            printf("bit %d\n", pmu.getRegisterBit(a, b) ? 1 : 0);
+        } else if (!strcmp(cmd, "write") && scanf("%i %i", &a, &b) == 2) {
+            printf("ok %d\n", pmu.writeRegister(a, b) == 0);
+        } else if (!strcmp(cmd, "read") && scanf("%i", &a) == 1) {
+            printf("read %d\n", pmu.readRegister(a));
+        } else if (!strcmp(cmd, "setv") && scanf("%31s %i", arg, &a) == 2 && rail(arg)) {
+            printf("ok %d\n", (pmu.*rail(arg)->set_mv)(a));
+        } else if (!strcmp(cmd, "getv") && scanf("%31s", arg) == 1 && rail(arg)) {
+            printf("mv %d\n", (pmu.*rail(arg)->get_mv)());
+        } else if (!strcmp(cmd, "on") && scanf("%31s", arg) == 1 && switched_rail(arg)) {
+            printf("ok %d\n", (pmu.*rail(arg)->enable)());
+        } else if (!strcmp(cmd, "off") && scanf("%31s", arg) == 1 && switched_rail(arg)) {
+            printf("ok %d\n", (pmu.*rail(arg)->disable)());
+        } else if (!strcmp(cmd, "ison") && scanf("%31s", arg) == 1 && switched_rail(arg)) {
+            printf("bit %d\n", (pmu.*rail(arg)->is_enabled)() ? 1 : 0);
+#ifdef HARNESS_AXP2101
+        } else if (!strcmp(cmd, "boot")) {
+            boot(pmu);
+        } else if (!strcmp(cmd, "lowbat") && scanf("%i %i", &a, &b) == 2) {
+            pmu.setLowBatWarnThreshold(a);
+            pmu.setLowBatShutdownThreshold(b);
+        } else if (!strcmp(cmd, "getlowbat")) {
+            printf("pct %d\npct %d\n", pmu.getLowBatWarnThreshold(), pmu.getLowBatShutdownThreshold());
+#endif
+#ifndef HARNESS_AXP202
+        } else if (!strcmp(cmd, "telemetry")) {
+            telemetry(pmu);
+        } else if (!strcmp(cmd, "snapshot")) {
+            snapshot(pmu);
+#endif
+        } else if (!strcmp(cmd, "fill") && scanf("%i", &a) == 1) {
+            unsigned x = a * 2654435761u + 1;
+            for (int r = 0; r < 256; r++) {
+                x = x * 1103515245u + 12345u;
+                if (r != id_reg) s_regs[r] = x >> 16;
+            }
+        } else if (!strcmp(cmd, "poke") && scanf("%i %i", &a, &b) == 2) {
+            s_regs[a & 0xFF] = b;
+        } else if (!strcmp(cmd, "fail") && scanf("%i", &a) == 1) {
+            s_fail_writes = a;
+        } else if (!strcmp(cmd, "trace") && scanf("%i", &a) == 1) {
+            s_trace = a;
+        } else if (!strcmp(cmd, "invalidate")) {
+            pmu.invalidateRegisterCache();
+        } else if (!strcmp(cmd, "stats")) {
+            printf("stats %d %d %d\n", s_read_xfers, s_write_xfers, s_write_bytes);
+        } else if (!strcmp(cmd, "reg") && scanf("%i", &a) == 1) {
+            printf("reg %d\n", s_regs[a & 0xFF]);
+        } else if (!strcmp(cmd, "reset")) {
+            s_read_xfers = s_write_xfers = s_write_bytes = 0;
+        } else {
+            fprintf(stderr, "bad command: %s\n", cmd);
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,77 @@
+# Copyright 2026 David M. King
+# SPDX-License-Identifier: Apache-2.0
+
+"""Host round-trip test for modules/fbrec: encoder -> file -> replay decoder.
+
+The harness captures synthetic frames from a fake framebuffer (a noisy first
+frame, then small changes) plus explicit windows, and checks every replayed
+record against the screen at capture time.
+"""
+
+from __future__ import annotations
+
+import subprocess
+from pathlib import Path
+
+import pytest
+
+from tests.conftest import REPO_ROOT
+from tests.host.conftest import HARNESS_DIR
+
+
+MODULE_DIR = REPO_ROOT / "modules" / "fbrec" / "_common"
+
+
+@pytest.fixture(scope="module")
+def harness(build_host_binary) -> Path:
+    return build_host_binary(
+        "fbrec_harness",
+        [HARNESS_DIR / "fbrec_harness.c", MODULE_DIR / "fbrec.c"],
+        include_dirs=[MODULE_DIR],
+    )
+
+
+@pytest.fixture(scope="module")
+def result(harness, tmp_path_factory):
+    path = tmp_path_factory.mktemp("fbrec") / "capture.fbr"
+    out = subprocess.run([str(harness), str(path)], capture_output=True, text=True,
+                         check=True, timeout=30).stdout.splitlines()[-1].split()  # after fbrec logs
+    records, raw, delta, raw_bytes, file_bytes, mismatches = map(int, out)
+    return dict(records=records, raw=raw, delta=delta, raw_bytes=raw_bytes,
+                file_bytes=file_bytes, mismatches=mismatches, path=path)
+
+
+def test_replay_matches_capture(result):
+    assert result["records"] == 16
+    assert result["raw"] + result["delta"] == 16
+    assert result["mismatches"] == 0
+
+
+def test_both_encodings_are_exercised(result):
+    assert result["raw"] >= 1          # the noise frame
+    assert result["delta"] >= 1        # the small changes
+
+
+def test_delta_encoding_saves_space(result):
+    assert result["file_bytes"] < result["raw_bytes"] / 2
+    assert result["path"].stat().st_size == result["file_bytes"]
+
+
+def _fill(harness, path) -> tuple[int, int, int]:
+    out = subprocess.run([str(harness), "--fill", str(path)], capture_output=True, text=True,
+                         check=True, timeout=30).stdout.splitlines()[-1].split()
+    recorded, still_open, close_ok = map(int, out)
+    return recorded, still_open, close_ok
+
+
+def test_fill_records_every_frame(harness, tmp_path):
+    assert _fill(harness, tmp_path / "fill.fbr") == (8, 1, 1)
+
+
+@pytest.mark.skipif(not Path("/dev/full").exists(), reason="needs /dev/full")
+def test_write_failure_stops_recording_and_is_reported(harness):
+    # Every write to /dev/full fails once stdio's buffer spills.
+    recorded, still_open, close_ok = _fill(harness, "/dev/full")
+    assert recorded < 8
+    assert still_open == 0
+    assert close_ok == 0
@@ -0,0 +1,193 @@
+# Copyright 2026 David M. King
+# SPDX-License-Identifier: Apache-2.0
+
+"""Host tests for modules/imu_fusion: Madgwick / Mahony, float and fixed point.
+
+Traces are generated the way the QMI8658 records them: a known orientation
+path is integrated at the sample rate, and the gyro (deg/s, with bias and
+noise) and accelerometer (gravity in the body frame plus noise, in g) are
+derived from it.  Estimates are judged against that path.
+"""
+
+from __future__ import annotations
+
+import math
+import random
+import subprocess
+from pathlib import Path
+
+import pytest
+
+from tests.conftest import REPO_ROOT
+from tests.host.conftest import HARNESS_DIR
+
+
+MODULE_DIR = REPO_ROOT / "modules" / "imu_fusion" / "_common"
+
+VARIANTS = [
+    ("madgwick", "float"),
+    ("madgwick", "fixed"),
+    ("mahony", "float"),
+    ("mahony", "fixed"),
+]
+
+
+@pytest.fixture(scope="module")
+def harness(build_host_binary) -> Path:
+    return build_host_binary(
+        "imu_fusion_harness",
+        [HARNESS_DIR / "imu_fusion_harness.c", MODULE_DIR / "imu_fusion.c"],
+        include_dirs=[MODULE_DIR],
+    )
+
+
+# --- quaternion helpers (w, x, y, z; body -> world) ---
+
+def _qmul(a, b):
+    aw, ax, ay, az = a
+    bw, bx, by, bz = b
+    return (
+        aw * bw - ax * bx - ay * by - az * bz,
+        aw * bx + ax * bw + ay * bz - az * by,
+        aw * by - ax * bz + ay * bw + az * bx,
+        aw * bz + ax * by - ay * bx + az * bw,
+    )
+
+
+
+def _from_euler(roll, pitch, yaw):
+    cr, sr = math.cos(roll / 2), math.sin(roll / 2)
+    cp, sp = math.cos(pitch / 2), math.sin(pitch / 2)
+    cy, sy = math.cos(yaw / 2), math.sin(yaw / 2)
+    return (
+        cr * cp * cy + sr * sp * sy,
+        sr * cp * cy - cr * sp * sy,
+        cr * sp * cy + sr * cp * sy,
+        cr * cp * sy - sr * sp * cy,
+    )
+
+
+def _to_euler(q):
+    w, x, y, z = q
+    roll = math.atan2(2 * (w * x + y * z), 1 - 2 * (x * x + y * y))
+    pitch = math.asin(max(-1.0, min(1.0, 2 * (w * y - z * x))))
+    yaw = math.atan2(2 * (w * z + x * y), 1 - 2 * (y * y + z * z))
+    return tuple(math.degrees(a) for a in (roll, pitch, yaw))
+
+
+def _gravity_body(q):
+    w, x, y, z = q
+    return (2 * (x * z - w * y), 2 * (w * x + y * z), w * w - x * x - y * y + z * z)
+
+
+def _trace(euler_path, rate_hz, duration_s, gyro_bias=(0.0, 0.0, 0.0),
+           gyro_noise=0.0, accel_noise=0.0, seed=1):
+    """euler_path(t_s) -> (roll, pitch, yaw) in degrees.
+
+    Returns (rows, truth): rows = [(t_us, gx, gy, gz, ax, ay, az)] and
+    truth = [(roll, pitch, yaw)] at each row.
+    """
+    rng = random.Random(seed)
+    dt = 1.0 / rate_hz
+    rows, truth = [], []
+    n = int(duration_s * rate_hz)
+    q_prev = _from_euler(*(math.radians(a) for a in euler_path(0.0)))
+    for i in range(n + 1):
+        t = i * dt
+        q = _from_euler(*(math.radians(a) for a in euler_path(t)))
+        if sum(a * b for a, b in zip(q, q_prev)) < 0:
+            q = tuple(-c for c in q)
+        # Body rate over the last interval: q_prev* (x) q = (cos, axis sin) of half the rotation.
+        dq = _qmul((q_prev[0], -q_prev[1], -q_prev[2], -q_prev[3]), q)
+        angle = 2 * math.atan2(math.sqrt(dq[1] ** 2 + dq[2] ** 2 + dq[3] ** 2), dq[0])
+        s = math.sqrt(dq[1] ** 2 + dq[2] ** 2 + dq[3] ** 2)
+        rate = [0.0, 0.0, 0.0] if i == 0 or s == 0 else [angle / dt * c / s for c in dq[1:]]
+        gyro = [math.degrees(r) + b + rng.gauss(0, gyro_noise) for r, b in zip(rate, gyro_bias)]
+        accel = [g + rng.gauss(0, accel_noise) for g in _gravity_body(q)]
+        rows.append((round(t * 1e6), *gyro, *accel))
+        truth.append(_to_euler(q))
+        q_prev = q
+    return rows, truth
+
+
+def _run(harness: Path, algo: str, mode: str, rows, gain: float = 0.0, ki: float = 0.0):
+    text = "".join(
+        f"{t} {gx:.4f} {gy:.4f} {gz:.4f} {ax:.5f} {ay:.5f} {az:.5f}\n"
+        for t, gx, gy, gz, ax, ay, az in rows
+    )
+    out = subprocess.run(
+        [str(harness), algo, mode, str(gain), str(ki)],
+        input=text, capture_output=True, text=True, check=True,
+    ).stdout
+    return [tuple(float(v) for v in line.split()[1:4]) for line in out.splitlines()]
+
+
+def _wrap(d: float) -> float:
+    return (d + 180.0) % 360.0 - 180.0
+
+
+def _rms(errors) -> float:
+    errors = list(errors)
+    return math.sqrt(sum(e * e for e in errors) / len(errors))
+
+
+def test_harness_builds(harness):
+    assert harness.exists()
+
+
+@pytest.mark.parametrize("algo,mode", VARIANTS)
+def test_static_tilt_converges(harness, algo, mode):
+    rows, _ = _trace(lambda t: (35.0, -25.0, 0.0), 200, 8.0, accel_noise=0.005)
+    est = _run(harness, algo, mode, rows)
+    for roll, pitch, _yaw in est[-200:]:
+        assert abs(roll - 35.0) < 0.5
+        assert abs(pitch + 25.0) < 0.5
+
+
+@pytest.mark.parametrize("algo,mode", VARIANTS)
+def test_tracks_motion(harness, algo, mode):
+    def path(t):
+        return (30 * math.sin(2 * math.pi * 0.5 * t),
+                20 * math.sin(2 * math.pi * 0.3 * t + 1.0) - 20 * math.sin(1.0),
+                60.0 * t)      # continuous spin: yaw wraps through +/-180
+
+    rows, truth = _trace(path, 500, 10.0, gyro_bias=(0.3, -0.2, 0.1),
+                         gyro_noise=0.2, accel_noise=0.01)
+    est = _run(harness, algo, mode, rows)
+    steady = range(len(rows) // 4, len(rows))
+    assert _rms(est[i][0] - truth[i][0] for i in steady) < 2.0
+    assert _rms(est[i][1] - truth[i][1] for i in steady) < 2.0
+    # Yaw is gyro-only: bounded by bias drift (0.1 deg/s * 10 s) plus coupling.
+    assert _rms(_wrap(est[i][2] - truth[i][2]) for i in steady) < 3.0
+
+
+@pytest.mark.parametrize("algo", ["madgwick", "mahony"])
+def test_fixed_point_matches_float(harness, algo):
+    def path(t):
+        return (45 * math.sin(2 * math.pi * 0.4 * t), 25 * math.sin(2 * math.pi * 0.25 * t),
+                -90.0 * t)
+
+    rows, _ = _trace(path, 400, 6.0, gyro_noise=0.1, accel_noise=0.005, seed=7)
+    ref = _run(harness, algo, "float", rows)
+    fix = _run(harness, algo, "fixed", rows)
+    for axis in range(3):
+        assert _rms(_wrap(f[axis] - r[axis]) for f, r in zip(fix, ref)) < 0.2
+
+
+@pytest.mark.parametrize("mode", ["float", "fixed"])
+def test_mahony_integral_removes_gyro_bias(harness, mode):
+    rows, _ = _trace(lambda t: (0.0, 0.0, 0.0), 100, 40.0, gyro_bias=(2.0, -1.5, 0.0))
+    p_only = _run(harness, "mahony", mode, rows, gain=1.0, ki=0.0)
+    with_i = _run(harness, "mahony", mode, rows, gain=1.0, ki=0.2)
+    # Proportional-only settles at an offset of about bias / kp (~2 deg).
+    assert abs(p_only[-1][0]) > 1.0
+    assert abs(with_i[-1][0]) < 0.3
+    assert abs(with_i[-1][1]) < 0.3
+
+
+def test_bench_reports_all_variants(harness):
+    out = subprocess.run([str(harness), "bench", "20000"], capture_output=True, text=True,
+                         check=True).stdout
+    rows = {tuple(line.split()[:2]): float(line.split()[2]) for line in out.splitlines()}
+    assert set(rows) == set(VARIANTS)
+    assert all(ns > 0 for ns in rows.values())
@@ -0,0 +1,164 @@
+# Copyright 2026 David M. King
+# SPDX-License-Identifier: Apache-2.0
+
+"""Host tests for modules/resampler: polyphase Q15 sample-rate conversion.
+
+The harness resamples a sine in odd-sized blocks and fits a sine to the
+settled output, giving the gain at that frequency and the level of
+everything else (images, aliases, quantisation noise).  Rates are the
+common audio set; frequencies are placed relative to the lower rate of
+each pair, where the filter's passband and stopband are defined.
+The CONFIG_RESAMPLER_ESP_DSP build runs against harness/esp_dsp/, a
+stand-in for esp-dsp that rejects calls the S3 vector kernel would not take.
+"""
+
+from __future__ import annotations
+
+import random
+import subprocess
+from pathlib import Path
+
+import pytest
+
+from tests.conftest import REPO_ROOT
+from tests.host.conftest import HARNESS_DIR
+
+
+MODULE_DIR = REPO_ROOT / "modules" / "resampler" / "_common"
+
+RATES = [8000, 16000, 22050, 44100, 48000]
+PAIRS = [(a, b) for a in RATES for b in RATES if a != b]
+
+
+@pytest.fixture(scope="module")
+def harness(build_host_binary) -> Path:
+    return build_host_binary(
+        "resampler_harness",
+        [HARNESS_DIR / "resampler_harness.c", MODULE_DIR / "resampler.c"],
+        include_dirs=[MODULE_DIR],
+    )
+
+
+@pytest.fixture(scope="module")
+def dsp_harness(build_host_binary) -> Path:
+    # The CONFIG_RESAMPLER_ESP_DSP path against a stand-in dsps_dotprod_s16()
+    # that aborts on any call the S3 vector kernel would not take.
+    return build_host_binary(
+        "resampler_harness_dsp",
+        [HARNESS_DIR / "resampler_harness.c", MODULE_DIR / "resampler.c"],
+        include_dirs=[MODULE_DIR, HARNESS_DIR / "esp_dsp"],
+        defines=["CONFIG_RESAMPLER_ESP_DSP=1"],
+    )
+
+
+def _tone(harness: Path, in_rate: int, out_rate: int, freq: float, taps: int = 32):
+    out = subprocess.run(
+        [str(harness), "tone", str(in_rate), str(out_rate), str(freq), str(taps)],
+        capture_output=True, text=True, check=True, timeout=60,
+    ).stdout.split()
+    count, delay = int(out[0]), int(out[1])
+    return count, delay, float(out[2]), float(out[3])
+
+
+def _stream(harness: Path, in_rate: int, out_rate: int, block: int, samples: list[int]):
+    out = subprocess.run(
+        [str(harness), "stream", str(in_rate), str(out_rate), str(block)],
+        input="\n".join(map(str, samples)) + "\n",
+        capture_output=True, text=True, check=True, timeout=60,
+    ).stdout.split()
+    return [int(v) for v in out]
+
+
+def test_harness_builds(harness):
+    assert harness.exists()
+
+
+@pytest.mark.parametrize("in_rate,out_rate", PAIRS)
+def test_passband_is_flat_and_clean(harness, in_rate, out_rate):
+    freq = 0.25 * min(in_rate, out_rate)
+    count, _, gain_db, residual_db = _tone(harness, in_rate, out_rate, freq)
+    assert abs(count - out_rate) <= 1            # 1 s in, 1 s out
+    assert abs(gain_db) < 0.05
+    assert residual_db < -70.0
+
+
+@pytest.mark.parametrize("in_rate,out_rate", [(16000, 48000), (48000, 16000), (44100, 48000)])
+def test_passband_edge(harness, in_rate, out_rate):
+    # 32 taps pass up to 0.34 x the lower rate.
+    _, _, gain_db, _ = _tone(harness, in_rate, out_rate, 0.34 * min(in_rate, out_rate))
+    assert abs(gain_db) < 0.1
+
+
+@pytest.mark.parametrize("in_rate,out_rate", [(a, b) for a, b in PAIRS if a > b])
+def test_decimation_rejects_aliases(harness, in_rate, out_rate):
+    # A tone between the output and input Nyquist would alias; it must not
+    # come through.
+    freq = min(0.55 * out_rate, 0.48 * in_rate)
+    _, _, gain_db, _ = _tone(harness, in_rate, out_rate, freq)
+    assert gain_db < -70.0
+
+
+def test_more_taps_steepen_the_transition(harness):
+    freq = 0.45 * 44100
+    _, d32, g32, _ = _tone(harness, 44100, 48000, freq, taps=32)
+    _, d64, g64, _ = _tone(harness, 44100, 48000, freq, taps=64)
+    assert g64 > g32 + 6.0
+    assert d64 > d32                              # at the cost of delay
+
+
+@pytest.mark.parametrize("in_rate,out_rate", [(16000, 48000), (48000, 44100), (22050, 16000)])
+def test_output_does_not_depend_on_block_size(harness, in_rate, out_rate):
+    rng = random.Random(7)
+    samples = [rng.randint(-20000, 20000) for _ in range(3000)]
+    reference = _stream(harness, in_rate, out_rate, 1000, samples)
+    for block in (1, 37, 256, 3000):
+        assert _stream(harness, in_rate, out_rate, block, samples) == reference
+
+
+def test_same_rate_is_pass_through(harness):
+    samples = [0, 1, -1, 32767, -32768, 1234]
+    assert _stream(harness, 16000, 16000, 4, samples) == samples
+
+
+def test_full_scale_saturates_instead_of_wrapping(harness):
+    # A full-scale square wave overshoots after filtering; the output must
+    # clip at the rails rather than wrap to the opposite sign.
+    samples = ([32767] * 40 + [-32768] * 40) * 20
+    out = _stream(harness, 16000, 48000, 256, samples)
+    settled = out[200:]
+    assert max(settled) == 32767 and min(settled) == -32768
+    for prev, cur in zip(settled, settled[1:]):
+        assert abs(cur - prev) < 40000
+
+
+def test_bench_reports_all_pairs(harness):
+    out = subprocess.run([str(harness), "bench", "200"], capture_output=True, text=True,
+                         check=True, timeout=60).stdout.splitlines()
+    assert len(out) == 6
+    for line in out:
+        in_rate, out_rate, ns = line.split()
+        assert float(ns) > 0
+
+
+@pytest.mark.parametrize("in_rate,out_rate", [(16000, 48000), (48000, 16000), (44100, 48000),
+                                              (22050, 16000)])
+def test_esp_dsp_path_is_aligned_and_matches(harness, dsp_harness, in_rate, out_rate):
+    freq = 0.25 * min(in_rate, out_rate)
+    count, delay, gain_db, residual_db = _tone(dsp_harness, in_rate, out_rate, freq)
+    ref = _tone(harness, in_rate, out_rate, freq)
+    assert (count, delay) == ref[:2]
+    assert abs(gain_db - ref[2]) < 0.01
+    assert residual_db < -70.0
+
+    # Every window of a stream split at odd sizes hits the vector kernel
+    # and reads the same samples from whichever lane it is aligned in.
+    rng = random.Random(3)
+    samples = [rng.randint(-20000, 20000) for _ in range(2000)]
+    reference = _stream(dsp_harness, in_rate, out_rate, 1000, samples)
+    for block in (1, 37, 256):
+        assert _stream(dsp_harness, in_rate, out_rate, block, samples) == reference
+    # Half-scale (Q14) coefficients round differently from Q15 ones: a few
+    # LSB on near-full-scale noise.
+    scalar = _stream(harness, in_rate, out_rate, 1000, samples)
+    assert len(scalar) == len(reference)
+    assert max(abs(a - b) for a, b in zip(scalar, reference)) <= 16
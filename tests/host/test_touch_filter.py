@@ -0,0 +1,161 @@
+# Copyright 2026 David M. King
+# SPDX-License-Identifier: Apache-2.0
+
+"""Host tests for modules/touch_filter: one-euro smoothing + extrapolation.
+
+Traces mimic what the touch boards record: integer panel coordinates,
++/-2 px sample jitter, 50 ms polling (wvshr200_touch) or 5 ms sampling
+(CYD XPT2046).  The filter is judged against the true finger path.
+"""
+
+from __future__ import annotations
+
+import math
+import random
+import subprocess
+from pathlib import Path
+
+import pytest
+
+from tests.conftest import REPO_ROOT
+from tests.host.conftest import HARNESS_DIR
+
+
+MODULE_DIR = REPO_ROOT / "modules" / "touch_filter" / "_common"
+
+FLUSH_US = 35_000     # render + full-frame SPI flush on the slow boards
+
+
+@pytest.fixture(scope="module")
+def harness(build_host_binary) -> Path:
+    return build_host_binary(
+        "touch_filter_harness",
+        [HARNESS_DIR / "touch_filter_harness.c", MODULE_DIR / "touch_filter.c"],
+        include_dirs=[MODULE_DIR],
+    )
+
+
+def _trace(path, period_us: int, duration_us: int, jitter: float, seed: int = 1):
+    """Sample path(t_s) -> (x, y) with jitter. Returns [(t_us, type, x, y, true_x, true_y)]."""
+    rng = random.Random(seed)
+    rows = []
+    for i, t in enumerate(range(0, duration_us + 1, period_us)):
+        tx, ty = path(t / 1e6)
+        x = round(tx + rng.uniform(-jitter, jitter))
+        y = round(ty + rng.uniform(-jitter, jitter))
+        rows.append((t, "P" if i == 0 else "M", x, y, tx, ty))
+    return rows
+
+
+def _run(harness: Path, rows, horizon_us: int) -> list[tuple[int, ...]]:
+    text = "".join(f"{t} {k} {x} {y}\n" for t, k, x, y, *_ in rows)
+    out = subprocess.run(
+        [str(harness), str(horizon_us)], input=text, capture_output=True, text=True, check=True
+    ).stdout
+    result = []
+    for line in out.splitlines():
+        parts = line.split()
+        result.append(tuple(int(p) for p in parts) if parts[1] != "-" else (int(parts[0]),))
+    return result
+
+
+def _rms(errors) -> float:
+    errors = list(errors)
+    return math.sqrt(sum(e * e for e in errors) / len(errors))
+
+
+def test_harness_builds(harness):
+    assert harness.exists()
+
+
+def test_stationary_jitter_is_suppressed(harness):
+    rows = _trace(lambda t: (120.0, 160.0), 5_000, 1_000_000, jitter=3.0)
+    out = _run(harness, rows, 0)
+    settled = out[20:]
+    raw_err = _rms(math.hypot(r[2] - 120, r[3] - 160) for r in rows[20:])
+    filt_err = _rms(math.hypot(o[1] - 120, o[2] - 160) for o in settled)
+    assert filt_err < raw_err / 2
+
+
+@pytest.mark.parametrize("period_us", [5_000, 50_000])
+def test_prediction_hides_latency_on_drag(harness, period_us):
+    speed = 400.0   # px/s, a brisk drag
+    rows = _trace(lambda t: (20 + speed * t, 100.0), period_us, 600_000, jitter=1.0)
+    out = _run(harness, rows, FLUSH_US)
+
+    # Compare against where the finger really is when the frame reaches glass.
+    steady = range(len(rows) // 3, len(rows))
+    truth_x = [20 + speed * (rows[i][0] + FLUSH_US) / 1e6 for i in steady]
+    lag_err = _rms(rows[i][2] - tx for i, tx in zip(steady, truth_x))
+    pred_err = _rms(out[i][3] - tx for i, tx in zip(steady, truth_x))
+    assert pred_err < lag_err / 2
+
+
+def test_prediction_follows_curve(harness):
+    def circle(t):
+        a = 2 * math.pi * 0.8 * t
+        return 120 + 80 * math.cos(a), 160 + 80 * math.sin(a)
+
+    rows = _trace(circle, 10_000, 1_500_000, jitter=1.5)
+    out = _run(harness, rows, FLUSH_US)
+    steady = range(len(rows) // 3, len(rows))
+
+    def err(i, x, y):
+        tx, ty = circle((rows[i][0] + FLUSH_US) / 1e6)
+        return math.hypot(x - tx, y - ty)
+
+    lag_err = _rms(err(i, rows[i][2], rows[i][3]) for i in steady)
+    pred_err = _rms(err(i, out[i][3], out[i][4]) for i in steady)
+    assert pred_err < lag_err
+
+
+def test_prediction_is_capped(harness):
+    # A 1 s horizon at 2000 px/s would be 2000 px; the default cap is 64 px.
+    rows = _trace(lambda t: (2000 * t, 0.0), 5_000, 100_000, jitter=0.0)
+    out = _run(harness, rows, 1_000_000)
+    last = out[-1]
+    assert last[3] - last[1] <= 64
+
+
+def test_release_resets_filter(harness):
+    rows = [
+        (0, "P", 10, 10, 0, 0),
+        (10_000, "M", 20, 10, 0, 0),
+        (20_000, "R", 20, 10, 0, 0),
+        (30_000, "P", 200, 200, 0, 0),
+    ]
+    out = _run(harness, rows, FLUSH_US)
+    assert out[2] == (20_000,)
+    # Fresh press starts exactly at the touch point with no carried velocity.
+    assert out[3] == (30_000, 200, 200, 200, 200)
+
+
+def test_second_contact_is_ignored_until_the_first_releases(harness):
+    # Finger 0 drags; finger 1 presses, moves and releases elsewhere in the
+    # same event stream (as the multi-touch boards report them).
+    drag = _trace(lambda t: (20 + 400.0 * t, 100.0), 10_000, 300_000, jitter=1.0)
+    alone = _run(harness, drag, FLUSH_US)
+
+    mixed = []
+    for i, (t, k, x, y, *_) in enumerate(drag):
+        mixed.append(f"{t} {k} {x} {y} 0\n")
+        if i == 5:
+            mixed.append(f"{t + 1} P 220 300 1\n")
+        elif 5 < i < 20:
+            mixed.append(f"{t + 1} M {220 - 3 * i} 300 1\n")
+        elif i == 20:
+            mixed.append(f"{t + 1} R 160 300 1\n")
+    mixed.append("400000 R 140 100 0\n")
+    mixed.append("400001 M 150 300 1\n")
+    out = subprocess.run(
+        [str(harness), str(FLUSH_US)], input="".join(mixed),
+        capture_output=True, text=True, check=True,
+    ).stdout.splitlines()
+
+    finger0 = [tuple(int(p) for p in line.split()) for line, row in zip(out, mixed)
+               if row.rstrip().endswith(" 0") and " R " not in row]
+    assert finger0 == alone
+    # Finger 1's release did not end the track; finger 0's did, after which
+    # the remaining contact starts a fresh one at its own position.
+    assert out[-2] == "400000 -"
+    assert out[-1] == "400001 150 300 150 300"
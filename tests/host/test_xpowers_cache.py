@@ -0,0 +1,258 @@
+# Copyright 2026 David M. King
+# SPDX-License-Identifier: Apache-2.0
+
+"""Host tests for the XPowersLib register shadow cache (XPowersCommon).
+
+XPowersAXP2101 is driven through its register-callback begin() against a
+fake I2C register file that counts transfers, so each test can check both
+what ends up in the chip and how many bus round-trips it took.
+"""
+
+from __future__ import annotations
+
+import subprocess
+from pathlib import Path
+
+import pytest
+
+from tests.conftest import REPO_ROOT
+from tests.host.conftest import HARNESS_DIR
+
+
+XPOWERS_SRC = (
+    REPO_ROOT / "boards" / "lilygo" / "t4s3_amoled_touch" / "components" / "XPowersLib" / "src"
+)
+
+DC_ONOFF_DVM_CTRL = 0x80
+DC_VOL2_CTRL = 0x84
+LDO_ONOFF_CTRL0 = 0x90
+LDO_VOL0_CTRL = 0x92
+LDO_VOL1_CTRL = 0x93
+LDO_VOL2_CTRL = 0x94
+LDO_VOL4_CTRL = 0x96
+STATUS1 = 0x00
+INTSTS1 = 0x48
+
+
+@pytest.fixture(scope="module")
+def harness(build_host_cxx_binary) -> Path:
+    return build_host_cxx_binary(
+        "xpowers_harness",
+        [HARNESS_DIR / "xpowers_harness.cpp", XPOWERS_SRC / "XPowersLibInterface.cpp"],
+        include_dirs=[XPOWERS_SRC, XPOWERS_SRC / "REG"],
+    )
+
+
+def _run(harness: Path, script: str) -> list[str]:
+    out = subprocess.run(
+        [str(harness)], input=script, capture_output=True, text=True, check=True
+    ).stdout
+    return out.splitlines()
+
+
+def _stats(lines: list[str], index: int = -1) -> tuple[int, int, int]:
+    stats = [line for line in lines if line.startswith("stats")]
+    return tuple(int(v) for v in stats[index].split()[1:])
+
+
+def _values(lines: list[str], key: str) -> list[int]:
+    return [int(line.split()[1]) for line in lines if line.startswith(key + " ")]
+
+
+def _bus_writes(lines: list[str]) -> list[int]:
+    return _values(lines, "bus")
+
+
+def test_uncached_bit_update_is_read_modify_write(harness):
+    lines = _run(harness, f"reset\nset {LDO_ONOFF_CTRL0} 0\nset {LDO_ONOFF_CTRL0} 0\nstats\n")
+    assert _stats(lines) == (2, 2, 2)
+
+
+def test_cache_skips_reads_and_redundant_writes(harness):
+    lines = _run(harness, f"""cache on
+reset
+clr {LDO_ONOFF_CTRL0} 0
+clr {LDO_ONOFF_CTRL0} 0
+set {LDO_ONOFF_CTRL0} 0
+get {LDO_ONOFF_CTRL0} 0
+read {LDO_ONOFF_CTRL0}
+stats
+reg {LDO_ONOFF_CTRL0}
+""")
+    # One read to learn the register, then only the two real changes go out.
+    assert _stats(lines) == (1, 2, 2)
+    assert _values(lines, "bit") == [1]
+    assert _values(lines, "reg") == [0xFF]
+
+
+def test_batch_coalesces_bits_into_one_write(harness):
+    lines = _run(harness, f"""cache on
+reset
+begin
+clr {LDO_ONOFF_CTRL0} 0
+clr {LDO_ONOFF_CTRL0} 1
+clr {LDO_ONOFF_CTRL0} 4
+stats
+reg {LDO_ONOFF_CTRL0}
+end
+stats
+reg {LDO_ONOFF_CTRL0}
+""")
+    assert _stats(lines, 0) == (1, 0, 0)
+    assert _stats(lines, 1) == (1, 1, 1)
+    assert _values(lines, "reg") == [0xFF, 0xEC]
+
+
+def test_nested_batches_flush_once(harness):
+    lines = _run(harness, f"""cache on
+reset
+begin
+begin
+clr {LDO_ONOFF_CTRL0} 0
+end
+stats
+clr {LDO_ONOFF_CTRL0} 1
+end
+stats
+""")
+    assert _stats(lines, 0)[1] == 0
+    assert _stats(lines, 1)[1] == 1
+
+
+def test_batch_writes_voltages_before_the_enables_that_follow(harness):
+    lines = _run(harness, f"""poke {DC_ONOFF_DVM_CTRL} 0
+poke {LDO_ONOFF_CTRL0} 0
+cache on
+trace 1
+begin
+setv ALDO1 1800
+on ALDO1
+setv ALDO3 3300
+on ALDO3
+setv DC3 3300
+on DC3
+end
+""")
+    # Enabling a rail before its voltage lands would start it at the OTP
+    # default. The enable register moves behind its later rewrites.
+    assert _bus_writes(lines) == [
+        LDO_VOL0_CTRL, LDO_VOL2_CTRL, LDO_ONOFF_CTRL0, DC_VOL2_CTRL, DC_ONOFF_DVM_CTRL,
+    ]
+
+
+def test_batch_keeps_enable_first_when_the_program_did(harness):
+    lines = _run(harness, f"""poke {LDO_ONOFF_CTRL0} 0
+cache on
+trace 1
+begin
+on ALDO1
+setv ALDO1 1800
+end
+""")
+    assert _bus_writes(lines) == [LDO_ONOFF_CTRL0, LDO_VOL0_CTRL]
+
+
+@pytest.mark.parametrize("mode", ["on", "burst"])
+def test_boot_sequence_sets_voltages_before_enabling(harness, mode):
+    lines = _run(harness, f"cache {mode}\ntrace 1\nboot\n")
+    writes = _bus_writes(lines)
+    enable = len(writes) - 1 - writes[::-1].index(LDO_ONOFF_CTRL0)
+    for vol in (LDO_VOL0_CTRL, LDO_VOL2_CTRL, LDO_VOL4_CTRL):
+        assert writes.index(vol) < enable
+    assert len(writes) == len(set(writes))       # still one write per register
+
+
+@pytest.mark.parametrize("mode,writes", [("on", 3), ("burst", 1)])
+def test_contiguous_registers_burst_only_when_enabled(harness, mode, writes):
+    lines = _run(harness, f"""cache {mode}
+write {LDO_VOL0_CTRL} 1
+write {LDO_VOL1_CTRL} 2
+write {LDO_VOL2_CTRL} 3
+reset
+begin
+write {LDO_VOL0_CTRL} 11
+write {LDO_VOL1_CTRL} 12
+write {LDO_VOL2_CTRL} 13
+end
+stats
+reg {LDO_VOL0_CTRL}
+reg {LDO_VOL1_CTRL}
+reg {LDO_VOL2_CTRL}
+""")
+    assert _stats(lines) == (0, writes, 3)
+    assert _values(lines, "reg") == [11, 12, 13]
+
+
+def test_volatile_registers_always_hit_the_bus(harness):
+    lines = _run(harness, f"""cache on
+reset
+read {STATUS1}
+poke {STATUS1} 0x20
+read {STATUS1}
+begin
+write {INTSTS1} 0xFF
+stats
+end
+""")
+    assert _values(lines, "read") == [0, 0x20]
+    # IRQ status is write-1-to-clear: it must not wait for the batch to end.
+    assert _stats(lines) == (2, 1, 1)
+
+
+def test_invalidate_rereads_after_external_change(harness):
+    lines = _run(harness, f"""cache on
+read {LDO_VOL0_CTRL}
+poke {LDO_VOL0_CTRL} 0x17
+read {LDO_VOL0_CTRL}
+invalidate
+read {LDO_VOL0_CTRL}
+""")
+    assert _values(lines, "read") == [0, 0, 0x17]
+
+
+def test_failed_flush_is_reported_and_forgotten(harness):
+    lines = _run(harness, f"""cache on
+read {LDO_ONOFF_CTRL0}
+fail 1
+begin
+clr {LDO_ONOFF_CTRL0} 0
+end
+fail 0
+reset
+read {LDO_ONOFF_CTRL0}
+stats
+""")
+    assert _values(lines, "ok")[-1] == 0
+    # The chip still holds the old value, and the cache no longer claims otherwise.
+    assert _values(lines, "read") == [0xFF, 0xFF]
+    assert _stats(lines) == (1, 0, 0)
+
+
+def test_disable_flushes_pending_writes(harness):
+    lines = _run(harness, f"""cache on
+begin
+clr {LDO_ONOFF_CTRL0} 7
+cache off
+reg {LDO_ONOFF_CTRL0}
+reset
+set {LDO_ONOFF_CTRL0} 7
+stats
+""")
+    assert _values(lines, "ok")[-2:] == [1, 1]
+    assert _values(lines, "reg") == [0x7F]
+    assert _stats(lines) == (1, 1, 1)
+
+
+@pytest.mark.parametrize("mode", ["on", "burst"])
+def test_boot_sequence_roughly_halves_bus_traffic(harness, mode):
+    base = _run(harness, "reset\nboot\nstats\n" + "".join(f"reg {r}\n" for r in range(256)))
+    cached = _run(
+        harness, f"cache {mode}\nreset\nboot\nstats\n" + "".join(f"reg {r}\n" for r in range(256))
+    )
+    # Same end state in the chip and the same values reported by the getters.
+    assert _values(cached, "reg") == _values(base, "reg")
+    assert _values(cached, "rails") == _values(base, "rails")
+
+    base_xfers = sum(_stats(base)[:2])
+    cached_xfers = sum(_stats(cached)[:2])
+    assert cached_xfers <= 0.55 * base_xfers
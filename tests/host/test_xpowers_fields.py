@@ -0,0 +1,270 @@
+# Copyright 2026 David M. King
+# SPDX-License-Identifier: Apache-2.0
+
+"""Host tests for the XPowersLib field descriptors (XPowersField.hpp).
+
+The AXP2101, AXP192 and AXP202 rail setters and getters are thin
+get<F>()/set<F>() wrappers; these tests drive them through the fake register
+file and check the register encoding, range checks and bus cost of each one.
+"""
+
+from __future__ import annotations
+
+import subprocess
+from pathlib import Path
+
+import pytest
+
+from tests.conftest import REPO_ROOT
+from tests.host.conftest import HARNESS_DIR
+
+
+XPOWERS_SRC = (
+    REPO_ROOT / "boards" / "lilygo" / "t4s3_amoled_touch" / "components" / "XPowersLib" / "src"
+)
+
+DC_ONOFF = 0x80
+LDO_ONOFF0 = 0x90
+LDO_ONOFF1 = 0x91
+
+# rail: (voltage register, min mV, max mV, step mV, owns whole register)
+RAILS = {
+    "DC1": (0x82, 1500, 3400, 100, True),
+    "ALDO1": (0x92, 500, 3500, 100, False),
+    "ALDO2": (0x93, 500, 3500, 100, False),
+    "ALDO3": (0x94, 500, 3500, 100, False),
+    "ALDO4": (0x95, 500, 3500, 100, False),
+    "BLDO1": (0x96, 500, 3500, 100, False),
+    "BLDO2": (0x97, 500, 3500, 100, False),
+    "CPUSLDO": (0x98, 500, 1400, 50, False),
+    "DLDO1": (0x99, 500, 3400, 100, False),
+    "DLDO2": (0x9A, 500, 3400, 100, False),
+    "BTN": (0x6A, 2600, 3300, 100, False),
+    "VOFF": (0x24, 2600, 3300, 100, False),
+}
+
+# rail: (enable register, bit)
+ENABLES = {
+    "DC1": (DC_ONOFF, 0), "DC2": (DC_ONOFF, 1), "DC3": (DC_ONOFF, 2),
+    "DC4": (DC_ONOFF, 3), "DC5": (DC_ONOFF, 4),
+    "ALDO1": (LDO_ONOFF0, 0), "ALDO2": (LDO_ONOFF0, 1), "ALDO3": (LDO_ONOFF0, 2),
+    "ALDO4": (LDO_ONOFF0, 3), "BLDO1": (LDO_ONOFF0, 4), "BLDO2": (LDO_ONOFF0, 5),
+    "CPUSLDO": (LDO_ONOFF0, 6), "DLDO1": (LDO_ONOFF0, 7), "DLDO2": (LDO_ONOFF1, 0),
+}
+
+
+# AXP192 / AXP202 rail: (register, shift, width, min mV, max mV, step mV,
+# owns whole register). DC2 has six bits, so it stops at 2275 mV.
+AXP192_RAILS = {
+    "DC1": (0x26, 0, 7, 700, 3500, 25, False),
+    "DC2": (0x23, 0, 6, 700, 2275, 25, False),
+    "DC3": (0x27, 0, 7, 700, 3500, 25, True),
+    "LDO2": (0x28, 4, 4, 1800, 3300, 100, False),
+    "LDO3": (0x28, 0, 4, 1800, 3300, 100, False),
+    "LDOio": (0x91, 4, 4, 1800, 3300, 100, False),
+    "VOFF": (0x31, 0, 3, 2600, 3300, 100, False),
+}
+AXP202_RAILS = {
+    "DC2": (0x23, 0, 6, 700, 2275, 25, False),
+    "DC3": (0x27, 0, 7, 700, 3500, 25, True),
+    "LDO2": (0x28, 4, 4, 1800, 3300, 100, False),
+    "LDO3": (0x29, 0, 7, 1800, 3300, 100, False),
+    "LDOio": (0x91, 4, 4, 1800, 3300, 100, False),
+    "VOFF": (0x31, 0, 3, 2600, 3300, 100, False),
+}
+
+# Both chips keep their rail enables in REG 0x12; LDOio's is a GPIO0 mode.
+AXP192_ENABLES = {"DC1": 0, "DC3": 1, "LDO2": 2, "LDO3": 3, "DC2": 4}
+AXP202_ENABLES = {"DC3": 1, "LDO2": 2, "LDO4": 3, "DC2": 4, "LDO3": 6}
+POWER_CTL = 0x12
+
+LOW_BAT_WARN_SET = 0x1A
+
+
+def _build(build_host_cxx_binary, name: str, defines: list[str] = ()) -> Path:
+    return build_host_cxx_binary(
+        name,
+        [HARNESS_DIR / "xpowers_harness.cpp", XPOWERS_SRC / "XPowersLibInterface.cpp"],
+        include_dirs=[XPOWERS_SRC, XPOWERS_SRC / "REG"],
+        defines=defines,
+    )
+
+
+@pytest.fixture(scope="module")
+def harness(build_host_cxx_binary) -> Path:
+    return _build(build_host_cxx_binary, "xpowers_harness")
+
+
+@pytest.fixture(scope="module")
+def chips(build_host_cxx_binary) -> dict[str, Path]:
+    return {
+        "AXP192": _build(build_host_cxx_binary, "xpowers_harness_axp192", ["HARNESS_AXP192"]),
+        "AXP202": _build(build_host_cxx_binary, "xpowers_harness_axp202", ["HARNESS_AXP202"]),
+    }
+
+
+def _run(harness: Path, script: str) -> list[str]:
+    out = subprocess.run(
+        [str(harness)], input=script, capture_output=True, text=True, check=True
+    ).stdout
+    return out.splitlines()
+
+
+def _values(lines: list[str], key: str) -> list[int]:
+    return [int(line.split()[1]) for line in lines if line.startswith(key + " ")]
+
+
+def _stats(lines: list[str]) -> tuple[int, int, int]:
+    stats = [line for line in lines if line.startswith("stats")]
+    return tuple(int(v) for v in stats[-1].split()[1:])
+
+
+@pytest.mark.parametrize("rail", RAILS)
+def test_voltage_encoding_round_trips(harness, rail):
+    reg, lo, hi, step, whole = RAILS[rail]
+    script = ""
+    for mv in range(lo, hi + 1, step):
+        script += f"poke {reg} 0xE0\nreset\nsetv {rail} {mv}\nstats\nreg {reg}\ngetv {rail}\n"
+    lines = _run(harness, script)
+
+    expected = [(mv - lo) // step for mv in range(lo, hi + 1, step)]
+    upper = 0x00 if whole else 0xE0
+    assert _values(lines, "ok") == [1] * len(expected)
+    assert _values(lines, "reg") == [upper | raw for raw in expected]
+    assert _values(lines, "mv") == list(range(lo, hi + 1, step))
+
+
+@pytest.mark.parametrize("rail", RAILS)
+def test_bus_cost_matches_register_ownership(harness, rail):
+    _, lo, _, _, whole = RAILS[rail]
+    lines = _run(harness, f"reset\nsetv {rail} {lo}\nstats\n")
+    # A field that owns its register is written blind; others read first.
+    assert _stats(lines) == ((0 if whole else 1), 1, 1)
+
+
+@pytest.mark.parametrize("rail", RAILS)
+def test_rejected_voltages_never_touch_the_bus(harness, rail):
+    reg, lo, hi, step, _ = RAILS[rail]
+    bad = [lo - step, hi + step, lo + step // 2, 0]
+    lines = _run(harness, "poke %d 0x5A\nreset\n" % reg
+                 + "".join(f"setv {rail} {mv}\n" for mv in bad)
+                 + f"stats\nreg {reg}\n")
+    assert _values(lines, "ok") == [0] * len(bad)
+    assert _stats(lines) == (0, 0, 0)
+    assert _values(lines, "reg") == [0x5A]
+
+
+@pytest.mark.parametrize("rail", ENABLES)
+def test_enable_bits(harness, rail):
+    reg, bit = ENABLES[rail]
+    lines = _run(harness, f"""poke {reg} 0
+on {rail}
+ison {rail}
+reg {reg}
+poke {reg} 0xFF
+off {rail}
+ison {rail}
+reg {reg}
+""")
+    assert _values(lines, "ok") == [1, 1]
+    assert _values(lines, "bit") == [1, 0]
+    assert _values(lines, "reg") == [1 << bit, 0xFF & ~(1 << bit)]
+
+
+def test_field_writes_coalesce_in_a_batch(harness):
+    lines = _run(harness, f"""poke {LDO_ONOFF0} 0
+cache on
+reset
+begin
+on ALDO1
+on ALDO3
+on BLDO1
+off ALDO3
+setv ALDO1 1800
+setv ALDO1 3300
+end
+stats
+reg {LDO_ONOFF0}
+reg 0x92
+""")
+    # One read and one write per register, however many fields changed.
+    assert _stats(lines) == (2, 2, 2)
+    assert _values(lines, "reg") == [0x11, 28]
+
+
+def test_low_battery_thresholds(harness):
+    lines = _run(harness, f"""poke {LOW_BAT_WARN_SET} 0
+lowbat 15 7
+reg {LOW_BAT_WARN_SET}
+getlowbat
+lowbat 20 40
+reg {LOW_BAT_WARN_SET}
+lowbat 4 0
+reg {LOW_BAT_WARN_SET}
+getlowbat
+""")
+    # Warning is 5..20 % in the high nibble; out-of-range warnings are
+    # ignored, shutdown clamps to 15 %.
+    assert _values(lines, "reg") == [(10 << 4) | 7, (15 << 4) | 15, (15 << 4) | 0]
+    assert _values(lines, "pct") == [15, 7, 20, 0]
+
+
+def _chip_rails():
+    return [("AXP192", r) for r in AXP192_RAILS] + [("AXP202", r) for r in AXP202_RAILS]
+
+
+def _chip_enables():
+    return [("AXP192", r) for r in AXP192_ENABLES] + [("AXP202", r) for r in AXP202_ENABLES]
+
+
+def _rail(chip: str, rail: str):
+    return (AXP192_RAILS if chip == "AXP192" else AXP202_RAILS)[rail]
+
+
+@pytest.mark.parametrize("chip,rail", _chip_rails())
+def test_axp192_axp202_voltage_encoding_round_trips(chips, chip, rail):
+    reg, shift, width, lo, hi, step, whole = _rail(chip, rail)
+    # Bit 7 stays clear so AXP202 LDO3 is not in VBUS pass-through.
+    background = 0x5A
+    script = ""
+    for mv in range(lo, hi + 1, step):
+        script += f"poke {reg} {background}\nreset\nsetv {rail} {mv}\nstats\nreg {reg}\ngetv {rail}\n"
+    lines = _run(chips[chip], script)
+
+    mask = ((1 << width) - 1) << shift
+    kept = 0 if whole else background & ~mask
+    expected = [kept | ((mv - lo) // step) << shift for mv in range(lo, hi + 1, step)]
+    assert _values(lines, "ok") == [1] * len(expected)
+    assert _values(lines, "reg") == expected
+    assert _values(lines, "mv") == list(range(lo, hi + 1, step))
+    stats = [tuple(int(v) for v in line.split()[1:]) for line in lines if line.startswith("stats")]
+    assert set(stats) == {((0 if whole else 1), 1, 1)}
+
+
+@pytest.mark.parametrize("chip,rail", _chip_rails())
+def test_axp192_axp202_rejected_voltages_never_touch_the_bus(chips, chip, rail):
+    reg, _, _, lo, hi, step, _ = _rail(chip, rail)
+    bad = [lo - step, hi + step, lo + step // 2, 0]
+    lines = _run(chips[chip], "poke %d 0x5A\nreset\n" % reg
+                 + "".join(f"setv {rail} {mv}\n" for mv in bad)
+                 + f"stats\nreg {reg}\n")
+    assert _values(lines, "ok") == [0] * len(bad)
+    assert _stats(lines) == (0, 0, 0)
+    assert _values(lines, "reg") == [0x5A]
+
+
+@pytest.mark.parametrize("chip,rail", _chip_enables())
+def test_axp192_axp202_enable_bits(chips, chip, rail):
+    bit = (AXP192_ENABLES if chip == "AXP192" else AXP202_ENABLES)[rail]
+    lines = _run(chips[chip], f"""poke {POWER_CTL} 0
+on {rail}
+ison {rail}
+reg {POWER_CTL}
+poke {POWER_CTL} 0xFF
+off {rail}
+ison {rail}
+reg {POWER_CTL}
+""")
+    assert _values(lines, "ok") == [1, 1]
+    assert _values(lines, "bit") == [1, 0]
+    assert _values(lines, "reg") == [1 << bit, 0xFF & ~(1 << bit)]
@@ -0,0 +1,114 @@
+# Copyright 2026 David M. King
+# SPDX-License-Identifier: Apache-2.0
+
+"""Host tests for the XPowersLib readSnapshot() burst reads (AXP2101, AXP192).
+
+Each chip is driven against a fake register file filled with pseudo-random
+bytes; the snapshot must decode every field exactly as the single-value
+getters do, in one bus transfer.
+"""
+
+from __future__ import annotations
+
+import subprocess
+from pathlib import Path
+
+import pytest
+
+from tests.conftest import REPO_ROOT
+from tests.host.conftest import HARNESS_DIR
+
+
+XPOWERS_SRC = (
+    REPO_ROOT / "boards" / "lilygo" / "t4s3_amoled_touch" / "components" / "XPowersLib" / "src"
+)
+
+ADC_CHANNEL_CTRL = 0x30     # AXP2101, cacheable and inside the snapshot block
+
+
+def _build(build_host_cxx_binary, name: str, defines: list[str]) -> Path:
+    return build_host_cxx_binary(
+        name,
+        [HARNESS_DIR / "xpowers_harness.cpp", XPOWERS_SRC / "XPowersLibInterface.cpp"],
+        include_dirs=[XPOWERS_SRC, XPOWERS_SRC / "REG"],
+        defines=defines,
+    )
+
+
+@pytest.fixture(scope="module", params=["axp2101", "axp192"])
+def harness(request, build_host_cxx_binary) -> Path:
+    defines = ["HARNESS_AXP192"] if request.param == "axp192" else []
+    return _build(build_host_cxx_binary, f"xpowers_harness_{request.param}", defines)
+
+
+@pytest.fixture(scope="module")
+def axp2101(build_host_cxx_binary) -> Path:
+    return _build(build_host_cxx_binary, "xpowers_harness_axp2101", [])
+
+
+def _run(harness: Path, script: str) -> list[str]:
+    out = subprocess.run(
+        [str(harness)], input=script, capture_output=True, text=True, check=True
+    ).stdout
+    return out.splitlines()
+
+
+def _section(lines: list[str], start: int) -> tuple[dict[str, str], tuple[int, ...]]:
+    """Fields printed from lines[start] up to the next stats line, and that stats line."""
+    fields = {}
+    for line in lines[start:]:
+        parts = line.split()
+        if parts[0] == "stats":
+            return fields, tuple(int(v) for v in parts[1:])
+        fields[parts[1]] = parts[2]
+    raise AssertionError("no stats line")
+
+
+@pytest.mark.parametrize("seed", range(12))
+def test_snapshot_matches_getters_in_one_transfer(harness, seed):
+    lines = _run(harness, f"fill {seed}\nreset\ntelemetry\nstats\nreset\nsnapshot\nstats\n")
+    split = next(i for i, line in enumerate(lines) if line.startswith("stats")) + 1
+    getters, getter_stats = _section(lines, 0)
+    snap, snap_stats = _section(lines, split)
+
+    assert snap == getters
+    assert snap_stats == (1, 0, 0)
+    assert getter_stats[0] >= 10
+
+
+def test_snapshot_covers_connected_and_disconnected_states(harness):
+    seen: dict[str, set[str]] = {}
+    for seed in range(12):
+        snap, _ = _section(_run(harness, f"fill {seed}\nsnapshot\nstats\n"), 0)
+        for key in ("vbus_in", "battery_connected"):
+            seen.setdefault(key, set()).add(snap[key])
+    # The seeds above exercise both sides of every presence check.
+    assert all(values == {"0.000", "1.000"} for values in seen.values())
+
+
+def test_snapshot_refreshes_register_cache(axp2101):
+    lines = _run(axp2101, f"""cache on
+fill 5
+reset
+snapshot
+read {ADC_CHANNEL_CTRL}
+stats
+reg {ADC_CHANNEL_CTRL}
+""")
+    read = int(next(line for line in lines if line.startswith("read")).split()[1])
+    reg = int(next(line for line in lines if line.startswith("reg")).split()[1])
+    stats = next(line for line in lines if line.startswith("stats")).split()[1:]
+    assert read == reg
+    assert stats == ["1", "0", "0"]
+
+
+def test_snapshot_keeps_pending_batched_write(axp2101):
+    lines = _run(axp2101, f"""cache on
+poke {ADC_CHANNEL_CTRL} 0
+begin
+write {ADC_CHANNEL_CTRL} 0x0D
+snapshot
+end
+reg {ADC_CHANNEL_CTRL}
+""")
+    assert lines[-1] == "reg 13"
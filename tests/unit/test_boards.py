@@ -60,6 +60,12 @@ class TestListBoards:
                     f"{b.board_id}: non-string feature {f!r}"
                 )
 
+    def test_lcd_boards_describe_their_bus(self):
+        for b in list_boards():
+            if b.screen and b.screen.width:
+                assert b.bus is not None, f"{b.board_id}: LCD board without a bus section"
+                assert b.bus.clock_hz > 0, f"{b.board_id}: bus clock_hz must be positive"
+
 
 class TestLoadBoardInfo:
     def _make_board_dir(self, tmp_path: Path) -> Path:
@@ -144,6 +150,42 @@ class TestLoadBoardInfo:
 
         assert info.traits.count("ips") == 1
 
+    def test_bus_section_parsed(self, tmp_path: Path):
+        board_dir = self._make_board_dir(tmp_path)
+        (board_dir / "board.json").write_text(json.dumps({
+            "bus": {
+                "type": "qspi",
+                "clock_hz": 40000000,
+                "data_lines": 4,
+                "overhead_us": 40,
+                "max_transfer_bytes": 32768,
+            },
+        }))
+
+        info = _load_board_info("test/bus", board_dir)
+
+        assert info.bus is not None
+        assert info.bus.type == "qspi"
+        assert info.bus.clock_hz == 40000000
+        assert info.bus.data_lines == 4
+        assert info.bus.bits_per_pixel == 16     # default
+        assert info.bus.overhead_us == 40.0
+        assert info.bus.max_transfer_bytes == 32768
+
+    def test_missing_bus_is_none(self, tmp_path: Path):
+        board_dir = self._make_board_dir(tmp_path)
+        (board_dir / "board.json").write_text(json.dumps({}))
+
+        assert _load_board_info("test/nobus", board_dir).bus is None
+
+    def test_malformed_bus_does_not_raise(self, tmp_path: Path):
+        board_dir = self._make_board_dir(tmp_path)
+        (board_dir / "board.json").write_text(json.dumps({
+            "bus": {"type": "spi", "clock_hz": "fast"},
+        }))
+
+        assert _load_board_info("test/badbus", board_dir).bus is None
+
     def test_invalid_json_raises_system_exit(self, tmp_path: Path):
         board_dir = self._make_board_dir(tmp_path)
         (board_dir / "board.json").write_text("{bad json}")
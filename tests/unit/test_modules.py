@@ -10,7 +10,7 @@ from unittest.mock import MagicMock, patch
 
 import pytest
 
-from idf_new.boards import BoardInfo, BoardScreen
+from idf_new.boards import BoardBus, BoardInfo, BoardScreen
 from idf_new.modules import ModuleContext, get_module, list_modules
 from idf_new.paths import TEMPLATES_DIR
 from idf_new.project import Project, create_project, install_board
@@ -67,6 +67,11 @@ class TestRegistry:
         assert "gps_neo6m" in flags
         assert "gps_atgm336h" in flags
         assert "sim" in flags
+        assert "fbrec" in flags
+        assert "latency" in flags
+        assert "touch_filter" in flags
+        assert "imu_fusion" in flags
+        assert "resampler" in flags
 
     def test_get_module_by_flag(self):
         mod = get_module("gps_neo6m")
@@ -149,6 +154,97 @@ class TestGpsAtgm336h:
 # ---------------------------------------------------------------------------
 
 
+class TestFbrecModule:
+    def test_apply_copies_sources(self, tmp_path: Path):
+        ctx = _make_context(tmp_path)
+        get_module("fbrec").apply(ctx)
+        assert (ctx.main_dir / "fbrec.c").exists()
+        assert (ctx.main_dir / "fbrec.h").exists()
+
+    def test_apply_adds_source_to_cmake_extra(self, tmp_path: Path):
+        ctx = _make_context(tmp_path)
+        get_module("fbrec").apply(ctx)
+        assert 'list(APPEND EXTRA_SRCS "fbrec.c")' in ctx.cmake_extra_path.read_text()
+
+    def test_apply_merges_kconfig(self, tmp_path: Path):
+        ctx = _make_context(tmp_path)
+        get_module("fbrec").apply(ctx)
+        assert "FBREC_PATH" in (ctx.main_dir / "Kconfig.projbuild").read_text()
+
+
+class TestLatencyModule:
+    def test_apply_copies_sources(self, tmp_path: Path):
+        ctx = _make_context(tmp_path)
+        get_module("latency").apply(ctx)
+        assert (ctx.main_dir / "latency.c").exists()
+        assert (ctx.main_dir / "latency.h").exists()
+
+    def test_apply_adds_source_to_cmake_extra(self, tmp_path: Path):
+        ctx = _make_context(tmp_path)
+        get_module("latency").apply(ctx)
+        assert 'list(APPEND EXTRA_SRCS "latency.c")' in ctx.cmake_extra_path.read_text()
+
+    def test_apply_merges_kconfig(self, tmp_path: Path):
+        ctx = _make_context(tmp_path)
+        get_module("latency").apply(ctx)
+        assert "LATENCY_REPORT_INTERVAL_S" in (ctx.main_dir / "Kconfig.projbuild").read_text()
+
+    def test_overrides_board_hook(self, tmp_path: Path):
+        ctx = _make_context(tmp_path)
+        get_module("latency").apply(ctx)
+        assert "void board_latency_mark(" in (ctx.main_dir / "latency.c").read_text()
+
+
+class TestTouchFilterModule:
+    def test_apply_copies_sources(self, tmp_path: Path):
+        ctx = _make_context(tmp_path)
+        get_module("touch_filter").apply(ctx)
+        assert (ctx.main_dir / "touch_filter.c").exists()
+        assert (ctx.main_dir / "touch_filter.h").exists()
+
+    def test_apply_adds_source_to_cmake_extra(self, tmp_path: Path):
+        ctx = _make_context(tmp_path)
+        get_module("touch_filter").apply(ctx)
+        assert 'list(APPEND EXTRA_SRCS "touch_filter.c")' in ctx.cmake_extra_path.read_text()
+
+
+class TestImuFusionModule:
+    def test_apply_copies_sources(self, tmp_path: Path):
+        ctx = _make_context(tmp_path)
+        get_module("imu_fusion").apply(ctx)
+        assert (ctx.main_dir / "imu_fusion.c").exists()
+        assert (ctx.main_dir / "imu_fusion.h").exists()
+
+    def test_apply_adds_source_to_cmake_extra(self, tmp_path: Path):
+        ctx = _make_context(tmp_path)
+        get_module("imu_fusion").apply(ctx)
+        assert 'list(APPEND EXTRA_SRCS "imu_fusion.c")' in ctx.cmake_extra_path.read_text()
+
+
+class TestResamplerModule:
+    def test_apply_copies_sources(self, tmp_path: Path):
+        ctx = _make_context(tmp_path)
+        get_module("resampler").apply(ctx)
+        assert (ctx.main_dir / "resampler.c").exists()
+        assert (ctx.main_dir / "resampler.h").exists()
+
+    def test_apply_adds_source_to_cmake_extra(self, tmp_path: Path):
+        ctx = _make_context(tmp_path)
+        get_module("resampler").apply(ctx)
+        assert 'list(APPEND EXTRA_SRCS "resampler.c")' in ctx.cmake_extra_path.read_text()
+
+    def test_apply_merges_kconfig(self, tmp_path: Path):
+        ctx = _make_context(tmp_path)
+        get_module("resampler").apply(ctx)
+        assert "RESAMPLER_ESP_DSP" in (ctx.main_dir / "Kconfig.projbuild").read_text()
+
+    def test_apply_adds_esp_dsp_dependency(self, tmp_path: Path):
+        ctx = _make_context(tmp_path)
+        get_module("resampler").apply(ctx)
+        manifest = (ctx.main_dir / "idf_component.yml").read_text()
+        assert "espressif/esp-dsp" in manifest
+
+
 class TestSimModule:
     def test_skipped_when_no_board_info(self, tmp_path: Path, capsys):
         ctx = _make_context(tmp_path, board_info=None)
@@ -202,6 +298,39 @@ class TestSimModule:
         assert "240" in text
         assert "320" in text
 
+    def test_sim_bus_model_created(self, tmp_path: Path):
+        ctx = _make_context(tmp_path, board_info=_lcd_board())
+        with patch("subprocess.run") as mock_run:
+            mock_run.return_value = MagicMock(returncode=0, stderr="")
+            get_module("sim").apply(ctx)
+        assert (ctx.project_dir / "sim" / "sim_bus.c").exists()
+        assert (ctx.project_dir / "sim" / "sim_bus.h").exists()
+
+    def test_bus_placeholders_replaced(self, tmp_path: Path):
+        board = _lcd_board()
+        board.bus = BoardBus(type="qspi", clock_hz=40000000, data_lines=4,
+                             overhead_us=40, max_transfer_bytes=32768)
+        ctx = _make_context(tmp_path, board_info=board)
+        with patch("subprocess.run") as mock_run:
+            mock_run.return_value = MagicMock(returncode=0, stderr="")
+            get_module("sim").apply(ctx)
+        text = (ctx.project_dir / "sim" / "CMakeLists.txt").read_text()
+        assert "__BUS_" not in text
+        assert 'SIM_BUS_TYPE="qspi"' in text
+        assert "SIM_BUS_CLOCK_HZ=40000000" in text
+        assert "SIM_BUS_DATA_LINES=4" in text
+        assert "SIM_BUS_MAX_TRANSFER_BYTES=32768" in text
+
+    def test_bus_placeholders_default_without_bus(self, tmp_path: Path):
+        ctx = _make_context(tmp_path, board_info=_lcd_board())
+        with patch("subprocess.run") as mock_run:
+            mock_run.return_value = MagicMock(returncode=0, stderr="")
+            get_module("sim").apply(ctx)
+        text = (ctx.project_dir / "sim" / "CMakeLists.txt").read_text()
+        assert "__BUS_" not in text
+        assert 'SIM_BUS_TYPE="none"' in text
+        assert "SIM_BUS_CLOCK_HZ=0" in text
+
     def test_project_name_placeholder_replaced_in_cmake(self, tmp_path: Path):
         ctx = _make_context(tmp_path, board_info=_lcd_board())
         with patch("subprocess.run") as mock_run:
@@ -218,6 +347,16 @@ class TestSimModule:
         text = (ctx.project_dir / "sim" / "main_sim.c").read_text()
         assert "__PROJECT_NAME__" not in text
 
+    def test_replay_tool_created(self, tmp_path: Path):
+        ctx = _make_context(tmp_path, board_info=_lcd_board())
+        with patch("subprocess.run") as mock_run:
+            mock_run.return_value = MagicMock(returncode=0, stderr="")
+            get_module("sim").apply(ctx)
+        replay = ctx.project_dir / "sim" / "fbrec_replay.c"
+        assert replay.exists()
+        assert "__PROJECT_NAME__" not in replay.read_text()
+        assert "fbrec.c" in (ctx.project_dir / "sim" / "CMakeLists.txt").read_text()
+
     def test_graceful_when_submodule_add_fails(self, tmp_path: Path, capsys):
         ctx = _make_context(tmp_path, board_info=_lcd_board())
         with patch("subprocess.run") as mock_run:
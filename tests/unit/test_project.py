@@ -67,6 +67,7 @@ class TestCreateProject:
         project = create_project("myapp", TEMPLATES_DIR, destination=tmp_path / "myapp")
         assert (project.root / "main" / "main.c").exists()
         assert (project.root / "main" / "board_interface.h").exists()
+        assert (project.root / "main" / "board_touch_ring.h").exists()
         assert (project.root / "main" / "idf_component.yml").exists()
         assert (project.root / "main" / "CMakeLists.txt").exists()
 